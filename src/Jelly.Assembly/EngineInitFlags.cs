@@ -0,0 +1,21 @@
+namespace Jelly.Assembly;
+
+/// <summary>
+/// Options passed to <see cref="JellyNative.Initialize"/>. Values match the native
+/// <c>JELLY_INIT_*</c> constants.
+/// </summary>
+[Flags]
+public enum EngineInitFlags : uint
+{
+    /// <summary>Open a window and render to its swapchain.</summary>
+    None = 0,
+
+    /// <summary>Render into offscreen images without a window; needs no display.</summary>
+    Headless = 1u << 0,
+
+    /// <summary>Keep one frame in flight for the lowest input latency.</summary>
+    LowLatency = 1u << 1,
+
+    /// <summary>Keep three frames in flight so CPU spikes are absorbed, at the cost of latency.</summary>
+    HighThroughput = 1u << 2
+}
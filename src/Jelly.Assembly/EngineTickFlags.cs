@@ -0,0 +1,21 @@
+namespace Jelly.Assembly;
+
+/// <summary>
+/// Status bits returned by <see cref="JellyNative.Tick"/>. Values match the native
+/// <c>JELLY_TICK_*</c> constants.
+/// </summary>
+[Flags]
+public enum EngineTickFlags : uint
+{
+    /// <summary>The engine has stopped; the loop should exit.</summary>
+    None = 0,
+
+    /// <summary>The engine is still running.</summary>
+    Running = 1u << 0,
+
+    /// <summary>
+    /// A frame was rendered (or queued to the render thread) during the tick; clear while the
+    /// window is minimized or when the frame was dropped.
+    /// </summary>
+    Rendered = 1u << 1
+}
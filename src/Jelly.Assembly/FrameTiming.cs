@@ -0,0 +1,31 @@
+using System.Runtime.InteropServices;
+
+namespace Jelly.Assembly;
+
+/// <summary>
+/// Timing of one engine frame, laid out exactly like the native <c>FrameTiming</c>.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct FrameTiming
+{
+    /// <summary>Wall time since the previous frame, in seconds (clamped).</summary>
+    public readonly double DeltaSeconds;
+
+    /// <summary>Length of one simulation step, in seconds.</summary>
+    public readonly double FixedStepSeconds;
+
+    /// <summary>Fraction of a step left over, for interpolating rendered state.</summary>
+    public readonly double Alpha;
+
+    /// <summary>Simulated time after this frame's steps, in seconds.</summary>
+    public readonly double TotalSeconds;
+
+    /// <summary>Number of frames begun before this one.</summary>
+    public readonly ulong FrameIndex;
+
+    /// <summary>Simulation steps to run this frame.</summary>
+    public readonly uint FixedSteps;
+
+    /// <summary>Steps skipped because the frame hit the per-frame step cap.</summary>
+    public readonly uint DroppedSteps;
+}
@@ -0,0 +1,49 @@
+using System.Runtime.InteropServices;
+
+namespace Jelly.Assembly;
+
+/// <summary>
+/// Kind of an <see cref="InputEvent"/>. Values match the native <c>InputEventType</c>.
+/// </summary>
+public enum InputEventType : uint
+{
+    /// <summary><see cref="InputEvent.Code"/> is the GLFW key, <see cref="InputEvent.X"/> the scancode.</summary>
+    Key = 1,
+
+    /// <summary><see cref="InputEvent.Code"/> is a Unicode code point.</summary>
+    Char = 2,
+
+    /// <summary><see cref="InputEvent.Code"/> is the GLFW mouse button.</summary>
+    MouseButton = 3,
+
+    /// <summary><see cref="InputEvent.X"/> and <see cref="InputEvent.Y"/> are the cursor position.</summary>
+    MouseMove = 4,
+
+    /// <summary><see cref="InputEvent.X"/> and <see cref="InputEvent.Y"/> are the scroll offsets.</summary>
+    Scroll = 5,
+
+    /// <summary><see cref="InputEvent.X"/> and <see cref="InputEvent.Y"/> are the new framebuffer size.</summary>
+    Resize = 6
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+/// <summary>
+/// Fixed-size (24 byte) input record, laid out exactly like the native <c>InputEvent</c>.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct InputEvent
+{
+    public readonly InputEventType Type;
+
+    /// <summary>Key, button or code point; 0 when unused.</summary>
+    public readonly int Code;
+
+    /// <summary>GLFW action (0 = release, 1 = press, 2 = repeat); 0 when unused.</summary>
+    public readonly int Action;
+
+    /// <summary>GLFW modifier bits; 0 when unused.</summary>
+    public readonly int Mods;
+
+    public readonly float X;
+    public readonly float Y;
+}
@@ -1,38 +1,91 @@
+using System.Buffers;
 using System.Runtime.InteropServices;
+using System.Text;
 
 namespace Jelly.Assembly;
 
 /// <summary>
 /// Thin C# wrapper around the native <c>Jelly.dll</c> API.  
-/// Loads function pointers once and exposes idiomatic helpers.
+/// Resolves unmanaged function pointers once and exposes idiomatic helpers.
+/// Every native signature is blittable (integers, pointers and UTF-8 byte strings),
+/// so calls need no marshalling stubs and allocate nothing.
 /// </summary>
-public static partial class JellyNative
+public static unsafe partial class JellyNative
 {
     /// <summary>Pointer to the loaded native library.</summary>
     private static readonly IntPtr Library;
 
+    /// <summary>Strings up to this many UTF-8 bytes are encoded on the stack.</summary>
+    private const int StackUtf8Limit = 512;
+
     static JellyNative()
     {
         Library = NativeLibrary.Load("Jelly.dll");
         
-        LoggerLog          = GetDelegate<LoggerLogDelegate>("jellyLogMessage");
+        LoggerLog          = (delegate* unmanaged[Cdecl]<int, byte*, void>)GetExport("jellyLogMessage");
+        LoggerSetLevelMask = (delegate* unmanaged[Cdecl]<int, uint, void>)GetExport("jellyLogSetLevelMask");
+        LogLevelMasks      = ((delegate* unmanaged[Cdecl]<IntPtr>)GetExport("jellyLogGetLevelMasks"))();
+        
+        ProfilerSetEnabled = (delegate* unmanaged[Cdecl]<byte, void>)GetExport("jellyProfilerSetEnabled");
+        ProfilerDump       = (delegate* unmanaged[Cdecl]<byte*, uint, byte>)GetExport("jellyProfilerDump");
         
-        EngineInitialize   = GetDelegate<EngineCreateDelegate>("jellyEngineInitialize");
-        EngineIsRunning    = GetDelegate<EngineIsRunningDelegate>("jellyEngineIsRunning");
-        EnginePoll         = GetDelegate<EnginePollDelegate>("jellyEnginePoll");
-        EngineRender       = GetDelegate<EngineRenderDelegate>("jellyEngineRender");
-        EngineShutdown     = GetDelegate<EngineShutdownDelegate>("jellyEngineShutdown");
+        EngineInitialize   = (delegate* unmanaged[Cdecl]<int, int, byte, byte*, byte*, uint, ulong>)GetExport("jellyEngineInitialize");
+        EngineIsRunning    = (delegate* unmanaged[Cdecl]<ulong, byte>)GetExport("jellyEngineIsRunning");
+        EnginePoll         = (delegate* unmanaged[Cdecl]<ulong, uint*, InputEvent*>)GetExport("jellyEnginePoll");
+        EngineRender       = (delegate* unmanaged[Cdecl]<ulong, void>)GetExport("jellyEngineRender");
+        EngineSetRenderThread = (delegate* unmanaged[Cdecl]<ulong, byte, uint, void>)GetExport("jellyEngineSetRenderThread");
+        EngineTick         = (delegate* unmanaged[Cdecl]<ulong, InputEvent**, uint*, uint>)GetExport("jellyEngineTick");
+        EngineGetRenderCommandRing = (delegate* unmanaged[Cdecl]<ulong, RenderCommandRingView*, byte>)GetExport("jellyEngineGetRenderCommandRing");
+        EngineSetFrameTiming = (delegate* unmanaged[Cdecl]<ulong, double, double, void>)GetExport("jellyEngineSetFrameTiming");
+        EngineGetFrameTiming = (delegate* unmanaged[Cdecl]<ulong, FrameTiming*>)GetExport("jellyEngineGetFrameTiming");
+        EngineSetPresentMode = (delegate* unmanaged[Cdecl]<ulong, uint, byte, void>)GetExport("jellyEngineSetPresentMode");
+        EngineGetPresentStats = (delegate* unmanaged[Cdecl]<ulong, PresentStats*, byte>)GetExport("jellyEngineGetPresentStats");
+        EngineResize       = (delegate* unmanaged[Cdecl]<ulong, uint, uint, byte>)GetExport("jellyEngineResize");
+        EngineShutdown     = (delegate* unmanaged[Cdecl]<ulong, void>)GetExport("jellyEngineShutdown");
     }
 
     // ──────────────────────────────────────────────────────────────────────────
     /// <summary>
-    /// Retrieves a typed delegate for a native symbol.
+    /// Retrieves the address of a native symbol.
     /// </summary>
-    /// <typeparam name="T">Delegate type matching the native function signature.</typeparam>
     /// <param name="name">Symbol name exported by the DLL.</param>
-    private static T GetDelegate<T>(string name) where T : Delegate
+    private static IntPtr GetExport(string name)
+        => NativeLibrary.GetExport(Library, name);
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Encodes <paramref name="text"/> as null-terminated UTF-8 into <paramref name="scratch"/>,
+    /// or into a pooled array when it does not fit.
+    /// </summary>
+    /// <param name="text">The string to encode.</param>
+    /// <param name="scratch">Caller-provided buffer, usually stack allocated.</param>
+    /// <param name="rented">Pooled array to return with <see cref="ReturnUtf8"/>, or <c>null</c>.</param>
+    /// <returns>The encoded bytes, including the terminator.</returns>
+    private static Span<byte> EncodeUtf8(string text, Span<byte> scratch, out byte[]? rented)
+    {
+        rented = null;
+        var maxBytes = Encoding.UTF8.GetMaxByteCount(text.Length) + 1;
+        var buffer = scratch;
+        if (maxBytes > scratch.Length)
+        {
+            rented = ArrayPool<byte>.Shared.Rent(maxBytes);
+            buffer = rented;
+        }
+
+        var length = Encoding.UTF8.GetBytes(text, buffer);
+        buffer[length] = 0;
+        return buffer[..(length + 1)];
+    }
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Returns an array rented by <see cref="EncodeUtf8"/> to the pool.
+    /// </summary>
+    private static void ReturnUtf8(byte[]? rented)
     {
-        var symbol = NativeLibrary.GetExport(Library, name);
-        return Marshal.GetDelegateForFunctionPointer<T>(symbol);
+        if (rented != null)
+        {
+            ArrayPool<byte>.Shared.Return(rented);
+        }
     }
-}
\ No newline at end of file
+}
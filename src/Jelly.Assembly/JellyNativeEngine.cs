@@ -1,44 +1,172 @@
 namespace Jelly.Assembly;
 
-public partial class JellyNative
+public static unsafe partial class JellyNative
 {
-    private static readonly EngineCreateDelegate EngineInitialize;
+    private static readonly delegate* unmanaged[Cdecl]<int, int, byte, byte*, byte*, uint, ulong> EngineInitialize;
     /// <summary>
     /// Initialize a new engine instance.
     /// </summary>
-    public static IntPtr Initialize(int width, int height, bool vsync, string title, string apiName)
-        => EngineInitialize(width, height, vsync, title, apiName);
+    /// <param name="flags">Startup options, e.g. <see cref="EngineInitFlags.Headless"/>.</param>
+    public static ulong Initialize(int width, int height, bool vsync, string title, string apiName,
+        EngineInitFlags flags = EngineInitFlags.None)
+    {
+        Span<byte> titleScratch = stackalloc byte[StackUtf8Limit];
+        Span<byte> apiScratch = stackalloc byte[64];
+        var titleUtf8 = EncodeUtf8(title, titleScratch, out var titleRented);
+        var apiUtf8 = EncodeUtf8(apiName, apiScratch, out var apiRented);
+        try
+        {
+            fixed (byte* titlePtr = titleUtf8)
+            fixed (byte* apiPtr = apiUtf8)
+            {
+                return EngineInitialize(width, height, vsync ? (byte)1 : (byte)0, titlePtr, apiPtr, (uint)flags);
+            }
+        }
+        finally
+        {
+            ReturnUtf8(titleRented);
+            ReturnUtf8(apiRented);
+        }
+    }
     
     // ──────────────────────────────────────────────────────────────────────────
-    private static readonly EngineIsRunningDelegate EngineIsRunning;
+    private static readonly delegate* unmanaged[Cdecl]<ulong, byte> EngineIsRunning;
     /// <summary>
     /// Returns <c>true</c> while the engine’s main loop should continue running.
     /// </summary>
-    public static bool IsRunning(IntPtr handle)
-        => EngineIsRunning(handle);
+    public static bool IsRunning(ulong handle)
+        => EngineIsRunning(handle) != 0;
     
     // ──────────────────────────────────────────────────────────────────────────
-    private static readonly EnginePollDelegate EnginePoll;
+    private static readonly delegate* unmanaged[Cdecl]<ulong, uint*, InputEvent*> EnginePoll;
     /// <summary>
-    /// Polls events and advances one frame of the native engine.
+    /// Polls window and input events of the native engine.
     /// </summary>
-    public static void Poll(IntPtr handle)
-        => EnginePoll(handle);
+    /// <returns>The events received, read in place from native memory; valid until the next poll or tick.</returns>
+    public static ReadOnlySpan<InputEvent> Poll(ulong handle)
+    {
+        uint count;
+        var events = EnginePoll(handle, &count);
+        return new ReadOnlySpan<InputEvent>(events, (int)count);
+    }
     
     // ──────────────────────────────────────────────────────────────────────────
-    private static readonly EngineRenderDelegate EngineRender;
+    private static readonly delegate* unmanaged[Cdecl]<ulong, void> EngineRender;
     /// <summary>
-    /// Polls events and advances one frame of the native engine.
+    /// Renders a single frame of the native engine.
     /// </summary>
-    public static void Render(IntPtr handle)
+    public static void Render(ulong handle)
         => EngineRender(handle);
     
     // ──────────────────────────────────────────────────────────────────────────
-    private static readonly EngineShutdownDelegate EngineShutdown;
+    private static readonly delegate* unmanaged[Cdecl]<ulong, byte, uint, void> EngineSetRenderThread;
+    /// <summary>
+    /// Starts or stops the native render thread. While it runs, rendering a frame only queues it,
+    /// so the next frame is built while the previous one is recorded and submitted.
+    /// </summary>
+    /// <param name="handle">The native engine handle previously returned by <see cref="Initialize"/>.</param>
+    /// <param name="enabled"><c>true</c> to render on a dedicated thread.</param>
+    /// <param name="queueDepth">Frames the game thread may run ahead, including the one being drawn.</param>
+    public static void SetRenderThread(ulong handle, bool enabled, uint queueDepth)
+        => EngineSetRenderThread(handle, enabled ? (byte)1 : (byte)0, queueDepth);
+    
+    // ──────────────────────────────────────────────────────────────────────────
+    private static readonly delegate* unmanaged[Cdecl]<ulong, InputEvent**, uint*, uint> EngineTick;
+    /// <summary>
+    /// Polls events and renders one frame in a single native transition.
+    /// </summary>
+    /// <param name="handle">The native engine handle previously returned by <see cref="Initialize"/>.</param>
+    /// <param name="events">The polled input events, read in place; valid until the next poll or tick.</param>
+    /// <returns>Status bits; the loop should stop once <see cref="EngineTickFlags.Running"/> is clear.</returns>
+    public static EngineTickFlags Tick(ulong handle, out ReadOnlySpan<InputEvent> events)
+    {
+        InputEvent* data;
+        uint count;
+        var flags = (EngineTickFlags)EngineTick(handle, &data, &count);
+        events = new ReadOnlySpan<InputEvent>(data, (int)count);
+        return flags;
+    }
+    
+    // ──────────────────────────────────────────────────────────────────────────
+    private static readonly delegate* unmanaged[Cdecl]<ulong, RenderCommandRingView*, byte> EngineGetRenderCommandRing;
+    /// <summary>
+    /// Opens the engine's render command ring for writing from managed code.
+    /// </summary>
+    /// <param name="handle">The native engine handle previously returned by <see cref="Initialize"/>.</param>
+    /// <returns>A writer valid until <see cref="Shutdown"/> is called.</returns>
+    public static RenderCommandRing GetRenderCommandRing(ulong handle)
+    {
+        RenderCommandRingView view;
+        if (EngineGetRenderCommandRing(handle, &view) == 0)
+        {
+            throw new InvalidOperationException("The engine has no render command ring.");
+        }
+        return new RenderCommandRing(view);
+    }
+    
+    // ──────────────────────────────────────────────────────────────────────────
+    private static readonly delegate* unmanaged[Cdecl]<ulong, double, double, void> EngineSetFrameTiming;
+    /// <summary>
+    /// Sets the fixed simulation step and the frame rate ticks are paced to.
+    /// </summary>
+    /// <param name="handle">The native engine handle previously returned by <see cref="Initialize"/>.</param>
+    /// <param name="fixedStepSeconds">Simulation step in seconds; 0 or less keeps the current step.</param>
+    /// <param name="targetFps">Paced frame rate; 0 or less disables the limiter.</param>
+    public static void SetFrameTiming(ulong handle, double fixedStepSeconds, double targetFps)
+        => EngineSetFrameTiming(handle, fixedStepSeconds, targetFps);
+    
+    // ──────────────────────────────────────────────────────────────────────────
+    private static readonly delegate* unmanaged[Cdecl]<ulong, FrameTiming*> EngineGetFrameTiming;
+    /// <summary>
+    /// Returns the address of the engine's frame timing block. It is rewritten by every tick
+    /// and stays valid until <see cref="Shutdown"/>, so it can be read without further calls.
+    /// </summary>
+    /// <param name="handle">The native engine handle previously returned by <see cref="Initialize"/>.</param>
+    public static FrameTiming* GetFrameTiming(ulong handle)
+        => EngineGetFrameTiming(handle);
+    
+    // ──────────────────────────────────────────────────────────────────────────
+    private static readonly delegate* unmanaged[Cdecl]<ulong, uint, byte, void> EngineSetPresentMode;
+    /// <summary>
+    /// Selects the present mode; the swapchain is rebuilt at the start of the next frame.
+    /// Modes the surface lacks fall back to the nearest supported one.
+    /// </summary>
+    /// <param name="handle">The native engine handle previously returned by <see cref="Initialize"/>.</param>
+    /// <param name="mode">The preferred present mode.</param>
+    /// <param name="lowLatency">Keeps fewer swapchain images and paces frames on present-wait where available.</param>
+    public static void SetPresentMode(ulong handle, PresentMode mode, bool lowLatency)
+        => EngineSetPresentMode(handle, (uint)mode, lowLatency ? (byte)1 : (byte)0);
+    
+    // ──────────────────────────────────────────────────────────────────────────
+    private static readonly delegate* unmanaged[Cdecl]<ulong, PresentStats*, byte> EngineGetPresentStats;
+    /// <summary>
+    /// Returns the measured present-to-present intervals.
+    /// </summary>
+    /// <param name="handle">The native engine handle previously returned by <see cref="Initialize"/>.</param>
+    public static PresentStats GetPresentStats(ulong handle)
+    {
+        PresentStats stats;
+        return EngineGetPresentStats(handle, &stats) != 0 ? stats : default;
+    }
+    
+    // ──────────────────────────────────────────────────────────────────────────
+    private static readonly delegate* unmanaged[Cdecl]<ulong, uint, uint, byte> EngineResize;
+    /// <summary>
+    /// Resizes the offscreen target of a headless engine; the next frame rebuilds it.
+    /// </summary>
+    /// <param name="handle">The native engine handle previously returned by <see cref="Initialize"/>.</param>
+    /// <param name="width">New target width in pixels.</param>
+    /// <param name="height">New target height in pixels.</param>
+    /// <returns><c>false</c> if the engine renders to a window, which it follows instead.</returns>
+    public static bool Resize(ulong handle, uint width, uint height)
+        => EngineResize(handle, width, height) != 0;
+    
+    // ──────────────────────────────────────────────────────────────────────────
+    private static readonly delegate* unmanaged[Cdecl]<ulong, void> EngineShutdown;
     /// <summary>
     /// Shuts down the engine and releases all associated native resources.
     /// </summary>
     /// <param name="handle">The native engine handle previously returned by <see cref="Initialize"/>.</param>
-    public static void Shutdown(IntPtr handle)
+    public static void Shutdown(ulong handle)
         => EngineShutdown(handle);
-}
\ No newline at end of file
+}
@@ -1,11 +1,21 @@
 namespace Jelly.Assembly;
 
-public static partial class JellyNative
+public static unsafe partial class JellyNative
 {
     /// <summary>
-    /// Delegate bound to the native log function.
+    /// Native log function, taking a null-terminated UTF-8 message.
     /// </summary>
-    private static readonly LoggerLogDelegate LoggerLog;
+    private static readonly delegate* unmanaged[Cdecl]<int, byte*, void> LoggerLog;
+
+    /// <summary>
+    /// Native level mask setter.
+    /// </summary>
+    private static readonly delegate* unmanaged[Cdecl]<int, uint, void> LoggerSetLevelMask;
+
+    /// <summary>
+    /// Native array of level masks, indexed by log category. Valid for the lifetime of the process.
+    /// </summary>
+    private static readonly IntPtr LogLevelMasks;
 
     /// <summary>
     /// Sends a log message to the native engine with the specified log level.
@@ -13,5 +23,43 @@ public static partial class JellyNative
     /// <param name="logLevel">Log level as an integer (see <see cref="Jelly.Engine.LogLevel"/>).</param>
     /// <param name="message">The log message.</param>
     public static void Log(int logLevel, string message)
-        => LoggerLog(logLevel, message);
-}
\ No newline at end of file
+    {
+        Span<byte> scratch = stackalloc byte[StackUtf8Limit];
+        var utf8 = EncodeUtf8(message, scratch, out var rented);
+        fixed (byte* ptr = utf8)
+        {
+            LoggerLog(logLevel, ptr);
+        }
+        ReturnUtf8(rented);
+    }
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Returns <c>true</c> if the native logger currently emits <paramref name="logLevel"/> for
+    /// <paramref name="logCategory"/>. Reads the shared mask directly, without a native call.
+    /// </summary>
+    /// <param name="logCategory">Log category as an integer (see <see cref="Jelly.Engine.LogCategory"/>).</param>
+    /// <param name="logLevel">Log level as an integer (see <see cref="Jelly.Engine.LogLevel"/>).</param>
+    public static bool IsLogEnabled(int logCategory, int logLevel)
+    {
+        var mask = Volatile.Read(ref ((uint*)LogLevelMasks)[logCategory]);
+        return (mask & (1u << logLevel)) != 0;
+    }
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Replaces the level mask of a native log category.
+    /// </summary>
+    /// <param name="logCategory">Log category as an integer (see <see cref="Jelly.Engine.LogCategory"/>).</param>
+    /// <param name="mask">Bit N enables log level N.</param>
+    public static void SetLogLevelMask(int logCategory, uint mask)
+        => LoggerSetLevelMask(logCategory, mask);
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Returns the level mask of a native log category.
+    /// </summary>
+    /// <param name="logCategory">Log category as an integer (see <see cref="Jelly.Engine.LogCategory"/>).</param>
+    public static uint GetLogLevelMask(int logCategory)
+        => Volatile.Read(ref ((uint*)LogLevelMasks)[logCategory]);
+}
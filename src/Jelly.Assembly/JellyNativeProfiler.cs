@@ -0,0 +1,36 @@
+namespace Jelly.Assembly;
+
+public static unsafe partial class JellyNative
+{
+    private static readonly delegate* unmanaged[Cdecl]<byte, void> ProfilerSetEnabled;
+    /// <summary>
+    /// Starts or stops recording native profiler zones.
+    /// </summary>
+    public static void SetProfilerEnabled(bool enabled)
+        => ProfilerSetEnabled(enabled ? (byte)1 : (byte)0);
+
+    // ──────────────────────────────────────────────────────────────────────────
+    private static readonly delegate* unmanaged[Cdecl]<byte*, uint, byte> ProfilerDump;
+    /// <summary>
+    /// Writes the last <paramref name="frames"/> frames of native profiler zones as Chrome Trace Event JSON.
+    /// </summary>
+    /// <param name="path">File to create or overwrite.</param>
+    /// <param name="frames">Number of most recent frames to export.</param>
+    /// <returns><c>false</c> if the profiler is compiled out or the file could not be written.</returns>
+    public static bool DumpProfile(string path, uint frames)
+    {
+        Span<byte> scratch = stackalloc byte[StackUtf8Limit];
+        var utf8 = EncodeUtf8(path, scratch, out var rented);
+        try
+        {
+            fixed (byte* ptr = utf8)
+            {
+                return ProfilerDump(ptr, frames) != 0;
+            }
+        }
+        finally
+        {
+            ReturnUtf8(rented);
+        }
+    }
+}
@@ -0,0 +1,19 @@
+namespace Jelly.Assembly;
+
+/// <summary>
+/// How finished frames reach the screen. Values match the native <c>JELLY_PRESENT_*</c> constants.
+/// </summary>
+public enum PresentMode : uint
+{
+    /// <summary>Vsync: frames wait for the vertical blank and never tear.</summary>
+    Fifo = 0,
+
+    /// <summary>Vsync, but a frame that missed the blank is shown at once and may tear.</summary>
+    FifoRelaxed = 1,
+
+    /// <summary>No tearing; a new frame replaces the one waiting for the blank.</summary>
+    Mailbox = 2,
+
+    /// <summary>No vsync: lowest latency, may tear.</summary>
+    Immediate = 3
+}
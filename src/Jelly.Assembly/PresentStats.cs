@@ -0,0 +1,27 @@
+using System.Runtime.InteropServices;
+
+namespace Jelly.Assembly;
+
+/// <summary>
+/// Measured presentation pacing, laid out exactly like the native <c>PresentStats</c>.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct PresentStats
+{
+    /// <summary>Time between the last two presents, in seconds.</summary>
+    public readonly double LastIntervalSeconds;
+
+    /// <summary>Moving average of the present interval, in seconds.</summary>
+    public readonly double AverageIntervalSeconds;
+
+    /// <summary>Presents measured so far.</summary>
+    public readonly ulong PresentCount;
+
+    /// <summary>Present mode in use, after falling back to what the surface supports.</summary>
+    public readonly PresentMode Mode;
+
+    /// <summary>Whether intervals are measured when frames reached the display rather than when they were queued.</summary>
+    public bool OnDisplay => _onDisplay != 0;
+
+    private readonly uint _onDisplay;
+}
@@ -0,0 +1,83 @@
+using System.Runtime.InteropServices;
+
+namespace Jelly.Assembly;
+
+/// <summary>
+/// Kind of a <see cref="RenderCommand"/>. Values match the native <c>RenderCommandType</c>.
+/// </summary>
+public enum RenderCommandType : uint
+{
+    /// <summary>Empty slot; ignored by the engine.</summary>
+    None = 0,
+
+    /// <summary>Sets the color the frame is cleared to.</summary>
+    ClearColor = 1,
+
+    /// <summary>Sets the 2D transform applied to the following sprites.</summary>
+    SetTransform = 2,
+
+    /// <summary>Draws a sprite through the current transform.</summary>
+    DrawSprite = 3
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+/// <summary>
+/// Payload of <see cref="RenderCommandType.ClearColor"/>.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct ClearColorCommand
+{
+    public float R, G, B, A;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+/// <summary>
+/// Payload of <see cref="RenderCommandType.SetTransform"/>: an affine matrix
+/// (M11, M12, M21, M22, M31, M32) mapping sprite corners to pixels.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct SetTransformCommand
+{
+    public float M11, M12, M21, M22, M31, M32;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+/// <summary>
+/// Payload of <see cref="RenderCommandType.DrawSprite"/>.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct DrawSpriteCommand
+{
+    public float X, Y, Width, Height;
+    public float R, G, B, A;
+
+    /// <summary>Texture id; 0 draws a solid quad.</summary>
+    public uint Texture;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+/// <summary>
+/// Fixed-size (64 byte) command, laid out exactly like the native <c>RenderCommand</c>.
+/// </summary>
+[StructLayout(LayoutKind.Explicit, Size = 64)]
+public struct RenderCommand
+{
+    [FieldOffset(0)] public RenderCommandType Type;
+    [FieldOffset(8)] public ClearColorCommand ClearColor;
+    [FieldOffset(8)] public SetTransformCommand SetTransform;
+    [FieldOffset(8)] public DrawSpriteCommand DrawSprite;
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+/// <summary>
+/// Mirror of the native <c>RenderCommandRingView</c>: addresses of the engine-owned ring.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+internal unsafe struct RenderCommandRingView
+{
+    public RenderCommand* Commands;
+    public uint Capacity;
+    public uint Reserved;
+    public uint* WriteIndex;
+    public uint* ReadIndex;
+}
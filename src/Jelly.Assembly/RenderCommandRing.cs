@@ -0,0 +1,76 @@
+namespace Jelly.Assembly;
+
+/// <summary>
+/// Producer end of an engine's render command ring. Commands are written straight into
+/// native memory and become visible to the engine when <see cref="Commit"/> is called,
+/// so a whole frame costs no interop beyond the tick that consumes it.
+/// Must only be used from one thread at a time.
+/// </summary>
+public sealed unsafe class RenderCommandRing
+{
+    private readonly RenderCommand* _commands;
+    private readonly uint _mask;
+    private readonly uint* _writeIndex;
+    private readonly uint* _readIndex;
+
+    /// <summary>Index of the next slot to write; published on <see cref="Commit"/>.</summary>
+    private uint _pending;
+
+    internal RenderCommandRing(in RenderCommandRingView view)
+    {
+        _commands = view.Commands;
+        _mask = view.Capacity - 1;
+        _writeIndex = view.WriteIndex;
+        _readIndex = view.ReadIndex;
+        _pending = Volatile.Read(ref *_writeIndex);
+        Capacity = (int)view.Capacity;
+    }
+
+    /// <summary>Total number of command slots.</summary>
+    public int Capacity { get; }
+
+    /// <summary>Number of slots that can be written before the engine consumes more.</summary>
+    public int Free => Capacity - (int)(_pending - Volatile.Read(ref *_readIndex));
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Returns a contiguous span of up to <paramref name="count"/> writable slots.
+    /// The span can be shorter when the ring is nearly full or wraps around.
+    /// Call <see cref="Advance"/> with the number of slots actually written.
+    /// </summary>
+    public Span<RenderCommand> GetSpan(int count)
+    {
+        var start = _pending & _mask;
+        var contiguous = (int)Math.Min((uint)Capacity - start, (uint)Free);
+        return new Span<RenderCommand>(_commands + start, Math.Min(count, contiguous));
+    }
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Marks <paramref name="count"/> slots returned by <see cref="GetSpan"/> as written.
+    /// </summary>
+    public void Advance(int count) => _pending += (uint)count;
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Appends one command.
+    /// </summary>
+    /// <returns><c>false</c> if the ring is full.</returns>
+    public bool TryWrite(in RenderCommand command)
+    {
+        if (Free == 0)
+        {
+            return false;
+        }
+
+        _commands[_pending & _mask] = command;
+        _pending++;
+        return true;
+    }
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Publishes every command written so far to the engine.
+    /// </summary>
+    public void Commit() => Volatile.Write(ref *_writeIndex, _pending);
+}
@@ -0,0 +1,344 @@
+// -----------------------------------------------------------------------------
+// jelly_record_bench: measures secondary command buffer recording time against the
+// number of recording threads. Runs headless on the first Vulkan device with a
+// graphics queue (a software driver such as lavapipe works).
+//
+// Usage: jelly_record_bench [maxThreads] [rects]
+// -----------------------------------------------------------------------------
+
+#include "Graphics/GraphicsApiException.h"
+#include "Graphics/Vulkan/VulkanCommandRecorder.h"
+#include "Jobs/JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::uint32_t TargetSize    = 1024;
+    constexpr std::uint32_t RectsPerSlice = 256;
+    constexpr int           Repetitions   = 20;
+
+    /// Minimal offscreen target: one color image inside a single-subpass render pass.
+    struct Context {
+        VkInstance       instance       = VK_NULL_HANDLE;
+        VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+        VkDevice         device         = VK_NULL_HANDLE;
+        VkQueue          queue          = VK_NULL_HANDLE;
+        std::uint32_t    queueFamily    = 0;
+        VkImage          image          = VK_NULL_HANDLE;
+        VkDeviceMemory   memory         = VK_NULL_HANDLE;
+        VkImageView      view           = VK_NULL_HANDLE;
+        VkRenderPass     renderPass     = VK_NULL_HANDLE;
+        VkFramebuffer    framebuffer    = VK_NULL_HANDLE;
+        VkCommandPool    pool           = VK_NULL_HANDLE;
+        VkCommandBuffer  primary        = VK_NULL_HANDLE;
+        VkFence          fence          = VK_NULL_HANDLE;
+    };
+
+    // -----------------------------------------------------------------------------
+    // Throws if a Vulkan call failed.
+    // -----------------------------------------------------------------------------
+    void Check(VkResult result, const char* what) {
+        if (result != VK_SUCCESS) {
+            throw GraphicsApiException(what);
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // Creates the instance, device and offscreen render target.
+    // -----------------------------------------------------------------------------
+    void CreateContext(Context& ctx) {
+        VkApplicationInfo appInfo{VK_STRUCTURE_TYPE_APPLICATION_INFO};
+        appInfo.pApplicationName = "jelly_record_bench";
+        appInfo.apiVersion = VK_API_VERSION_1_0;
+
+        VkInstanceCreateInfo instanceInfo{VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO};
+        instanceInfo.pApplicationInfo = &appInfo;
+        Check(vkCreateInstance(&instanceInfo, nullptr, &ctx.instance), "Failed to create Vulkan instance!");
+
+        std::uint32_t deviceCount = 0;
+        vkEnumeratePhysicalDevices(ctx.instance, &deviceCount, nullptr);
+        std::vector<VkPhysicalDevice> devices(deviceCount);
+        vkEnumeratePhysicalDevices(ctx.instance, &deviceCount, devices.data());
+
+        for (VkPhysicalDevice candidate : devices) {
+            std::uint32_t familyCount = 0;
+            vkGetPhysicalDeviceQueueFamilyProperties(candidate, &familyCount, nullptr);
+            std::vector<VkQueueFamilyProperties> families(familyCount);
+            vkGetPhysicalDeviceQueueFamilyProperties(candidate, &familyCount, families.data());
+
+            for (std::uint32_t i = 0; i < familyCount; ++i) {
+                if (families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+                    ctx.physicalDevice = candidate;
+                    ctx.queueFamily = i;
+                    break;
+                }
+            }
+            if (ctx.physicalDevice != VK_NULL_HANDLE) {
+                break;
+            }
+        }
+        if (ctx.physicalDevice == VK_NULL_HANDLE) {
+            throw GraphicsApiException("No Vulkan device with a graphics queue!");
+        }
+
+        VkPhysicalDeviceProperties properties{};
+        vkGetPhysicalDeviceProperties(ctx.physicalDevice, &properties);
+        std::printf("Device: %s\n", properties.deviceName);
+
+        const float priority = 1.0f;
+        VkDeviceQueueCreateInfo queueInfo{VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
+        queueInfo.queueFamilyIndex = ctx.queueFamily;
+        queueInfo.queueCount = 1;
+        queueInfo.pQueuePriorities = &priority;
+
+        VkDeviceCreateInfo deviceInfo{VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO};
+        deviceInfo.queueCreateInfoCount = 1;
+        deviceInfo.pQueueCreateInfos = &queueInfo;
+        Check(vkCreateDevice(ctx.physicalDevice, &deviceInfo, nullptr, &ctx.device), "Failed to create logical device!");
+        vkGetDeviceQueue(ctx.device, ctx.queueFamily, 0, &ctx.queue);
+
+        VkImageCreateInfo imageInfo{VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+        imageInfo.extent = {TargetSize, TargetSize, 1};
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        Check(vkCreateImage(ctx.device, &imageInfo, nullptr, &ctx.image), "Failed to create target image!");
+
+        VkMemoryRequirements requirements{};
+        vkGetImageMemoryRequirements(ctx.device, ctx.image, &requirements);
+        VkPhysicalDeviceMemoryProperties memoryProperties{};
+        vkGetPhysicalDeviceMemoryProperties(ctx.physicalDevice, &memoryProperties);
+
+        std::uint32_t memoryType = UINT32_MAX;
+        for (std::uint32_t i = 0; i < memoryProperties.memoryTypeCount && memoryType == UINT32_MAX; ++i) {
+            if ((requirements.memoryTypeBits & (1u << i)) &&
+                (memoryProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)) {
+                memoryType = i;
+            }
+        }
+        for (std::uint32_t i = 0; i < memoryProperties.memoryTypeCount && memoryType == UINT32_MAX; ++i) {
+            if (requirements.memoryTypeBits & (1u << i)) {
+                memoryType = i;
+            }
+        }
+
+        VkMemoryAllocateInfo allocInfo{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+        allocInfo.allocationSize = requirements.size;
+        allocInfo.memoryTypeIndex = memoryType;
+        Check(vkAllocateMemory(ctx.device, &allocInfo, nullptr, &ctx.memory), "Failed to allocate target memory!");
+        Check(vkBindImageMemory(ctx.device, ctx.image, ctx.memory, 0), "Failed to bind target memory!");
+
+        VkImageViewCreateInfo viewInfo{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
+        viewInfo.image = ctx.image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = imageInfo.format;
+        viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        Check(vkCreateImageView(ctx.device, &viewInfo, nullptr, &ctx.view), "Failed to create target view!");
+
+        VkAttachmentDescription attachment{};
+        attachment.format = imageInfo.format;
+        attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+        attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        attachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+        VkAttachmentReference colorRef{0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+        VkSubpassDescription subpass{};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount = 1;
+        subpass.pColorAttachments = &colorRef;
+
+        VkRenderPassCreateInfo renderPassInfo{VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO};
+        renderPassInfo.attachmentCount = 1;
+        renderPassInfo.pAttachments = &attachment;
+        renderPassInfo.subpassCount = 1;
+        renderPassInfo.pSubpasses = &subpass;
+        Check(vkCreateRenderPass(ctx.device, &renderPassInfo, nullptr, &ctx.renderPass), "Failed to create render pass!");
+
+        VkFramebufferCreateInfo framebufferInfo{VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO};
+        framebufferInfo.renderPass = ctx.renderPass;
+        framebufferInfo.attachmentCount = 1;
+        framebufferInfo.pAttachments = &ctx.view;
+        framebufferInfo.width = TargetSize;
+        framebufferInfo.height = TargetSize;
+        framebufferInfo.layers = 1;
+        Check(vkCreateFramebuffer(ctx.device, &framebufferInfo, nullptr, &ctx.framebuffer), "Failed to create framebuffer!");
+
+        VkCommandPoolCreateInfo poolInfo{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        poolInfo.queueFamilyIndex = ctx.queueFamily;
+        Check(vkCreateCommandPool(ctx.device, &poolInfo, nullptr, &ctx.pool), "Failed to create command pool!");
+
+        VkCommandBufferAllocateInfo bufferInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+        bufferInfo.commandPool = ctx.pool;
+        bufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        bufferInfo.commandBufferCount = 1;
+        Check(vkAllocateCommandBuffers(ctx.device, &bufferInfo, &ctx.primary), "Failed to allocate command buffer!");
+
+        VkFenceCreateInfo fenceInfo{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+        Check(vkCreateFence(ctx.device, &fenceInfo, nullptr, &ctx.fence), "Failed to create fence!");
+    }
+
+    // -----------------------------------------------------------------------------
+    // Destroys everything CreateContext made.
+    // -----------------------------------------------------------------------------
+    void DestroyContext(Context& ctx) {
+        if (ctx.device != VK_NULL_HANDLE) {
+            vkDeviceWaitIdle(ctx.device);
+            vkDestroyFence(ctx.device, ctx.fence, nullptr);
+            vkDestroyCommandPool(ctx.device, ctx.pool, nullptr);
+            vkDestroyFramebuffer(ctx.device, ctx.framebuffer, nullptr);
+            vkDestroyRenderPass(ctx.device, ctx.renderPass, nullptr);
+            vkDestroyImageView(ctx.device, ctx.view, nullptr);
+            vkDestroyImage(ctx.device, ctx.image, nullptr);
+            vkFreeMemory(ctx.device, ctx.memory, nullptr);
+            vkDestroyDevice(ctx.device, nullptr);
+        }
+        if (ctx.instance != VK_NULL_HANDLE) {
+            vkDestroyInstance(ctx.instance, nullptr);
+        }
+    }
+
+    /// Scene recorded by every slice: a grid of small cleared rectangles.
+    struct Scene {
+        std::vector<VkClearRect>       rects;
+        std::vector<VkClearColorValue> colors;
+    };
+
+    // -----------------------------------------------------------------------------
+    // Fills the scene with @p count 8x8 rectangles.
+    // -----------------------------------------------------------------------------
+    void BuildScene(Scene& scene, std::uint32_t count) {
+        scene.rects.resize(count);
+        scene.colors.resize(count);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            const std::uint32_t cell = i % ((TargetSize / 8) * (TargetSize / 8));
+            scene.rects[i].rect.offset = {static_cast<std::int32_t>(cell % (TargetSize / 8) * 8),
+                                          static_cast<std::int32_t>(cell / (TargetSize / 8) * 8)};
+            scene.rects[i].rect.extent = {8, 8};
+            scene.rects[i].baseArrayLayer = 0;
+            scene.rects[i].layerCount = 1;
+            scene.colors[i] = {{(i & 255) / 255.0f, ((i >> 8) & 255) / 255.0f, 0.5f, 1.0f}};
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // Records scene rects [begin, end) into a secondary command buffer.
+    // -----------------------------------------------------------------------------
+    void RecordRects(void* context, VkCommandBuffer commandBuffer, std::uint32_t begin, std::uint32_t end) {
+        const auto* scene = static_cast<const Scene*>(context);
+        for (std::uint32_t i = begin; i < end; ++i) {
+            VkClearAttachment attachment{};
+            attachment.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            attachment.colorAttachment = 0;
+            attachment.clearValue.color = scene->colors[i];
+            vkCmdClearAttachments(commandBuffer, 1, &attachment, 1, &scene->rects[i]);
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // Records and submits the scene @p Repetitions times; returns the best record
+    // time in seconds (secondaries plus the primary that executes them).
+    // -----------------------------------------------------------------------------
+    double MeasureRecording(Context& ctx, JobSystem& jobs, VulkanCommandRecorder& recorder, Scene& scene) {
+        double best = 1e30;
+        for (int run = 0; run < Repetitions; ++run) {
+            recorder.ResetFrame(0);
+            const Clock::time_point start = Clock::now();
+
+            VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            vkBeginCommandBuffer(ctx.primary, &beginInfo);
+
+            VkClearValue clearValue{};
+            VkRenderPassBeginInfo renderPassInfo{VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
+            renderPassInfo.renderPass = ctx.renderPass;
+            renderPassInfo.framebuffer = ctx.framebuffer;
+            renderPassInfo.renderArea.extent = {TargetSize, TargetSize};
+            renderPassInfo.clearValueCount = 1;
+            renderPassInfo.pClearValues = &clearValue;
+            vkCmdBeginRenderPass(ctx.primary, &renderPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+            VkCommandBufferInheritanceInfo inheritance{VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO};
+            inheritance.renderPass = ctx.renderPass;
+            inheritance.framebuffer = ctx.framebuffer;
+
+            const std::vector<VkCommandBuffer>& secondaries = recorder.Record(
+                &jobs, 0, inheritance, static_cast<std::uint32_t>(scene.rects.size()), RectsPerSlice, &RecordRects, &scene);
+            vkCmdExecuteCommands(ctx.primary, static_cast<std::uint32_t>(secondaries.size()), secondaries.data());
+
+            vkCmdEndRenderPass(ctx.primary);
+            vkEndCommandBuffer(ctx.primary);
+            best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+
+            // Submit so the pools are legitimately idle before the next reset.
+            VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &ctx.primary;
+            Check(vkQueueSubmit(ctx.queue, 1, &submitInfo, ctx.fence), "Failed to submit command buffer!");
+            vkWaitForFences(ctx.device, 1, &ctx.fence, VK_TRUE, UINT64_MAX);
+            vkResetFences(ctx.device, 1, &ctx.fence);
+        }
+        return best;
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::uint32_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    const std::uint32_t maxThreads = argc >= 2 ? std::max(1, std::atoi(argv[1])) : hardware;
+    const std::uint32_t rectCount = argc >= 3 ? std::max(1, std::atoi(argv[2])) : 100000;
+
+    Context ctx;
+    try {
+        CreateContext(ctx);
+
+        Scene scene;
+        BuildScene(scene, rectCount);
+
+        std::printf("Recording %u rect(s), %u per slice at least\n", rectCount, RectsPerSlice);
+        std::printf("%8s %12s %10s\n", "threads", "record ms", "speedup");
+
+        double baseline = 0.0;
+        for (std::uint32_t threads = 1; threads <= maxThreads; ++threads) {
+            JobSystem jobs(threads - 1);
+            if (jobs.GetThreadCount() != threads) {
+                break;
+            }
+
+            VulkanCommandRecorder recorder;
+            recorder.Create(ctx.device, ctx.queueFamily, 1, threads);
+            const double seconds = MeasureRecording(ctx, jobs, recorder, scene);
+            recorder.Destroy();
+
+            if (threads == 1) {
+                baseline = seconds;
+            }
+            std::printf("%8u %12.3f %9.2fx\n", threads, seconds * 1e3, baseline / seconds);
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        DestroyContext(ctx);
+        return 1;
+    }
+
+    DestroyContext(ctx);
+    return 0;
+}
@@ -0,0 +1,252 @@
+// -----------------------------------------------------------------------------
+// jelly_bench: reproducible engine scenarios run headless through the C API, with
+// results written as JSON. Point the Vulkan loader at a software driver (for example
+// VK_ICD_FILENAMES=.../lvp_icd.x86_64.json) to compare runs across machines.
+//
+// Scenarios:
+//   init    cold jellyEngineInitialize + jellyEngineShutdown
+//   frame   steady-state jellyEngineRender with a clear and a handful of sprites
+//   resize  jellyEngineResize followed by the frame that rebuilds the targets
+//   draw    jellyEngineRender with DrawSpriteCount sprites per frame
+//   upload  reserved until uploads are reachable through the C API; reported as skipped
+//
+// Usage: jelly_bench [output.json] [frames]
+// -----------------------------------------------------------------------------
+
+#include "JellyEngineAPI.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int           TargetWidth     = 1280;
+    constexpr int           TargetHeight    = 720;
+    constexpr int           InitRepetitions = 5;
+    constexpr int           WarmupFrames    = 30;
+    constexpr int           DefaultFrames   = 600;
+    constexpr int           ResizeCount     = 40;
+    constexpr std::uint32_t LightSprites    = 64;
+    constexpr std::uint32_t DrawSpriteCount = 10000;
+
+    /// Percentile summary of a set of samples, in milliseconds.
+    struct Summary {
+        std::size_t count = 0;
+        double      mean  = 0.0;
+        double      min   = 0.0;
+        double      p50   = 0.0;
+        double      p90   = 0.0;
+        double      p99   = 0.0;
+        double      max   = 0.0;
+    };
+
+    // -----------------------------------------------------------------------------
+    // Returns the milliseconds elapsed since @p start.
+    // -----------------------------------------------------------------------------
+    double ElapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // -----------------------------------------------------------------------------
+    // Sorts the samples and computes nearest-rank percentiles.
+    // -----------------------------------------------------------------------------
+    Summary Summarize(std::vector<double> samples) {
+        Summary summary;
+        if (samples.empty()) {
+            return summary;
+        }
+
+        std::sort(samples.begin(), samples.end());
+        auto rank = [&](double p) {
+            const auto index = static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1) + 0.5);
+            return samples[std::min(index, samples.size() - 1)];
+        };
+
+        double total = 0.0;
+        for (double sample : samples) {
+            total += sample;
+        }
+
+        summary.count = samples.size();
+        summary.mean  = total / static_cast<double>(samples.size());
+        summary.min   = samples.front();
+        summary.p50   = rank(0.50);
+        summary.p90   = rank(0.90);
+        summary.p99   = rank(0.99);
+        summary.max   = samples.back();
+        return summary;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Creates a headless engine at the benchmark resolution.
+    // -----------------------------------------------------------------------------
+    JellyEngineHandle CreateEngine() {
+        return jellyEngineInitialize(TargetWidth, TargetHeight, false, "jelly_bench", "Vulkan", JELLY_INIT_HEADLESS);
+    }
+
+    // -----------------------------------------------------------------------------
+    // Writes a clear and @p sprites sprites into the command ring.
+    // The sprite positions only depend on the index so every run draws the same frame.
+    // -----------------------------------------------------------------------------
+    bool QueueScene(const RenderCommandRingView& ring, std::uint32_t sprites) {
+        // The engine keeps both indices as std::atomic<uint32_t> (see RenderCommandRing).
+        auto* writeIndex = reinterpret_cast<std::atomic<std::uint32_t>*>(ring.writeIndex);
+        auto* readIndex  = reinterpret_cast<const std::atomic<std::uint32_t>*>(ring.readIndex);
+
+        const std::uint32_t write = writeIndex->load(std::memory_order_relaxed);
+        const std::uint32_t read  = readIndex->load(std::memory_order_acquire);
+        if (sprites + 1 > ring.capacity - (write - read)) {
+            return false;
+        }
+
+        RenderCommand& clear = ring.commands[write & (ring.capacity - 1)];
+        clear = {};
+        clear.type = RenderCommandType::ClearColor;
+        clear.clearColor = { { 0.1f, 0.1f, 0.12f, 1.0f } };
+
+        for (std::uint32_t i = 0; i < sprites; ++i) {
+            RenderCommand& command = ring.commands[(write + 1 + i) & (ring.capacity - 1)];
+            command = {};
+            command.type = RenderCommandType::DrawSprite;
+            command.drawSprite.x = static_cast<float>((i * 37) % TargetWidth);
+            command.drawSprite.y = static_cast<float>((i * 23) % TargetHeight);
+            command.drawSprite.width = 16.0f;
+            command.drawSprite.height = 16.0f;
+            command.drawSprite.color[0] = static_cast<float>(i % 7) / 6.0f;
+            command.drawSprite.color[1] = static_cast<float>(i % 5) / 4.0f;
+            command.drawSprite.color[2] = static_cast<float>(i % 3) / 2.0f;
+            command.drawSprite.color[3] = 1.0f;
+        }
+
+        writeIndex->store(write + 1 + sprites, std::memory_order_release);
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Renders @p frames frames of @p sprites sprites and collects the per-frame times.
+    // Returns false if a scene did not fit in the command ring; timing that frame would
+    // measure an empty or partial frame.
+    // -----------------------------------------------------------------------------
+    bool RunFrames(JellyEngineHandle engine, const RenderCommandRingView& ring, std::uint32_t sprites, int frames,
+                   std::vector<double>& samples) {
+        samples.clear();
+        samples.reserve(static_cast<std::size_t>(frames));
+
+        for (int i = 0; i < WarmupFrames + frames && jellyEngineIsRunning(engine); ++i) {
+            const auto start = Clock::now();
+            jellyEnginePoll(engine, nullptr);
+            if (!QueueScene(ring, sprites)) {
+                return false;
+            }
+            jellyEngineRender(engine);
+            if (i >= WarmupFrames) {
+                samples.push_back(ElapsedMs(start));
+            }
+        }
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Appends one scenario object to the JSON document.
+    // -----------------------------------------------------------------------------
+    void WriteScenario(std::string& json, const char* name, const char* unit, const Summary& summary, bool last) {
+        char text[512];
+        std::snprintf(text, sizeof(text),
+                      "    \"%s\": { \"unit\": \"%s\", \"count\": %zu, \"mean\": %.4f, \"min\": %.4f, "
+                      "\"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f }%s\n",
+                      name, unit, summary.count, summary.mean, summary.min, summary.p50, summary.p90, summary.p99,
+                      summary.max, last ? "" : ",");
+        json += text;
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* outputPath = argc >= 2 ? argv[1] : nullptr;
+    const int frames = argc >= 3 ? std::max(1, std::atoi(argv[2])) : DefaultFrames;
+
+    // Cold initialization: every repetition creates and destroys the whole engine.
+    std::vector<double> initSamples;
+    for (int i = 0; i < InitRepetitions; ++i) {
+        const auto start = Clock::now();
+        const JellyEngineHandle engine = CreateEngine();
+        const double elapsed = ElapsedMs(start);
+        if (!engine) {
+            std::fprintf(stderr, "Headless engine initialization failed\n");
+            return 1;
+        }
+        initSamples.push_back(elapsed);
+        jellyEngineShutdown(engine);
+    }
+
+    const JellyEngineHandle engine = CreateEngine();
+    RenderCommandRingView ring{};
+    if (!engine || !jellyEngineGetRenderCommandRing(engine, &ring)) {
+        std::fprintf(stderr, "Headless engine initialization failed\n");
+        return 1;
+    }
+    jellyEngineSetFrameTiming(engine, 0.0, 0.0);
+
+    std::vector<double> frameSamples;
+    bool queued = RunFrames(engine, ring, LightSprites, frames, frameSamples);
+
+    // Resize: alternate between two sizes; the measured frame includes the rebuild.
+    std::vector<double> resizeSamples;
+    for (int i = 0; i < ResizeCount && queued && jellyEngineIsRunning(engine); ++i) {
+        const bool shrink = (i % 2) == 0;
+        const auto start = Clock::now();
+        jellyEngineResize(engine, shrink ? TargetWidth / 2 : TargetWidth, shrink ? TargetHeight / 2 : TargetHeight);
+        if (!QueueScene(ring, LightSprites)) {
+            queued = false;
+            break;
+        }
+        jellyEngineRender(engine);
+        resizeSamples.push_back(ElapsedMs(start));
+    }
+
+    std::vector<double> drawSamples;
+    queued = queued && RunFrames(engine, ring, DrawSpriteCount, frames, drawSamples);
+
+    const bool running = jellyEngineIsRunning(engine);
+    jellyEngineShutdown(engine);
+    if (!queued) {
+        std::fprintf(stderr, "A benchmark scene did not fit in the render command ring\n");
+        return 1;
+    }
+    if (!running) {
+        std::fprintf(stderr, "The engine stopped during the benchmark\n");
+        return 1;
+    }
+
+    std::string json = "{\n";
+    char header[256];
+    std::snprintf(header, sizeof(header),
+                  "  \"config\": { \"width\": %d, \"height\": %d, \"frames\": %d, \"warmupFrames\": %d, "
+                  "\"lightSprites\": %u, \"drawSprites\": %u },\n",
+                  TargetWidth, TargetHeight, frames, WarmupFrames, LightSprites, DrawSpriteCount);
+    json += header;
+    json += "  \"scenarios\": {\n";
+    WriteScenario(json, "init", "ms", Summarize(initSamples), false);
+    WriteScenario(json, "frame", "ms", Summarize(frameSamples), false);
+    WriteScenario(json, "resize", "ms", Summarize(resizeSamples), false);
+    WriteScenario(json, "draw", "ms", Summarize(drawSamples), false);
+    json += "    \"upload\": { \"skipped\": true, \"reason\": \"uploads are not exposed through the C API\" }\n";
+    json += "  }\n}\n";
+
+    std::FILE* output = outputPath ? std::fopen(outputPath, "w") : stdout;
+    if (!output) {
+        std::fprintf(stderr, "Cannot create %s\n", outputPath);
+        return 1;
+    }
+    std::fputs(json.c_str(), output);
+    if (output != stdout) {
+        std::fclose(output);
+    }
+    return 0;
+}
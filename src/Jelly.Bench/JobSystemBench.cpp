@@ -0,0 +1,134 @@
+// -----------------------------------------------------------------------------
+// jelly_jobs_bench: measures JobSystem scheduling overhead and ParallelFor scaling.
+//
+// Usage: jelly_jobs_bench [maxThreads]
+// -----------------------------------------------------------------------------
+
+#include "Jobs/JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::uint32_t EmptyJobs    = 100000;
+    constexpr std::uint32_t WorkItems    = 1u << 18;
+    constexpr std::uint32_t WorkGrain    = 1024;
+    constexpr int           Repetitions  = 5;
+
+    // -----------------------------------------------------------------------------
+    // Returns the seconds elapsed since @p start.
+    // -----------------------------------------------------------------------------
+    double SecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // -----------------------------------------------------------------------------
+    // Job that does nothing, so only scheduling and completion are measured.
+    // -----------------------------------------------------------------------------
+    void EmptyJob(void*, std::uint32_t, std::uint32_t) {
+    }
+
+    // -----------------------------------------------------------------------------
+    // Schedules and waits on empty jobs; returns the best nanoseconds per job.
+    // -----------------------------------------------------------------------------
+    double MeasureOverhead(JobSystem& jobs) {
+        double best = 1e30;
+        for (int run = 0; run < Repetitions; ++run) {
+            JobCounter counter;
+            const Clock::time_point start = Clock::now();
+            for (std::uint32_t i = 0; i < EmptyJobs; ++i) {
+                jobs.Schedule(&EmptyJob, nullptr, 0, 0, &counter);
+            }
+            jobs.Wait(counter);
+            best = std::min(best, SecondsSince(start) * 1e9 / EmptyJobs);
+        }
+        return best;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Runs a compute-bound ParallelFor; returns the best time in seconds.
+    // -----------------------------------------------------------------------------
+    double MeasureParallelFor(JobSystem& jobs, std::vector<float>& values) {
+        double best = 1e30;
+        for (int run = 0; run < Repetitions; ++run) {
+            const Clock::time_point start = Clock::now();
+            jobs.ParallelFor(WorkItems, WorkGrain, [&](std::uint32_t begin, std::uint32_t end) {
+                for (std::uint32_t i = begin; i < end; ++i) {
+                    float x = static_cast<float>(i) * 0.001f;
+                    for (int k = 0; k < 8; ++k) {
+                        x = std::sin(x) + std::cos(x) * 0.5f;
+                    }
+                    values[i] = x;
+                }
+            });
+            best = std::min(best, SecondsSince(start));
+        }
+        return best;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Checks that a dependent job only runs after the group it depends on.
+    // -----------------------------------------------------------------------------
+    bool CheckDependencies(JobSystem& jobs) {
+        struct State {
+            std::atomic<std::uint32_t> produced{0};
+            std::atomic<bool>          early{false};
+        } state;
+
+        JobCounter producers;
+        JobCounter consumer;
+        for (std::uint32_t i = 0; i < 64; ++i) {
+            jobs.Schedule([](void* context, std::uint32_t, std::uint32_t) {
+                static_cast<State*>(context)->produced.fetch_add(1);
+            }, &state, 0, 0, &producers);
+        }
+        jobs.Schedule([](void* context, std::uint32_t, std::uint32_t) {
+            auto* s = static_cast<State*>(context);
+            if (s->produced.load() != 64) {
+                s->early.store(true);
+            }
+        }, &state, 0, 0, &consumer, &producers);
+
+        jobs.Wait(consumer);
+        return !state.early.load();
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::uint32_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    const std::uint32_t maxThreads = argc >= 2 ? std::max(1, std::atoi(argv[1])) : hardware;
+
+    std::vector<float> values(WorkItems);
+
+    std::printf("Job system benchmark (%u hardware thread(s))\n", hardware);
+    std::printf("%8s %14s %14s %10s %10s\n", "threads", "ns/empty job", "parallel ms", "speedup", "deps");
+
+    double baseline = 0.0;
+    bool ok = true;
+    for (std::uint32_t threads = 1; threads <= maxThreads; ++threads) {
+        JobSystem jobs(threads - 1);
+        if (jobs.GetThreadCount() != threads) {
+            break;
+        }
+
+        const double overhead = MeasureOverhead(jobs);
+        const double seconds = MeasureParallelFor(jobs, values);
+        const bool dependencies = CheckDependencies(jobs);
+        ok = ok && dependencies;
+
+        if (threads == 1) {
+            baseline = seconds;
+        }
+        std::printf("%8u %14.1f %14.2f %9.2fx %10s\n", threads, overhead, seconds * 1e3, baseline / seconds,
+                    dependencies ? "ok" : "FAILED");
+    }
+
+    return ok ? 0 : 1;
+}
@@ -5,12 +5,48 @@ namespace Jelly.Engine;
 /// <summary>
 /// High-level façade that boots, runs, and shuts down a native Jelly engine instance.
 /// </summary>
-public class JellyApplication
+public unsafe class JellyApplication
 {
     /// <summary>
-    /// Opaque native handle returned by the engine bootstrapper.
+    /// Generational native handle returned by the engine bootstrapper (0 = failed).
     /// </summary>
-    private readonly IntPtr _jellyHandle;
+    private readonly ulong _jellyHandle;
+
+    /// <summary>
+    /// Native frame timing block, refreshed by every tick.
+    /// </summary>
+    private readonly FrameTiming* _timing;
+
+    /// <summary>
+    /// Commands recorded for the next frame.
+    /// </summary>
+    public RenderCommands Commands { get; }
+
+    /// <summary>
+    /// Timing of the last frame: delta, simulation steps and interpolation alpha.
+    /// </summary>
+    public FrameTiming Timing => *_timing;
+
+    /// <summary>
+    /// Raised once per fixed simulation step with the step length in seconds.
+    /// </summary>
+    public event Action<double>? FixedUpdate;
+
+    /// <summary>
+    /// Raised once per frame, before the frame is ticked, to record render commands.
+    /// Use <see cref="FrameTiming.Alpha"/> of <see cref="Timing"/> to interpolate between steps.
+    /// </summary>
+    public event Action<RenderCommands>? Render;
+
+    /// <summary>
+    /// Receives the input events of a frame, read directly from native memory.
+    /// </summary>
+    public delegate void InputHandler(ReadOnlySpan<InputEvent> events);
+
+    /// <summary>
+    /// Raised after every tick with the input events it polled.
+    /// </summary>
+    public event InputHandler? Input;
 
     // ──────────────────────────────────────────────────────────────────────────
     /// <summary>
@@ -24,13 +60,51 @@ public class JellyApplication
             windowSettings.Height,
             windowSettings.Vsync,
             windowSettings.Title,
-            "Vulkan");
-        if (_jellyHandle == IntPtr.Zero)
+            "Vulkan",
+            GetInitFlags(windowSettings));
+        if (_jellyHandle == 0)
         {
             Environment.Exit(1);
         }
+
+        Commands = new RenderCommands(JellyNative.GetRenderCommandRing(_jellyHandle));
+        _timing = JellyNative.GetFrameTiming(_jellyHandle);
     }
 
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Sets the fixed simulation step and the frame rate limit.
+    /// </summary>
+    /// <param name="fixedStepSeconds">Length of a <see cref="FixedUpdate"/> step in seconds.</param>
+    /// <param name="targetFps">Frame rate cap; 0 disables the limiter.</param>
+    public void SetFrameTiming(double fixedStepSeconds, double targetFps = 0.0)
+        => JellyNative.SetFrameTiming(_jellyHandle, fixedStepSeconds, targetFps);
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Selects how frames are presented; the swapchain is rebuilt before the next frame.
+    /// </summary>
+    /// <param name="mode">The preferred present mode; unsupported modes fall back.</param>
+    /// <param name="lowLatency"><c>true</c> to keep fewer images queued and pace frames on the display.</param>
+    public void SetPresentMode(PresentMode mode, bool lowLatency = false)
+        => JellyNative.SetPresentMode(_jellyHandle, mode, lowLatency);
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Returns the measured present-to-present intervals.
+    /// </summary>
+    public PresentStats GetPresentStats() => JellyNative.GetPresentStats(_jellyHandle);
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Moves rendering to a dedicated native thread, so the next frame's simulation overlaps
+    /// the GPU submission of the previous one.
+    /// </summary>
+    /// <param name="enabled"><c>true</c> to render on the render thread, <c>false</c> to render inline.</param>
+    /// <param name="queueDepth">Frames the game thread may run ahead, including the one being drawn.</param>
+    public void SetRenderThread(bool enabled, uint queueDepth = 2)
+        => JellyNative.SetRenderThread(_jellyHandle, enabled, queueDepth);
+
     // ──────────────────────────────────────────────────────────────────────────
     /// <summary>
     /// Enters the main loop and blocks until <see cref="Stop"/> is called
@@ -41,15 +115,33 @@ public class JellyApplication
     // ──────────────────────────────────────────────────────────────────────────
     /// <summary>
     /// Runs the engine’s event/render loop until the native side reports it should exit.
+    /// Each iteration records the frame's commands and makes a single native transition.
     /// </summary>
     private void Lifecycle()
     {
-        while (JellyNative.IsRunning(_jellyHandle))
+        while (true)
         {
-            JellyNative.Poll(_jellyHandle);
-            JellyNative.Render(_jellyHandle);
+            Render?.Invoke(Commands);
+            Commands.Commit();
+
+            var flags = JellyNative.Tick(_jellyHandle, out var events);
+            if ((flags & EngineTickFlags.Running) == 0)
+            {
+                break;
+            }
+
+            if (!events.IsEmpty)
+            {
+                Input?.Invoke(events);
+            }
+
+            var steps = _timing->FixedSteps;
+            var step = _timing->FixedStepSeconds;
+            for (var i = 0u; i < steps; i++)
+            {
+                FixedUpdate?.Invoke(step);
+            }
         }
-            
     }
 
     // ──────────────────────────────────────────────────────────────────────────
@@ -58,4 +150,22 @@ public class JellyApplication
     /// Safe to call multiple times.
     /// </summary>
     public void Stop() => JellyNative.Shutdown(_jellyHandle);
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Translates the window settings into native initialization flags.
+    /// </summary>
+    private static EngineInitFlags GetInitFlags(WindowSettings windowSettings)
+    {
+        EngineInitFlags flags = windowSettings.Headless ? EngineInitFlags.Headless : EngineInitFlags.None;
+        if (windowSettings.FramesInFlight == 1)
+        {
+            flags |= EngineInitFlags.LowLatency;
+        }
+        else if (windowSettings.FramesInFlight >= 3)
+        {
+            flags |= EngineInitFlags.HighThroughput;
+        }
+        return flags;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,20 @@
+namespace Jelly.Engine;
+
+/// <summary>
+/// Subsystem a log message comes from. Each category has its own level mask.
+/// Values match the native <c>LogCategory</c> enum.
+/// </summary>
+public enum LogCategory
+{
+    /// <summary>Engine lifetime and core services.</summary>
+    Engine,
+
+    /// <summary>Window system and input.</summary>
+    Window,
+
+    /// <summary>Vulkan graphics backend.</summary>
+    Vulkan,
+
+    /// <summary>Messages logged from managed code.</summary>
+    Managed
+}
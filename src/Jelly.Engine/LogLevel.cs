@@ -3,7 +3,7 @@ namespace Jelly.Engine;
 /// <summary>
 /// Represents the severity or purpose of a log message.
 /// </summary>
-internal enum LogLevel
+public enum LogLevel
 {
     /// <summary>Standard information for general output.</summary>
     Info,
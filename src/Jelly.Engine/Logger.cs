@@ -1,9 +1,13 @@
+using System.Runtime.CompilerServices;
+using System.Text;
 using Jelly.Assembly;
 
 namespace Jelly.Engine;
 
 /// <summary>
 /// Provides logging utilities for the engine layer.
+/// Messages are logged under <see cref="LogCategory.Managed"/>; disabled levels return
+/// before any string is built or marshalled.
 /// </summary>
 public static class Logger
 {
@@ -11,8 +15,110 @@ public static class Logger
     /// Logs an informational message to the native logging system.
     /// </summary>
     /// <param name="message">The message to be logged.</param>
-    public static void Info(string message)
+    public static void Info(string message) => Log(LogLevel.Info, message);
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Logs a highlighted informational message.
+    /// </summary>
+    /// <param name="message">The message to be logged.</param>
+    public static void Highlight(string message) => Log(LogLevel.Highlight, message);
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Logs a warning.
+    /// </summary>
+    /// <param name="message">The message to be logged.</param>
+    public static void Warning(string message) => Log(LogLevel.Warning, message);
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Logs an error.
+    /// </summary>
+    /// <param name="message">The message to be logged.</param>
+    public static void Error(string message) => Log(LogLevel.Error, message);
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Logs a message with the given level, if that level is enabled.
+    /// </summary>
+    /// <param name="level">Severity of the message.</param>
+    /// <param name="message">The message to be logged.</param>
+    public static void Log(LogLevel level, string message)
+    {
+        if (IsEnabled(level))
+        {
+            JellyNative.Log((int)level, message);
+        }
+    }
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Logs an interpolated message. The string is only built when the level is enabled.
+    /// </summary>
+    /// <param name="level">Severity of the message.</param>
+    /// <param name="handler">Interpolated string built by the compiler.</param>
+    public static void Log(LogLevel level, [InterpolatedStringHandlerArgument("level")] ref LogInterpolatedStringHandler handler)
+    {
+        if (handler.Enabled)
+        {
+            JellyNative.Log((int)level, handler.ToStringAndClear());
+        }
+    }
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Returns <c>true</c> if managed messages of <paramref name="level"/> are emitted.
+    /// </summary>
+    public static bool IsEnabled(LogLevel level)
+        => JellyNative.IsLogEnabled((int)LogCategory.Managed, (int)level);
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Enables exactly the given levels for a category.
+    /// </summary>
+    /// <param name="category">Category to configure.</param>
+    /// <param name="levels">Levels to enable; every other level is disabled.</param>
+    public static void SetLevels(LogCategory category, params LogLevel[] levels)
+    {
+        uint mask = 0;
+        foreach (var level in levels)
+        {
+            mask |= 1u << (int)level;
+        }
+        JellyNative.SetLogLevelMask((int)category, mask);
+    }
+}
+
+// ──────────────────────────────────────────────────────────────────────────────
+/// <summary>
+/// Interpolated string handler that skips formatting when the log level is disabled.
+/// </summary>
+[InterpolatedStringHandler]
+public ref struct LogInterpolatedStringHandler
+{
+    private StringBuilder? _builder;
+
+    /// <summary>Whether the level was enabled when the handler was created.</summary>
+    public bool Enabled => _builder != null;
+
+    public LogInterpolatedStringHandler(int literalLength, int formattedCount, LogLevel level, out bool shouldAppend)
+    {
+        shouldAppend = Logger.IsEnabled(level);
+        _builder = shouldAppend ? new StringBuilder(literalLength + formattedCount * 8) : null;
+    }
+
+    public void AppendLiteral(string value) => _builder!.Append(value);
+
+    public void AppendFormatted<T>(T value) => _builder!.Append(value);
+
+    public void AppendFormatted<T>(T value, string? format) where T : IFormattable
+        => _builder!.Append(value.ToString(format, null));
+
+    internal string ToStringAndClear()
     {
-        JellyNative.Log((int)LogLevel.Info, message);
+        var text = _builder!.ToString();
+        _builder = null;
+        return text;
     }
-}
\ No newline at end of file
+}
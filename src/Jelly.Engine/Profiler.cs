@@ -0,0 +1,24 @@
+using Jelly.Assembly;
+
+namespace Jelly.Engine;
+
+/// <summary>
+/// Controls the native CPU profiler.
+/// </summary>
+public static class Profiler
+{
+    /// <summary>
+    /// Starts or stops recording zones.
+    /// </summary>
+    public static void SetEnabled(bool enabled) => JellyNative.SetProfilerEnabled(enabled);
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Writes the last <paramref name="frames"/> frames as a Chrome trace that opens in Perfetto
+    /// (ui.perfetto.dev) or chrome://tracing.
+    /// </summary>
+    /// <param name="path">File to create or overwrite.</param>
+    /// <param name="frames">Number of most recent frames to export.</param>
+    /// <returns><c>false</c> if the profiler is compiled out or the file could not be written.</returns>
+    public static bool Dump(string path, uint frames = 120) => JellyNative.DumpProfile(path, frames);
+}
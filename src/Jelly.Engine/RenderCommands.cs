@@ -0,0 +1,82 @@
+using Jelly.Assembly;
+
+namespace Jelly.Engine;
+
+/// <summary>
+/// Records render commands for the next frame into the engine's shared command ring.
+/// Nothing crosses into native code until the frame is ticked.
+/// </summary>
+public sealed class RenderCommands
+{
+    private readonly RenderCommandRing _ring;
+
+    internal RenderCommands(RenderCommandRing ring)
+    {
+        _ring = ring;
+    }
+
+    /// <summary>Number of commands that can still be recorded this frame.</summary>
+    public int Free => _ring.Free;
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Sets the color the frame is cleared to.
+    /// </summary>
+    /// <returns><c>false</c> if the ring is full and the command was dropped.</returns>
+    public bool Clear(float r, float g, float b, float a = 1.0f)
+    {
+        var command = new RenderCommand { Type = RenderCommandType.ClearColor };
+        command.ClearColor = new ClearColorCommand { R = r, G = g, B = b, A = a };
+        return _ring.TryWrite(command);
+    }
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Sets the affine transform applied to the following sprites. Every frame starts with identity.
+    /// </summary>
+    /// <returns><c>false</c> if the ring is full and the command was dropped.</returns>
+    public bool SetTransform(float m11, float m12, float m21, float m22, float m31, float m32)
+    {
+        var command = new RenderCommand { Type = RenderCommandType.SetTransform };
+        command.SetTransform = new SetTransformCommand
+        {
+            M11 = m11, M12 = m12, M21 = m21, M22 = m22, M31 = m31, M32 = m32
+        };
+        return _ring.TryWrite(command);
+    }
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Draws a solid sprite through the current transform.
+    /// </summary>
+    /// <returns><c>false</c> if the ring is full and the command was dropped.</returns>
+    public bool DrawSprite(float x, float y, float width, float height, float r, float g, float b, float a = 1.0f)
+    {
+        var command = new RenderCommand { Type = RenderCommandType.DrawSprite };
+        command.DrawSprite = new DrawSpriteCommand
+        {
+            X = x, Y = y, Width = width, Height = height,
+            R = r, G = g, B = b, A = a
+        };
+        return _ring.TryWrite(command);
+    }
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Returns a contiguous span of up to <paramref name="count"/> command slots for bulk writes.
+    /// Call <see cref="Advance"/> with the number of slots actually filled.
+    /// </summary>
+    public Span<RenderCommand> GetSpan(int count) => _ring.GetSpan(count);
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Marks <paramref name="count"/> slots returned by <see cref="GetSpan"/> as written.
+    /// </summary>
+    public void Advance(int count) => _ring.Advance(count);
+
+    // ──────────────────────────────────────────────────────────────────────────
+    /// <summary>
+    /// Publishes the recorded commands to the engine.
+    /// </summary>
+    internal void Commit() => _ring.Commit();
+}
@@ -21,4 +21,16 @@ public struct WindowSettings
 
     /// <summary>Initial window title.</summary>
     public string Title;
+
+    /// <summary>
+    /// Renders offscreen at <see cref="Width"/> x <see cref="Height"/> without opening a window,
+    /// e.g. for benchmarks and batch rendering on machines without a display.
+    /// </summary>
+    public bool Headless;
+
+    /// <summary>
+    /// Frames the CPU may record ahead of the GPU: 1 for the lowest latency, 3 for throughput.
+    /// 0 keeps the default of 2.
+    /// </summary>
+    public uint FramesInFlight;
 }
\ No newline at end of file
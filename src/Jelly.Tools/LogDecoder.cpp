@@ -0,0 +1,146 @@
+// -----------------------------------------------------------------------------
+// jelly_logdecode: expands a binary log file written by Logger::OpenBinaryLog.
+//
+// Usage: jelly_logdecode <file.jlog> [output.txt]
+// -----------------------------------------------------------------------------
+
+#include "Logging/BinaryLogWriter.h"
+#include "Logging/LogArgs.h"
+#include "Logging/LogFormatter.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <unordered_map>
+
+namespace {
+    // -----------------------------------------------------------------------------
+    // Reads a trivially copyable value; returns false at end of file.
+    // -----------------------------------------------------------------------------
+    template <typename T>
+    bool Read(std::FILE* file, T& value) {
+        return std::fread(&value, sizeof(T), 1, file) == 1;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Formats a Unix timestamp in nanoseconds as "YYYY-MM-DD HH:MM:SS.mmm".
+    // -----------------------------------------------------------------------------
+    std::string FormatTimestamp(std::int64_t unixNanoseconds) {
+        const auto t = static_cast<std::time_t>(unixNanoseconds / 1000000000);
+        const auto millis = static_cast<int>((unixNanoseconds / 1000000) % 1000);
+
+        std::tm tm;
+#if defined(_WIN32)
+        localtime_s(&tm, &t);
+#else
+        localtime_r(&t, &tm);
+#endif
+        char date[32];
+        std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", &tm);
+
+        char text[48];
+        std::snprintf(text, sizeof(text), "%s.%03d", date, millis);
+        return text;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: %s <file.jlog> [output.txt]\n", argv[0]);
+        return 1;
+    }
+
+    std::FILE* input = std::fopen(argv[1], "rb");
+    if (!input) {
+        std::fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    std::FILE* output = stdout;
+    if (argc >= 3) {
+        output = std::fopen(argv[2], "w");
+        if (!output) {
+            std::fprintf(stderr, "Cannot create %s\n", argv[2]);
+            std::fclose(input);
+            return 1;
+        }
+    }
+
+    char magic[sizeof(BinaryLogMagic)];
+    std::uint32_t version = 0;
+    if (std::fread(magic, 1, sizeof(magic), input) != sizeof(magic) ||
+        std::memcmp(magic, BinaryLogMagic, sizeof(magic)) != 0 ||
+        !Read(input, version) || version != BinaryLogVersion) {
+        std::fprintf(stderr, "%s is not a version %u Jelly binary log\n", argv[1], BinaryLogVersion);
+        std::fclose(input);
+        return 1;
+    }
+
+    std::unordered_map<std::uint32_t, std::string> formats;
+    std::uint8_t payload[MaxLogPayload];
+    std::string message;
+    std::size_t records = 0;
+    bool corrupt = false;
+
+    std::uint8_t tag = 0;
+    while (Read(input, tag)) {
+        if (tag == static_cast<std::uint8_t>(BinaryLogEntry::Format)) {
+            std::uint32_t id = 0;
+            std::uint16_t length = 0;
+            if (!Read(input, id) || !Read(input, length)) {
+                corrupt = true;
+                break;
+            }
+
+            std::string format(length, '\0');
+            if (length > 0 && std::fread(&format[0], 1, length, input) != length) {
+                corrupt = true;
+                break;
+            }
+            formats[id] = std::move(format);
+        } else if (tag == static_cast<std::uint8_t>(BinaryLogEntry::Record)) {
+            std::int64_t timestamp = 0;
+            std::uint32_t formatId = 0;
+            std::uint8_t category = 0;
+            std::uint8_t level = 0;
+            std::uint8_t flags = 0;
+            std::uint16_t size = 0;
+            if (!Read(input, timestamp) || !Read(input, formatId) || !Read(input, category) || !Read(input, level) ||
+                !Read(input, flags) || !Read(input, size) || size > sizeof(payload) ||
+                std::fread(payload, 1, size, input) != size) {
+                corrupt = true;
+                break;
+            }
+
+            auto format = formats.find(formatId);
+            if (format == formats.end()) {
+                corrupt = true;
+                break;
+            }
+
+            message.clear();
+            FormatLogMessage(message, format->second.c_str(), payload, size, (flags & BinaryLogTruncated) != 0);
+            std::fprintf(output, "[%s] %s%s%s\n",
+                         FormatTimestamp(timestamp).c_str(),
+                         LogLevelTag(static_cast<LogLevel>(level)),
+                         LogCategoryTag(static_cast<LogCategory>(category)),
+                         message.c_str());
+            ++records;
+        } else {
+            corrupt = true;
+            break;
+        }
+    }
+
+    if (corrupt) {
+        std::fprintf(stderr, "Stopped at a corrupt or truncated entry after %zu record(s)\n", records);
+    }
+
+    std::fclose(input);
+    if (output != stdout) {
+        std::fclose(output);
+    }
+    return corrupt ? 2 : 0;
+}
@@ -3,8 +3,11 @@
 #include <string>
 #include <algorithm>
 #include <iostream>
+#include <memory>
 
 #include "JellyEngine.h"
+#include "Logger.h"
+#include "Core/HandlePool.h"
 #include "Graphics/GraphicsAPIType.h"
 #include "Graphics/GraphicsApiException.h"
 
@@ -27,14 +30,38 @@ namespace {
 
         throw GraphicsApiException("Unknown Graphics API: " + lower);
     }
+
+    /// Live engine instances. Engines are not movable, so the pool stores owning pointers.
+    HandlePool<std::unique_ptr<JellyEngine>>& Engines() {
+        static HandlePool<std::unique_ptr<JellyEngine>> engines;
+        return engines;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Returns the engine of a handle, or nullptr (with a warning) if the handle is stale.
+    // -----------------------------------------------------------------------------
+    JellyEngine* ResolveEngine(JellyEngineHandle handle) {
+        auto engine = Engines().Get(handle);
+        if (!engine) {
+            JELLY_LOG(LogCategory::Engine, LogLevel::Warning, "Invalid engine handle {:x}", handle);
+            return nullptr;
+        }
+        return engine->get();
+    }
 }
 
 // -----------------------------------------------------------------------------
 // Creates and initializes a new JellyEngine instance.
-// Returns a handle to the engine or nullptr on failure.
+// Returns a handle to the engine or 0 on failure.
 // -----------------------------------------------------------------------------
-JELLY_API JellyEngineHandle jellyEngineInitialize(int width, int height, bool vsync, const char *title, const char *apiName) {
-    WindowSettings settings = {width, height, vsync, title};
+JELLY_API JellyEngineHandle jellyEngineInitialize(int width, int height, bool vsync, const char *title, const char *apiName,
+                                                  JellyInitFlags flags) {
+    WindowSettings settings = {width, height, vsync, title, (flags & JELLY_INIT_HEADLESS) != 0};
+    if (flags & JELLY_INIT_LOW_LATENCY) {
+        settings.framesInFlight = 1;
+    } else if (flags & JELLY_INIT_HIGH_THROUGHPUT) {
+        settings.framesInFlight = 3;
+    }
 
     GraphicsAPIType apiNameEnum;
     try
@@ -43,50 +70,159 @@ JELLY_API JellyEngineHandle jellyEngineInitialize(int width, int height, bool vs
     }
     catch (const std::exception& e)
     {
-        return nullptr;
+        return InvalidPoolHandle;
     }
 
-    auto engine = new JellyEngine();
+    auto engine = std::make_unique<JellyEngine>();
 
     if (!engine->Initialize(apiNameEnum, settings))
     {
-        delete engine;
-        return nullptr;
+        return InvalidPoolHandle;
     }
 
-    return engine;
+    return Engines().Create(std::move(engine));
 }
 
 // -----------------------------------------------------------------------------
 // Returns true if the engine is still running.
 // -----------------------------------------------------------------------------
 JELLY_API bool jellyEngineIsRunning(JellyEngineHandle handle) {
-    auto engine = static_cast<JellyEngine *>(handle);
-    return engine->IsRunning();
+    auto engine = ResolveEngine(handle);
+    return engine && engine->IsRunning();
 }
 
 // -----------------------------------------------------------------------------
 // Polls window and input events for the engine.
 // -----------------------------------------------------------------------------
-JELLY_API void jellyEnginePoll(JellyEngineHandle handle) {
-    auto engine = static_cast<JellyEngine *>(handle);
+JELLY_API const InputEvent* jellyEnginePoll(JellyEngineHandle handle, uint32_t* eventCount) {
+    auto engine = ResolveEngine(handle);
+    if (!engine) {
+        if (eventCount) {
+            *eventCount = 0;
+        }
+        return nullptr;
+    }
+
     engine->PollEvents();
+
+    const InputEventBuffer& events = engine->GetInputEvents();
+    if (eventCount) {
+        *eventCount = events.Size();
+    }
+    return events.Data();
 }
 
 // -----------------------------------------------------------------------------
-// Renders a single frame by beginning and ending the graphics API frame.
+// Renders a single frame, or queues it for the render thread.
 // -----------------------------------------------------------------------------
 JELLY_API void jellyEngineRender(JellyEngineHandle handle) {
-    auto engine = static_cast<JellyEngine *>(handle);
-    engine->Render();
+    if (auto engine = ResolveEngine(handle)) {
+        engine->Render();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Starts or stops the engine's render thread.
+// -----------------------------------------------------------------------------
+JELLY_API void jellyEngineSetRenderThread(JellyEngineHandle handle, bool enabled, uint32_t queueDepth) {
+    if (auto engine = ResolveEngine(handle)) {
+        engine->SetRenderThreadEnabled(enabled, queueDepth);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Polls events and renders a frame, reporting the engine state as status bits
+// along with the events of the poll.
+// -----------------------------------------------------------------------------
+JELLY_API JellyTickFlags jellyEngineTick(JellyEngineHandle handle, const InputEvent** events, uint32_t* eventCount) {
+    auto engine = ResolveEngine(handle);
+    bool rendered = false;
+    JellyTickFlags flags = engine && engine->Tick(&rendered) ? JELLY_TICK_RUNNING : 0;
+    if (rendered) {
+        flags |= JELLY_TICK_RENDERED;
+    }
+
+    const InputEventBuffer* input = engine ? &engine->GetInputEvents() : nullptr;
+    if (events) {
+        *events = input ? input->Data() : nullptr;
+    }
+    if (eventCount) {
+        *eventCount = input ? input->Size() : 0;
+    }
+    return flags;
+}
+
+// -----------------------------------------------------------------------------
+// Fills in the shared view of the engine's render command ring.
+// -----------------------------------------------------------------------------
+JELLY_API bool jellyEngineGetRenderCommandRing(JellyEngineHandle handle, RenderCommandRingView* view) {
+    auto engine = ResolveEngine(handle);
+    if (!engine || !view) {
+        return false;
+    }
+
+    engine->GetRenderCommands().Describe(*view);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Configures the simulation step and the frame limiter.
+// -----------------------------------------------------------------------------
+JELLY_API void jellyEngineSetFrameTiming(JellyEngineHandle handle, double fixedStepSeconds, double targetFps) {
+    if (auto engine = ResolveEngine(handle)) {
+        engine->SetFrameTiming(fixedStepSeconds, targetFps);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Returns the engine's frame timing block.
+// -----------------------------------------------------------------------------
+JELLY_API const FrameTiming* jellyEngineGetFrameTiming(JellyEngineHandle handle) {
+    auto engine = ResolveEngine(handle);
+    return engine ? &engine->GetFrameTiming() : nullptr;
+}
+
+// -----------------------------------------------------------------------------
+// Sets the present mode; unknown values select FIFO.
+// -----------------------------------------------------------------------------
+JELLY_API void jellyEngineSetPresentMode(JellyEngineHandle handle, JellyPresentMode mode, bool lowLatency) {
+    if (auto engine = ResolveEngine(handle)) {
+        engine->SetPresentMode(mode <= JELLY_PRESENT_IMMEDIATE ? static_cast<PresentMode>(mode) : PresentMode::Fifo,
+                               lowLatency);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Copies the engine's present statistics.
+// -----------------------------------------------------------------------------
+JELLY_API bool jellyEngineGetPresentStats(JellyEngineHandle handle, PresentStats* stats) {
+    auto engine = ResolveEngine(handle);
+    if (!engine || !stats) {
+        return false;
+    }
+
+    *stats = engine->GetPresentStats();
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Resizes the offscreen target of a headless engine.
+// -----------------------------------------------------------------------------
+JELLY_API bool jellyEngineResize(JellyEngineHandle handle, uint32_t width, uint32_t height) {
+    auto engine = ResolveEngine(handle);
+    return engine && engine->ResizeTarget(width, height);
 }
 
 // -----------------------------------------------------------------------------
 // Shuts down the engine and releases all associated resources.
-// The handle becomes invalid after this call.
+// The handle becomes invalid after this call; later calls with it are rejected.
 // -----------------------------------------------------------------------------
 JELLY_API void jellyEngineShutdown(JellyEngineHandle handle) {
-    auto engine = static_cast<JellyEngine *>(handle);
+    auto engine = ResolveEngine(handle);
+    if (!engine) {
+        return;
+    }
+
     engine->Shutdown();
-    delete engine;
+    Engines().Destroy(handle);
 }
@@ -2,21 +2,74 @@
 
 #include "JellyExport.h"
 #include "JellyTypes.h"
+#include "Core/FrameLoop.h"
+#include "Graphics/PresentMode.h"
+#include "Graphics/RenderCommand.h"
+#include "Window/InputEvent.h"
 
 JELLY_API_BEGIN
 
 // Creates and initializes a new JellyEngine instance.
-JELLY_API JellyEngineHandle jellyEngineInitialize(int width, int height, bool vsync, const char* title, const char* apiName);
+// flags is a combination of JELLY_INIT_* bits; JELLY_INIT_HEADLESS renders width x height
+// offscreen images without opening a window, JELLY_INIT_LOW_LATENCY / JELLY_INIT_HIGH_THROUGHPUT
+// keep one / three frames in flight instead of two.
+JELLY_API JellyEngineHandle jellyEngineInitialize(int width, int height, bool vsync, const char* title, const char* apiName,
+                                                  JellyInitFlags flags);
 
 // Checks if the engine is still running.
 JELLY_API bool jellyEngineIsRunning(JellyEngineHandle handle);
 
 // Polls input and window events.
-JELLY_API void jellyEnginePoll(JellyEngineHandle handle);
+// Returns the events received by this poll and stores their number in *eventCount.
+// The events stay valid until the next poll or tick.
+JELLY_API const InputEvent* jellyEnginePoll(JellyEngineHandle handle, uint32_t* eventCount);
 
 // Renders a single frame by beginning and ending the graphics API frame.
+// With the render thread enabled this queues the frame and returns; it only waits
+// when the render thread is a full queue depth behind.
 JELLY_API void jellyEngineRender(JellyEngineHandle handle);
 
+// Starts or stops the dedicated render thread. While enabled, the game thread builds the
+// next frame while the render thread records and submits the previous one; queueDepth
+// (at least 1, usually 2) bounds how many frames it may run ahead, including the one being
+// drawn. Call from the thread that drives the engine.
+JELLY_API void jellyEngineSetRenderThread(JellyEngineHandle handle, bool enabled, uint32_t queueDepth);
+
+// Polls events and renders one frame in a single call.
+// The polled input events are returned through events / eventCount (either may be null);
+// they stay valid until the next poll or tick.
+// Returns JELLY_TICK_* status bits; the loop should stop once JELLY_TICK_RUNNING is clear.
+JELLY_API JellyTickFlags jellyEngineTick(JellyEngineHandle handle, const InputEvent** events, uint32_t* eventCount);
+
+// Describes the engine's render command ring so managed code can write RenderCommands
+// directly into it. The view stays valid until jellyEngineShutdown; commands written to it
+// are executed by the next jellyEngineRender / jellyEngineTick.
+// Returns false if the handle or view is null.
+JELLY_API bool jellyEngineGetRenderCommandRing(JellyEngineHandle handle, RenderCommandRingView* view);
+
+// Sets the fixed simulation step (seconds; <= 0 keeps the current step) and the frame
+// rate jellyEngineTick is paced to (<= 0 disables the limiter).
+JELLY_API void jellyEngineSetFrameTiming(JellyEngineHandle handle, double fixedStepSeconds, double targetFps);
+
+// Returns the timing computed by the last tick: simulation steps to run, interpolation
+// alpha and frame delta. The pointer stays valid until jellyEngineShutdown, so callers can
+// read it after every tick without calling back in. Returns null for an invalid handle.
+JELLY_API const FrameTiming* jellyEngineGetFrameTiming(JellyEngineHandle handle);
+
+// Selects the present mode (JELLY_PRESENT_*); modes the display lacks fall back to the closest
+// supported one. With lowLatency, each poll first waits until the previous frame reached the
+// display (where VK_KHR_present_wait is available) and fewer images are queued. Takes
+// effect from the next frame.
+JELLY_API void jellyEngineSetPresentMode(JellyEngineHandle handle, JellyPresentMode mode, bool lowLatency);
+
+// Copies the measured present-to-present intervals into *stats.
+// Returns false if the handle or stats is null.
+JELLY_API bool jellyEngineGetPresentStats(JellyEngineHandle handle, PresentStats* stats);
+
+// Resizes the offscreen target of a headless engine (see JELLY_INIT_HEADLESS); the next
+// frame rebuilds it. Returns false for windowed engines, which follow their window.
+JELLY_API bool jellyEngineResize(JellyEngineHandle handle, uint32_t width, uint32_t height);
+
 // Shuts down the engine and releases all associated resources.
 JELLY_API void jellyEngineShutdown(JellyEngineHandle handle);
 
@@ -1,3 +1,45 @@
 #pragma once
 
-typedef void* JellyEngineHandle;
+#include <stdint.h>
+
+/// Generational handle of an engine instance (see HandlePool). 0 is never valid,
+/// and handles of destroyed engines are rejected rather than dereferenced.
+typedef uint64_t JellyEngineHandle;
+
+/// Status bits returned by jellyEngineTick.
+typedef uint32_t JellyTickFlags;
+
+/// The engine is still running; keep calling jellyEngineTick.
+#define JELLY_TICK_RUNNING  (1u << 0)
+
+/// A frame was rendered (or queued to the render thread) during this tick. Clear while the
+/// window is minimized or when the frame was dropped, e.g. for an out-of-date swapchain.
+#define JELLY_TICK_RENDERED (1u << 1)
+
+/// Options passed to jellyEngineInitialize.
+typedef uint32_t JellyInitFlags;
+
+/// Render into offscreen images instead of a window; needs no display.
+#define JELLY_INIT_HEADLESS (1u << 0)
+
+/// Keep one frame in flight: the GPU never runs behind, for the lowest input latency.
+#define JELLY_INIT_LOW_LATENCY (1u << 1)
+
+/// Keep three frames in flight so CPU spikes are absorbed, at the cost of latency.
+/// The default, without either flag, is two.
+#define JELLY_INIT_HIGH_THROUGHPUT (1u << 2)
+
+/// Present modes passed to jellyEngineSetPresentMode (values of PresentMode).
+typedef uint32_t JellyPresentMode;
+
+/// Vsync; never tears. The default when initialized with vsync.
+#define JELLY_PRESENT_FIFO         0u
+
+/// Vsync, but a late frame is shown at once and may tear.
+#define JELLY_PRESENT_FIFO_RELAXED 1u
+
+/// No tearing; a new frame replaces the queued one. The default without vsync.
+#define JELLY_PRESENT_MAILBOX      2u
+
+/// No vsync; lowest latency, may tear.
+#define JELLY_PRESENT_IMMEDIATE    3u
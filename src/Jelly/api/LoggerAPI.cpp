@@ -1,8 +1,33 @@
 #include "LoggerAPI.h"
 
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t) &&
+              std::atomic<std::uint32_t>::is_always_lock_free,
+              "Level masks are exposed to managed code as plain 32-bit integers");
+
 // -----------------------------------------------------------------------------
 // Logs a message using the engine's logging system.
 // -----------------------------------------------------------------------------
 JELLY_API void jellyLogMessage(LogLevel level, const char *message) {
-    Logger::Log(level, std::string(message));
+    Logger::Log(LogCategory::Managed, level, message);
+}
+
+// -----------------------------------------------------------------------------
+// Replaces the level mask of a category.
+// -----------------------------------------------------------------------------
+JELLY_API void jellyLogSetLevelMask(LogCategory category, uint32_t mask) {
+    Logger::SetLevelMask(category, mask);
+}
+
+// -----------------------------------------------------------------------------
+// Returns the level mask of a category.
+// -----------------------------------------------------------------------------
+JELLY_API uint32_t jellyLogGetLevelMask(LogCategory category) {
+    return Logger::GetLevelMask(category);
+}
+
+// -----------------------------------------------------------------------------
+// Returns the level mask array shared with managed code.
+// -----------------------------------------------------------------------------
+JELLY_API const uint32_t* jellyLogGetLevelMasks() {
+    return reinterpret_cast<const uint32_t*>(Logger::LevelMasks());
 }
@@ -1,14 +1,36 @@
 #pragma once
 
+#include <cstdint>
+
 #include "JellyExport.h"
 #include "Logger.h"
 
 JELLY_API_BEGIN
 
 /// Logs a message using the engine's logging system.
+/// The message is logged under LogCategory::Managed and dropped if that level is disabled.
 ///
 /// @param level The log severity (Info, Highlight, Warning, Error).
 /// @param message The message to log.
 JELLY_API void jellyLogMessage(LogLevel level, const char* message);
 
+/// Replaces the level mask of a category.
+///
+/// @param category The category to configure.
+/// @param mask Bit N enables LogLevel N (see LogLevelBit).
+JELLY_API void jellyLogSetLevelMask(LogCategory category, uint32_t mask);
+
+/// Returns the level mask of a category.
+///
+/// @param category The category to query.
+/// @return The current mask, or 0 for an unknown category.
+JELLY_API uint32_t jellyLogGetLevelMask(LogCategory category);
+
+/// Returns the level masks of every category, indexed by LogCategory.
+/// The array lives for the whole process, so managed code can keep the pointer and
+/// test a level with a plain memory read instead of calling into the engine.
+///
+/// @return Pointer to LogCategory::Count masks.
+JELLY_API const uint32_t* jellyLogGetLevelMasks();
+
 JELLY_API_END
@@ -0,0 +1,28 @@
+#include "ProfilerAPI.h"
+
+#include "Logger.h"
+#include "Profiling/Profiler.h"
+
+// -----------------------------------------------------------------------------
+// Starts or stops recording profiler zones.
+// -----------------------------------------------------------------------------
+JELLY_API void jellyProfilerSetEnabled(bool enabled) {
+    Profiler::SetEnabled(enabled);
+}
+
+// -----------------------------------------------------------------------------
+// Writes the last frames as a Chrome trace.
+// -----------------------------------------------------------------------------
+JELLY_API bool jellyProfilerDump(const char* path, uint32_t frames) {
+    if (!JELLY_ENABLE_PROFILER || !path) {
+        return false;
+    }
+
+    if (!Profiler::WriteChromeTrace(path, frames)) {
+        JELLY_LOG(LogCategory::Engine, LogLevel::Error, "Failed to write profiler trace {}", path);
+        return false;
+    }
+
+    JELLY_LOG(LogCategory::Engine, LogLevel::Info, "Profiler trace of {} frame(s) written to {}", frames, path);
+    return true;
+}
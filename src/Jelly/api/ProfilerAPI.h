@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+#include "JellyExport.h"
+
+JELLY_API_BEGIN
+
+/// Starts or stops recording profiler zones.
+///
+/// @param enabled True to record zones.
+JELLY_API void jellyProfilerSetEnabled(bool enabled);
+
+/// Writes the zones of the last frames as Chrome Trace Event JSON (opens in Perfetto).
+///
+/// @param path File to create or overwrite.
+/// @param frames Number of most recent frames to export.
+/// @return False if the profiler is compiled out or the file could not be written.
+JELLY_API bool jellyProfilerDump(const char* path, uint32_t frames);
+
+JELLY_API_END
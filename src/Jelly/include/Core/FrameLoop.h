@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+/// Timing of one frame, as computed by FrameLoop::BeginFrame.
+/// The layout is part of the C API and mirrored by Jelly.Assembly.FrameTiming.
+struct FrameTiming {
+    double        deltaSeconds;       ///< Wall time since the previous frame (clamped).
+    double        fixedStepSeconds;   ///< Length of one simulation step.
+    double        alpha;              ///< Fraction of a step left in the accumulator, for interpolation.
+    double        totalSeconds;       ///< Simulated time after this frame's steps.
+    std::uint64_t frameIndex;         ///< Number of frames begun before this one.
+    std::uint32_t fixedSteps;         ///< Simulation steps to run this frame.
+    std::uint32_t droppedSteps;       ///< Steps skipped because the frame hit the step cap.
+};
+
+static_assert(sizeof(FrameTiming) == 48, "FrameTiming is mirrored by managed code and must stay 48 bytes");
+
+/// Fixed-timestep clock: accumulates wall time and splits it into whole simulation steps,
+/// leaving the remainder as an interpolation alpha for rendering.
+class FrameLoop {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @param fixedStepSeconds Length of a simulation step.
+    /// @param maxStepsPerFrame Cap on steps per frame; extra time is dropped to avoid a spiral of death.
+    explicit FrameLoop(double fixedStepSeconds = 1.0 / 60.0, std::uint32_t maxStepsPerFrame = 8);
+
+    /// Changes the simulation step. Non-positive values are ignored.
+    void SetFixedStep(double fixedStepSeconds);
+
+    /// Measures the time since the previous call and computes this frame's steps and alpha.
+    const FrameTiming& BeginFrame();
+
+    /// Returns the timing of the current frame.
+    [[nodiscard]] const FrameTiming& GetTiming() const { return timing; }
+
+private:
+    /// Longest frame delta fed into the accumulator.
+    static constexpr double MaxDeltaSeconds = 0.25;
+
+    FrameTiming       timing{};
+    std::uint32_t     maxStepsPerFrame;
+    double            accumulator = 0.0;
+    std::uint64_t     framesBegun = 0;
+    Clock::time_point lastFrame{};
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <chrono>
+
+/// Frame rate limiter that hits frame deadlines with a hybrid sleep and spin.
+///
+/// OS sleeps overshoot by a platform-dependent amount, so the pacer sleeps only until
+/// a safety margin before the deadline and spins for the rest. The margin tracks the
+/// worst recent oversleep, which keeps deadline jitter well under 100 µs without
+/// burning a core for the whole frame.
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Sets the frame rate to pace to. 0 or less disables the limiter.
+    void SetTargetFps(double fps);
+
+    /// Returns the paced frame rate, or 0 if the limiter is disabled.
+    [[nodiscard]] double GetTargetFps() const { return targetFps; }
+
+    /// Blocks until the deadline of the current frame, then schedules the next one.
+    /// Frames that end more than one period late restart the schedule instead of bursting.
+    void WaitForNextFrame();
+
+private:
+    double             targetFps = 0.0;
+    Clock::duration    period{0};
+    Clock::time_point  deadline{};
+    Clock::duration    spinMargin = std::chrono::microseconds(1000); ///< Time left to the spin phase.
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// Opaque 64-bit resource handle: slot index in the low 32 bits, generation in the high 32 bits.
+/// Generations start at 1, so 0 is never a live handle.
+using PoolHandle = std::uint64_t;
+
+/// Handle value that never refers to a live object.
+constexpr PoolHandle InvalidPoolHandle = 0;
+
+/// Builds a handle from a slot index and generation.
+constexpr PoolHandle MakePoolHandle(std::uint32_t index, std::uint32_t generation) {
+    return (static_cast<PoolHandle>(generation) << 32) | index;
+}
+
+/// Returns the slot index of a handle.
+constexpr std::uint32_t PoolHandleIndex(PoolHandle handle) {
+    return static_cast<std::uint32_t>(handle);
+}
+
+/// Returns the generation of a handle.
+constexpr std::uint32_t PoolHandleGeneration(PoolHandle handle) {
+    return static_cast<std::uint32_t>(handle >> 32);
+}
+
+/// Generational object pool with dense storage.
+///
+/// Objects live contiguously in one array so iteration touches only live data; a separate
+/// slot array maps handle indices to dense positions and stores each slot's generation.
+/// Create and Destroy are O(1): destroyed slots go on a free list for reuse, the last dense
+/// object is moved into the hole, and the slot's generation is bumped so every handle that
+/// still points at it fails the lookup instead of aliasing the next occupant.
+template <typename T>
+class HandlePool {
+public:
+    /// Adds an object and returns its handle.
+    template <typename... Args>
+    PoolHandle Create(Args&&... args) {
+        std::uint32_t index;
+        if (freeHead != NoSlot) {
+            index    = freeHead;
+            freeHead = slots[index].dense;
+        } else {
+            index = static_cast<std::uint32_t>(slots.size());
+            slots.push_back({NoSlot, 1});
+        }
+
+        slots[index].dense = static_cast<std::uint32_t>(values.size());
+        values.emplace_back(std::forward<Args>(args)...);
+        owners.push_back(index);
+        return MakePoolHandle(index, slots[index].generation);
+    }
+
+    /// Removes the object of @p handle.
+    /// @return False if the handle is stale or invalid.
+    bool Destroy(PoolHandle handle) {
+        if (!IsValid(handle)) {
+            return false;
+        }
+
+        const std::uint32_t index = PoolHandleIndex(handle);
+        const std::uint32_t dense = slots[index].dense;
+        const std::uint32_t last  = static_cast<std::uint32_t>(values.size() - 1);
+        if (dense != last) {
+            values[dense] = std::move(values[last]);
+            owners[dense] = owners[last];
+            slots[owners[dense]].dense = dense;
+        }
+        values.pop_back();
+        owners.pop_back();
+
+        Slot& slot = slots[index];
+        slot.generation = slot.generation == UINT32_MAX ? 1 : slot.generation + 1;
+        slot.dense      = freeHead;
+        freeHead        = index;
+        return true;
+    }
+
+    /// Returns true if @p handle refers to a live object.
+    [[nodiscard]] bool IsValid(PoolHandle handle) const {
+        const std::uint32_t index = PoolHandleIndex(handle);
+        if (index >= slots.size() || slots[index].generation != PoolHandleGeneration(handle)) {
+            return false;
+        }
+
+        // A free slot already carries its next occupant's generation, and its dense field
+        // is the free-list link, so the slot must also be the owner of its dense position.
+        const std::uint32_t dense = slots[index].dense;
+        return dense < owners.size() && owners[dense] == index;
+    }
+
+    /// Returns the object of @p handle, or nullptr if the handle is stale or invalid.
+    /// The pointer is invalidated by the next Create or Destroy.
+    T* Get(PoolHandle handle) {
+        return IsValid(handle) ? &values[slots[PoolHandleIndex(handle)].dense] : nullptr;
+    }
+
+    const T* Get(PoolHandle handle) const {
+        return IsValid(handle) ? &values[slots[PoolHandleIndex(handle)].dense] : nullptr;
+    }
+
+    /// Returns the number of live objects.
+    [[nodiscard]] std::size_t Size() const { return values.size(); }
+
+    /// Live objects in dense order (not creation order).
+    T* begin() { return values.data(); }
+    T* end() { return values.data() + values.size(); }
+    const T* begin() const { return values.data(); }
+    const T* end() const { return values.data() + values.size(); }
+
+private:
+    static constexpr std::uint32_t NoSlot = UINT32_MAX;
+
+    struct Slot {
+        std::uint32_t dense;        ///< Dense position when live, next free slot otherwise.
+        std::uint32_t generation;   ///< Must match the handle's generation.
+    };
+
+    std::vector<T>             values;     ///< Live objects, densely packed.
+    std::vector<std::uint32_t> owners;     ///< Slot index of each dense object.
+    std::vector<Slot>          slots;      ///< Indexed by handle index.
+    std::uint32_t              freeHead = NoSlot;
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/// Bounded lock-free multi-producer / multi-consumer ring buffer.
+///
+/// Every cell carries a sequence number that tells producers and consumers whether
+/// it is free or holds data for the current lap, so a push or pop costs a single
+/// CAS on the shared cursor plus one release store on the cell.
+/// Elements are written and read in place through callbacks to avoid copying large records.
+template <typename T>
+class MpmcRingBuffer {
+public:
+    /// Creates a ring with room for @p capacity elements (rounded up to a power of two).
+    explicit MpmcRingBuffer(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+
+        mask  = size - 1;
+        cells = std::make_unique<Cell[]>(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcRingBuffer(const MpmcRingBuffer&) = delete;
+    MpmcRingBuffer& operator=(const MpmcRingBuffer&) = delete;
+
+    /// Claims a free cell and lets @p fill write the element into it.
+    /// @return False if the ring is full.
+    template <typename Fill>
+    bool TryPush(Fill&& fill) {
+        std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    fill(cell.data);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Takes the oldest element and hands it to @p consume before releasing the cell.
+    /// @return False if the ring is empty.
+    template <typename Consume>
+    bool TryPop(Consume&& consume) {
+        std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    consume(cell.data);
+                    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Number of elements the ring can hold.
+    [[nodiscard]] std::size_t Capacity() const { return mask + 1; }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<std::size_t> sequence{0};
+        T data{};
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    std::size_t mask = 0;
+
+    alignas(64) std::atomic<std::size_t> enqueuePos{0}; ///< Next cell a producer will claim.
+    alignas(64) std::atomic<std::size_t> dequeuePos{0}; ///< Next cell a consumer will read.
+};
@@ -9,6 +9,6 @@
 class GraphicsApiException final : public std::runtime_error {
 public:
     explicit GraphicsApiException(const std::string& msg) : std::runtime_error(msg) {
-        Logger::Log(LogLevel::Error, msg);
+        Logger::Log(LogCategory::Vulkan, LogLevel::Error, msg);
     }
 };
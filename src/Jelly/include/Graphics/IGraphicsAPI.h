@@ -1,6 +1,11 @@
 #pragma once
 
+#include <cstdint>
+
+#include "Graphics/PresentMode.h"
+
 class IWindowSystem; 
+class JobSystem;
 
 /// Base interface for graphics APIs (e.g., Vulkan, OpenGL).
 class IGraphicsAPI {
@@ -12,10 +17,49 @@ public:
 
     virtual void Initialize(IWindowSystem* window) { Initialize(); } 
 
+    /// Gives the API worker threads to record commands on. Call before Initialize.
+    /// @param jobs Job system that outlives the API; null records on the calling thread.
+    virtual void SetJobSystem(JobSystem* jobs) {}
+
+    /// Sets how many frames the CPU may record ahead of the GPU: 1 for the lowest latency,
+    /// 3 for throughput. Call before Initialize; APIs clamp it to what they support.
+    virtual void SetFramesInFlight(uint32_t count) {}
+
+    /// Sets the color following frames are cleared to.
+    /// @param color RGBA, 0..1.
+    virtual void SetClearColor(const float color[4]) {}
+
+    /// Queues a solid rectangle for the next frame, drawn after the clear.
+    /// @param x, y Top-left corner in framebuffer pixels.
+    /// @param width, height Size in pixels.
+    /// @param color RGBA, 0..1.
+    virtual void DrawRect(float x, float y, float width, float height, const float color[4]) {}
+
+    /// Selects how frames are presented. Modes the display does not support fall back to the
+    /// closest one (FIFO, which is always available, last). Takes effect from the next frame.
+    /// Safe to call from any thread.
+    /// @param lowLatency Wait for the previous frame to reach the display in WaitForPresent,
+    ///                   where the API can tell, and keep fewer images queued.
+    virtual void SetPresentMode(PresentMode mode, bool lowLatency) {}
+
+    /// In low-latency mode, blocks until the previously presented frame reached the display,
+    /// so the next frame starts from the freshest input. Call on the rendering thread right
+    /// before sampling input; returns at once when the mode is off or unsupported.
+    virtual void WaitForPresent() {}
+
+    /// Returns the measured intervals between presents. Safe to call from any thread.
+    virtual PresentStats GetPresentStats() const { return {}; }
+
+    /// Tells the API the render target changed size; the next frame rebuilds its targets.
+    /// Safe to call from any thread.
+    virtual void NotifyResized() {}
+
     /// Begins rendering a new frame.
-    virtual void BeginFrame() = 0;
+    /// @return False if no frame can be rendered right now (e.g. the window is minimized);
+    ///         EndFrame must then be skipped. Never blocks waiting for the window to return.
+    virtual bool BeginFrame() = 0;
 
-    /// Ends rendering of the current frame.
+    /// Ends rendering of the current frame. Only called after BeginFrame returned true.
     virtual void EndFrame() = 0;
 
     virtual void Shutdown() = 0;
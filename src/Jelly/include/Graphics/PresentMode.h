@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+/// How finished frames reach the screen. Values match the JELLY_PRESENT_* constants.
+enum class PresentMode : std::uint32_t {
+    Fifo        = 0,   ///< Vsync: frames wait for the vertical blank and never tear.
+    FifoRelaxed = 1,   ///< Vsync, but a frame that missed the blank is shown at once and may tear.
+    Mailbox     = 2,   ///< No tearing; a new frame replaces the one waiting for the blank.
+    Immediate   = 3,   ///< No vsync: lowest latency, may tear.
+};
+
+/// Measured presentation pacing, as returned by IGraphicsAPI::GetPresentStats.
+/// The layout is part of the C API and mirrored by Jelly.Assembly.PresentStats.
+struct PresentStats {
+    double        lastIntervalSeconds;      ///< Time between the last two presents.
+    double        averageIntervalSeconds;   ///< Moving average of the interval.
+    std::uint64_t presentCount;             ///< Presents measured so far.
+    std::uint32_t mode;                     ///< PresentMode in use, after fallback.
+    std::uint32_t onDisplay;                ///< 1 if measured when frames reached the display, 0 if when they were queued.
+};
+
+static_assert(sizeof(PresentStats) == 32, "PresentStats is mirrored by managed code and must stay 32 bytes");
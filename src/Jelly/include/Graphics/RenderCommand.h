@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+/// Kind of a RenderCommand. Values are shared with managed code.
+enum class RenderCommandType : std::uint32_t {
+    None         = 0,   ///< Empty slot; ignored.
+    ClearColor   = 1,   ///< Sets the color the frame is cleared to.
+    SetTransform = 2,   ///< Sets the 2D transform applied to the following sprites.
+    DrawSprite   = 3    ///< Draws a sprite through the current transform.
+};
+
+/// Payload of RenderCommandType::ClearColor.
+struct ClearColorCommand {
+    float color[4];     ///< RGBA, 0..1.
+};
+
+/// Payload of RenderCommandType::SetTransform: the affine matrix
+/// | m[0] m[2] m[4] |
+/// | m[1] m[3] m[5] |
+/// applied to sprite corners, in pixels. Reset to identity at the start of every frame.
+struct SetTransformCommand {
+    float m[6];
+};
+
+/// Payload of RenderCommandType::DrawSprite.
+struct DrawSpriteCommand {
+    float         x, y;            ///< Top-left corner before the transform.
+    float         width, height;   ///< Size before the transform.
+    float         color[4];        ///< RGBA tint, 0..1.
+    std::uint32_t texture;         ///< Texture id; 0 draws a solid quad.
+};
+
+/// Fixed-size command written by managed code into the render command ring.
+/// The layout is part of the C API and mirrored by Jelly.Assembly.RenderCommand.
+struct RenderCommand {
+    RenderCommandType type;
+    std::uint32_t     reserved;
+    union {
+        ClearColorCommand   clearColor;
+        SetTransformCommand setTransform;
+        DrawSpriteCommand   drawSprite;
+        std::uint8_t        payload[56];
+    };
+};
+
+static_assert(sizeof(RenderCommand) == 64, "RenderCommand is mirrored by managed code and must stay 64 bytes");
+
+/// Shared view of an engine's render command ring, handed to managed code once.
+///
+/// The producer writes commands into slots [*writeIndex, *readIndex + capacity), then
+/// publishes them with a release store to *writeIndex. The engine consumes every published
+/// command once per frame and advances *readIndex. Indices grow without bound and wrap at
+/// 2^32; the slot of index i is commands[i & (capacity - 1)].
+struct RenderCommandRingView {
+    RenderCommand*       commands;     ///< capacity slots, valid until the engine shuts down.
+    std::uint32_t        capacity;     ///< Number of slots (a power of two).
+    std::uint32_t        reserved;
+    std::uint32_t*       writeIndex;   ///< Written by the producer.
+    const std::uint32_t* readIndex;    ///< Written by the engine.
+};
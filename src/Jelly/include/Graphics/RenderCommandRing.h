@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "Graphics/RenderCommand.h"
+
+/// Single-producer / single-consumer ring of RenderCommands in engine-owned memory.
+///
+/// The storage never moves, so managed code receives its address once (see Describe) and
+/// writes commands straight into it. The only shared state is a pair of cache-line
+/// separated indices, which keeps a whole frame of commands down to one interop transition.
+class RenderCommandRing {
+public:
+    /// Default number of command slots (1 MiB of commands).
+    static constexpr std::uint32_t DefaultCapacity = 16384;
+
+    /// Creates a ring with room for @p capacity commands (rounded up to a power of two).
+    explicit RenderCommandRing(std::uint32_t capacity = DefaultCapacity);
+
+    RenderCommandRing(const RenderCommandRing&) = delete;
+    RenderCommandRing& operator=(const RenderCommandRing&) = delete;
+
+    /// Appends a command from native code and publishes it immediately.
+    /// @return False if the ring is full.
+    bool TryPush(const RenderCommand& command);
+
+    /// Hands every published command to @p consume in order, then frees their slots.
+    /// @return The number of commands consumed.
+    template <typename Consume>
+    std::size_t ConsumeAll(Consume&& consume) {
+        const std::uint32_t read  = readIndex.load(std::memory_order_relaxed);
+        const std::uint32_t write = writeIndex.load(std::memory_order_acquire);
+
+        for (std::uint32_t i = read; i != write; ++i) {
+            consume(static_cast<const RenderCommand&>(commands[i & mask]));
+        }
+
+        readIndex.store(write, std::memory_order_release);
+        return write - read;
+    }
+
+    /// Fills @p view with the addresses managed code needs to produce commands.
+    void Describe(RenderCommandRingView& view);
+
+private:
+    std::unique_ptr<RenderCommand[]> commands;
+    std::uint32_t capacity = 0;
+    std::uint32_t mask     = 0;
+
+    alignas(64) std::atomic<std::uint32_t> writeIndex{0};
+    alignas(64) std::atomic<std::uint32_t> readIndex{0};
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "Graphics/RenderCommand.h"
+
+/// Everything the render thread needs to draw one frame.
+struct RenderPacket {
+    std::vector<RenderCommand> commands;   ///< Commands drained from the ring, in order.
+    std::uint64_t              frameIndex = 0;
+};
+
+/// Bounded single-producer / single-consumer queue of render packets.
+///
+/// The game thread fills packet N+1 while the render thread draws packet N. Packets are
+/// recycled, so their command vectors stop allocating once they reach a frame's size.
+/// The producer only blocks when the render thread is a full queue depth behind.
+class RenderPacketQueue {
+public:
+    /// @param depth Packets in the queue, including the one being drawn (at least 1).
+    explicit RenderPacketQueue(std::uint32_t depth);
+
+    RenderPacketQueue(const RenderPacketQueue&) = delete;
+    RenderPacketQueue& operator=(const RenderPacketQueue&) = delete;
+
+    /// Returns the next packet to fill, waiting while every packet is queued or drawing.
+    /// @return nullptr once the queue is closed.
+    RenderPacket* BeginWrite();
+
+    /// Hands the packet from BeginWrite to the render thread.
+    void EndWrite();
+
+    /// Returns the oldest submitted packet, waiting until one arrives.
+    /// @return nullptr once the queue is closed.
+    RenderPacket* BeginRead();
+
+    /// Returns the packet from BeginRead to the producer.
+    void EndRead();
+
+    /// Wakes both sides and makes every later Begin call return nullptr.
+    void Close();
+
+    /// Returns the number of packets in the queue.
+    [[nodiscard]] std::uint32_t GetDepth() const { return static_cast<std::uint32_t>(packets.size()); }
+
+private:
+    std::vector<RenderPacket> packets;
+    std::uint64_t             written = 0;   ///< Packets submitted by the producer.
+    std::uint64_t             read    = 0;   ///< Packets released by the consumer.
+    bool                      closed  = false;
+
+    std::mutex                mutex;
+    std::condition_variable   writable;
+    std::condition_variable   readable;
+};
@@ -11,7 +11,14 @@ struct QueueFamilyIndices {
     /// Index of a queue family that supports presentation to a surface.
     std::optional<std::uint32_t> presentFamily;
 
+    /// Index of a transfer-only queue family (DMA engine), if the device has one.
+    std::optional<std::uint32_t> transferFamily;
+
+    /// Index of a compute queue family without graphics support, if the device has one.
+    std::optional<std::uint32_t> computeFamily;
+
     /// Returns true if both graphics and presentation queue families are found.
+    /// Transfer and compute families are optional.
     [[nodiscard]] bool IsComplete() const {
         return graphicsFamily.has_value() && presentFamily.has_value();
     }
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+class JobSystem;
+
+/// Records secondary command buffers in parallel on the job system.
+///
+/// Every frame in flight owns one VkCommandPool per recording slot. A Record call splits
+/// its items into at most one slice per slot and each slice is recorded by a single job
+/// into a buffer from its own pool, so pools never need locking. The buffers come back in
+/// slice order, ready for vkCmdExecuteCommands inside the render pass they inherit.
+class VulkanCommandRecorder {
+public:
+    /// Records items [begin, end) into @p commandBuffer, which is already begun.
+    using RecordFunction = void (*)(void* context, VkCommandBuffer commandBuffer, std::uint32_t begin, std::uint32_t end);
+
+    /// Creates the command pools.
+    /// @param framesInFlight Number of frames whose buffers may be pending on the GPU at once.
+    /// @param slots Maximum number of slices recorded in parallel, usually the job thread count.
+    void Create(VkDevice device, std::uint32_t queueFamily, std::uint32_t framesInFlight, std::uint32_t slots);
+
+    /// Destroys the command pools and every buffer allocated from them.
+    void Destroy();
+
+    /// Resets the pools of @p frame. Call once the GPU finished the frame's previous submission.
+    void ResetFrame(std::uint32_t frame);
+
+    /// Records @p count items as secondary command buffers for @p frame.
+    /// @param jobs Job system to record on; null records every slice on the calling thread.
+    /// @param inheritance Render pass, subpass and framebuffer the buffers execute in, or the
+    ///                    attachment formats chained in pNext for dynamic rendering.
+    /// @param minItemsPerSlice Smallest slice worth handing to another thread.
+    /// @return Buffers to execute, in item order; valid until the frame is reset.
+    const std::vector<VkCommandBuffer>& Record(JobSystem* jobs, std::uint32_t frame,
+                                               const VkCommandBufferInheritanceInfo& inheritance,
+                                               std::uint32_t count, std::uint32_t minItemsPerSlice,
+                                               RecordFunction function, void* context);
+
+    /// Returns the number of slices a Record call can use.
+    [[nodiscard]] std::uint32_t GetSlotCount() const { return slotCount; }
+
+private:
+    /// Pool of one recording slot in one frame, with the buffers allocated from it so far.
+    struct SlotPool {
+        VkCommandPool                pool = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer> buffers;
+        std::uint32_t                used = 0;
+    };
+
+    SlotPool& Slot(std::uint32_t frame, std::uint32_t slot) { return pools[frame * slotCount + slot]; }
+    VkCommandBuffer Acquire(SlotPool& slot);
+
+    VkDevice                     device    = VK_NULL_HANDLE;
+    std::uint32_t                slotCount = 0;
+    std::vector<SlotPool>        pools;     ///< framesInFlight x slotCount, frame-major.
+    std::vector<VkCommandBuffer> recorded;  ///< Buffers returned by the last Record call.
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "QueueFamilyIndices.h"
+
+#include <cstring>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+/// Snapshot of the chosen physical device, queried once after device selection so the
+/// backend never re-enumerates properties, features or queue families.
+struct VulkanDeviceCapabilities {
+    VkPhysicalDeviceProperties           properties{};
+    VkPhysicalDeviceFeatures             features{};
+    VkPhysicalDeviceMemoryProperties     memoryProperties{};
+    std::vector<VkQueueFamilyProperties> queueFamilyProperties;
+    std::vector<VkExtensionProperties>   extensions;
+
+    /// Queue families picked for graphics, present, transfer and compute work.
+    QueueFamilyIndices queueFamilies;
+
+    /// Returns true if the device supports the extension @p name.
+    [[nodiscard]] bool HasExtension(const char* name) const {
+        for (const VkExtensionProperties& extension : extensions) {
+            if (std::strcmp(extension.extensionName, name) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
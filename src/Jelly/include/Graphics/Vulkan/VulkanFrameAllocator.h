@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "VulkanDeviceCapabilities.h"
+#include "VulkanMemoryAllocator.h"
+
+#include "vulkan/vulkan.h"
+
+/// Range handed out by VulkanFrameAllocator. It stays valid until the frame slot it was
+/// allocated in comes around again.
+struct VulkanFrameAllocation {
+    void*         data   = nullptr;          ///< Write-only host pointer; null if the frame ran out of space.
+    VkBuffer      buffer = VK_NULL_HANDLE;
+    std::uint32_t offset = 0;                ///< Offset into buffer; bind it as the dynamic offset.
+    VkDeviceSize  size   = 0;
+};
+
+/// Linear allocator for data rewritten every frame: uniforms, push-constant overflow and
+/// instance data.
+///
+/// One persistently mapped buffer is split into a segment per frame in flight. Allocate
+/// bumps a pointer through the current frame's segment, so frames never create buffers or
+/// map memory. BeginFrame, called once the frame's fence has signalled, rewinds that
+/// segment wholesale since the GPU is done with everything in it. On non-coherent memory
+/// Flush writes back only the part of the segment the frame used.
+///
+/// The buffer is usable as a uniform, storage, vertex and index buffer; bind it once with
+/// a dynamic descriptor and pass offsets per draw. Allocate is lock-free and may be called
+/// from recording jobs; BeginFrame and Flush run on the render thread.
+class VulkanFrameAllocator {
+public:
+    static constexpr VkDeviceSize DefaultFrameSize = VkDeviceSize(4) << 20;
+
+    /// Creates the buffer with @p frameCount segments of @p frameSize bytes.
+    void Create(VkDevice device, VulkanMemoryAllocator& allocator, const VulkanDeviceCapabilities& capabilities,
+                std::uint32_t frameCount, VkDeviceSize frameSize = DefaultFrameSize);
+
+    /// Releases the buffer; the GPU must be done with every frame.
+    void Destroy();
+
+    /// Rewinds the segment of @p frame. Call once the GPU finished the frame that last used it.
+    void BeginFrame(std::uint32_t frame);
+
+    /// Carves @p size bytes out of the current frame.
+    /// @param alignment Power of two; 0 uses the larger of the uniform and storage buffer
+    ///                  offset alignments, which suits any dynamic descriptor.
+    /// @return The range, with null data once the frame is full.
+    VulkanFrameAllocation Allocate(VkDeviceSize size, VkDeviceSize alignment = 0);
+
+    /// Makes the current frame's writes visible to the device. Call before submitting it.
+    void Flush();
+
+    [[nodiscard]] VkBuffer GetBuffer() const { return buffer; }
+    [[nodiscard]] VkDeviceSize GetFrameSize() const { return frameSize; }
+
+    /// Returns the bytes allocated in the current frame so far.
+    [[nodiscard]] VkDeviceSize GetUsedBytes() const {
+        return head.load(std::memory_order_relaxed) - frameStart;
+    }
+
+private:
+    VkDevice               device    = VK_NULL_HANDLE;
+    VulkanMemoryAllocator* allocator = nullptr;
+    VkBuffer               buffer    = VK_NULL_HANDLE;
+    VulkanAllocation*      memory    = nullptr;
+    std::uint8_t*          mapped    = nullptr;
+    bool                   coherent  = true;
+    VkDeviceSize           atomSize  = 1;
+    VkDeviceSize           defaultAlignment = 1;
+    VkDeviceSize           frameSize  = 0;
+    std::uint32_t          frameCount = 0;
+
+    VkDeviceSize              frameStart = 0;       ///< Buffer offset of the current segment.
+    std::atomic<VkDeviceSize> head{0};              ///< Next free buffer offset.
+    std::atomic<bool>         exhausted{false};     ///< Set once per frame when Allocate fails.
+};
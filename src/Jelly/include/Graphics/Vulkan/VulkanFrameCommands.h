@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+/// Primary command buffers for the frames in flight.
+///
+/// Every frame in flight owns a transient VkCommandPool that is reset in one
+/// vkResetCommandPool call once the frame's fence signals; buffers are handed out
+/// linearly from it and reused after the reset, so no buffer is ever reset or freed
+/// on its own.
+///
+/// Passes whose commands rarely change can instead keep pre-recorded buffers in a
+/// static cache. Each frame in flight has its own copy, so a cached buffer is never
+/// pending twice, and a copy is re-recorded the next time its frame asks for it after
+/// Invalidate. Everything runs on the render thread.
+class VulkanFrameCommands {
+public:
+    /// Records a cached pass into @p commandBuffer, which is already begun.
+    using RecordFunction = void (*)(void* context, VkCommandBuffer commandBuffer);
+
+    /// Creates the command pools.
+    /// @param framesInFlight Number of frames whose buffers may be pending on the GPU at once.
+    void Create(VkDevice device, std::uint32_t queueFamily, std::uint32_t framesInFlight);
+
+    /// Destroys the command pools and every buffer allocated from them.
+    void Destroy();
+
+    /// Resets the pool of @p frame. Call once the GPU finished the frame's previous submission.
+    void ResetFrame(std::uint32_t frame);
+
+    /// Returns the next unused primary buffer of @p frame, not yet begun.
+    VkCommandBuffer Allocate(std::uint32_t frame);
+
+    /// Returns the cached buffer of @p key for @p frame, recording it with @p function when it
+    /// is missing or was invalidated. Only submit it with @p frame's work.
+    /// @param inheritance Required for secondary buffers, ignored for primary ones.
+    VkCommandBuffer GetStatic(std::uint32_t frame, std::uint64_t key, VkCommandBufferLevel level,
+                              const VkCommandBufferInheritanceInfo* inheritance,
+                              RecordFunction function, void* context);
+
+    /// Marks the cached buffers of @p key as stale; each frame re-records its copy on next use.
+    void Invalidate(std::uint64_t key);
+
+    /// Marks every cached buffer as stale, e.g. after the framebuffers were rebuilt.
+    void InvalidateAll();
+
+private:
+    /// Transient pool of one frame, with the buffers allocated from it so far.
+    struct FramePool {
+        VkCommandPool                pool = VK_NULL_HANDLE;
+        VkCommandPool                staticPool = VK_NULL_HANDLE;   ///< Holds the frame's cached buffers.
+        std::vector<VkCommandBuffer> buffers;
+        std::uint32_t                used = 0;
+    };
+
+    /// One cached pass: when it was last invalidated and a copy per frame.
+    struct StaticEntry {
+        std::uint64_t                invalidated = 0;
+        std::vector<VkCommandBuffer> buffers;    ///< Per frame; null until first recorded.
+        std::vector<std::uint64_t>   recorded;   ///< Version each copy was recorded at.
+    };
+
+    VkDevice               device = VK_NULL_HANDLE;
+    std::vector<FramePool> frames;
+    std::unordered_map<std::uint64_t, StaticEntry> statics;
+    std::uint64_t          version = 0;              ///< Advanced by every invalidation.
+    std::uint64_t          invalidatedAll = 0;       ///< Version of the last InvalidateAll.
+};
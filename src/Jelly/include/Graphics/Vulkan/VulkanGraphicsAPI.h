@@ -2,10 +2,22 @@
 
 #include "QueueFamilyIndices.h"
 #include "SwapChainSupportDetails.h"
+#include "VulkanCommandRecorder.h"
+#include "VulkanDeviceCapabilities.h"
+#include "VulkanFrameAllocator.h"
+#include "VulkanFrameCommands.h"
+#include "VulkanMemoryAllocator.h"
+#include "VulkanPipelineCache.h"
+#include "VulkanPipelineManager.h"
+#include "VulkanQueueSubmission.h"
+#include "VulkanUploader.h"
 #include "Graphics/IGraphicsAPI.h"
 #include "Window/INativeWindowHandleProvider.h"
 
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <mutex>
 #include <vector>
 #include <set>
 
@@ -13,24 +25,147 @@
 
 class VulkanGraphicsAPI final : public IGraphicsAPI {
 public:
+    static constexpr uint32_t DefaultFramesInFlight = 2;
+    static constexpr uint32_t MaxFramesInFlight     = 3;
+
     void Initialize() override;
     void Initialize(IWindowSystem* windowSystem) override;
-    void BeginFrame() override;
+    bool BeginFrame() override;
     void EndFrame() override;
     void Shutdown() override;
+    void SetJobSystem(JobSystem* jobs) override;
+    void SetFramesInFlight(uint32_t count) override;
+    void SetPresentMode(PresentMode mode, bool lowLatency) override;
+    void WaitForPresent() override;
+    PresentStats GetPresentStats() const override;
+    void NotifyResized() override;
+    void SetClearColor(const float color[4]) override;
+    void DrawRect(float x, float y, float width, float height, const float color[4]) override;
+
+    /// Pipelines compiled in the background against the persistent cache.
+    VulkanPipelineManager& GetPipelines() { return pipelines; }
+
+    /// Render pass every frame is drawn in; pipelines are built against it. VK_NULL_HANDLE
+    /// with dynamic rendering.
+    [[nodiscard]] VkRenderPass GetRenderPass() const { return renderPass; }
+
+    /// Returns true if frames bind their attachments at record time (Vulkan 1.3 or
+    /// VK_KHR_dynamic_rendering) instead of using a render pass and framebuffers. Pipelines
+    /// then target GetColorFormat through PipelineDesc::colorFormat.
+    [[nodiscard]] bool HasDynamicRendering() const { return dynamicRendering; }
+
+    /// Format of the images frames are drawn into.
+    [[nodiscard]] VkFormat GetColorFormat() const { return swapchainImageFormat; }
+
+    /// Device snapshot taken when the GPU was selected.
+    [[nodiscard]] const VulkanDeviceCapabilities& GetCapabilities() const { return capabilities; }
+
+    /// Returns the queue family that runs @p type work.
+    [[nodiscard]] uint32_t GetQueueFamily(VulkanQueueType type) const { return queues[static_cast<size_t>(type)].family; }
+
+    /// Returns true if @p type work runs on its own queue rather than the graphics queue.
+    [[nodiscard]] bool HasDedicatedQueue(VulkanQueueType type) const;
+
+    /// Distinct families of every queue, for resources created with VK_SHARING_MODE_CONCURRENT
+    /// so they can be used across queues without ownership transfers.
+    [[nodiscard]] const std::vector<uint32_t>& GetQueueFamilies() const { return uniqueQueueFamilies; }
+
+    [[nodiscard]] VkDevice GetDevice() const { return device; }
+
+    /// Device memory sub-allocator shared by every buffer and image.
+    VulkanMemoryAllocator& GetMemoryAllocator() { return memoryAllocator; }
+
+    /// Per-frame linear allocator for uniforms and instance data, rewound every frame.
+    VulkanFrameAllocator& GetFrameAllocator() { return frameAllocator; }
+
+    /// Per-frame command pools, including the cache of pre-recorded static passes.
+    VulkanFrameCommands& GetFrameCommands() { return frameCommands; }
+
+    /// Staging ring that streams buffer and image data on the transfer queue.
+    VulkanUploader& GetUploader() { return uploader; }
+
+    /// Number of frames the CPU may record ahead of the GPU.
+    [[nodiscard]] uint32_t GetFramesInFlight() const { return framesInFlight; }
+
+    /// Number of the frame being recorded. Frames are numbered from 1 and never reused, so a
+    /// resource the GPU may read during this frame can be released once IsFrameComplete
+    /// returns true for this number.
+    [[nodiscard]] uint64_t GetFrameNumber() const { return submittedFrames.load(std::memory_order_acquire) + 1; }
+
+    /// Returns the newest frame the GPU has finished, without blocking. Safe to call from any
+    /// thread; without timeline semaphores the value is refreshed once per BeginFrame.
+    [[nodiscard]] uint64_t GetCompletedFrame() const;
+
+    /// Returns true once the GPU has finished frame @p frame. Never blocks.
+    [[nodiscard]] bool IsFrameComplete(uint64_t frame) const { return frame <= GetCompletedFrame(); }
+
+    /// Blocks until the GPU has finished frame @p frame; returns at once for frames not yet
+    /// submitted. Call from the render thread.
+    void WaitForFrame(uint64_t frame);
+
+    /// Returns true if timeline semaphores (VK_KHR_timeline_semaphore) are enabled.
+    [[nodiscard]] bool HasTimelineSemaphores() const { return timelineSemaphores; }
+
+    /// Returns the value a timeline semaphore has reached. Requires HasTimelineSemaphores.
+    [[nodiscard]] uint64_t GetSemaphoreCounterValue(VkSemaphore semaphore) const;
+
+    /// Submits a batch to the queue of @p type. Safe to call from any thread; queues shared by
+    /// several types are locked together.
+    VkResult Submit(VulkanQueueType type, const VulkanQueueSubmission& submission);
 
 private:
     // Window system
+    IWindowSystem*               windowSystem   = nullptr;
     INativeWindowHandleProvider* windowProvider = nullptr;
 
+    // Without a native window the swapchain is replaced by an offscreen image ring
+    bool                           headless = false;
+    std::vector<VulkanAllocation*> offscreenMemory;
+
+    // Worker threads for parallel recording (may be null)
+    JobSystem* jobSystem = nullptr;
+
     // Vulkan instance and device
     VkInstance       instance       = VK_NULL_HANDLE;
     VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
     VkDevice         device         = VK_NULL_HANDLE;
 
-    // Queues
-    VkQueue graphicsQueue = VK_NULL_HANDLE;
-    VkQueue presentQueue  = VK_NULL_HANDLE;
+    // Device snapshot, queried once in PickPhysicalDevice
+    VulkanDeviceCapabilities capabilities;
+
+    // Optional features enabled on the device
+    uint32_t                          instanceApiVersion        = VK_API_VERSION_1_0;   ///< Requested at instance creation.
+    bool                              physicalDeviceProperties2 = false;
+    bool                              timelineSemaphores        = false;
+    PFN_vkGetSemaphoreCounterValueKHR getSemaphoreCounterValue  = nullptr;
+    PFN_vkWaitSemaphoresKHR           waitSemaphores            = nullptr;
+    bool                              presentWait               = false;   ///< VK_KHR_present_id + VK_KHR_present_wait.
+    PFN_vkWaitForPresentKHR           waitForPresent            = nullptr;
+    bool                              dynamicRendering          = false;   ///< Core in 1.3, or VK_KHR_dynamic_rendering.
+    PFN_vkCmdBeginRenderingKHR        cmdBeginRendering         = nullptr;
+    PFN_vkCmdEndRenderingKHR          cmdEndRendering           = nullptr;
+
+    // Queues, indexed by VulkanQueueType; types without a dedicated family share the graphics queue
+    struct QueueSlot {
+        VkQueue     queue  = VK_NULL_HANDLE;
+        uint32_t    family = 0;
+        std::mutex* lock   = nullptr;   ///< Shared by every slot on the same VkQueue.
+    };
+    QueueSlot             queues[static_cast<size_t>(VulkanQueueType::Count)];
+    std::mutex            queueLocks[static_cast<size_t>(VulkanQueueType::Count) + 1];
+    std::vector<uint32_t> uniqueQueueFamilies;
+    VkQueue               graphicsQueue = VK_NULL_HANDLE;
+    VkQueue               presentQueue  = VK_NULL_HANDLE;
+    std::mutex*           presentLock   = nullptr;
+
+    // Device memory, carved out of large blocks per memory type
+    VulkanMemoryAllocator memoryAllocator;
+
+    // Per-frame constants and instance data, one segment per frame in flight
+    VulkanFrameAllocator frameAllocator;
+
+    // Staging uploads, flushed once per frame
+    VulkanUploader uploader;
 
     // Surface and swapchain
     VkSurfaceKHR     surface            = VK_NULL_HANDLE;
@@ -40,44 +175,105 @@ private:
     std::vector<VkImage>     swapchainImages;
     std::vector<VkImageView> swapchainImageViews;
 
-    // Render pass and framebuffers
+    // Present policy, requested from any thread and applied when the swapchain is rebuilt
+    std::atomic<PresentMode> requestedPresentMode{PresentMode::Fifo};
+    std::atomic<bool>        requestedLowLatency{false};
+    std::atomic<bool>        presentModeChanged{false};   ///< Set by SetPresentMode, cleared by CreateSwapChain.
+    PresentMode              activePresentMode = PresentMode::Fifo;
+    bool                     lowLatency        = false;
+
+    // Present ids are only waited on for the swapchain they were issued to
+    uint64_t       lastPresentId        = 0;
+    uint64_t       waitedPresentId      = 0;
+    VkSwapchainKHR lastPresentSwapchain = VK_NULL_HANDLE;
+
+    // Present pacing, written by the rendering thread
+    mutable std::mutex                    statsLock;
+    PresentStats                          presentStats{};
+    std::chrono::steady_clock::time_point lastPresentTime;
+
+    // Pipeline cache persisted across runs; every pipeline is created against it
+    VulkanPipelineCache   pipelineCache;
+    VulkanPipelineManager pipelines;
+
+    // Render pass and framebuffers, only created without dynamic rendering
     VkRenderPass                renderPass = VK_NULL_HANDLE;
     std::vector<VkFramebuffer> swapChainFramebuffers;
 
-    // Command pool and buffers
-    VkCommandPool                 commandPool = VK_NULL_HANDLE;
-    std::vector<VkCommandBuffer> commandBuffers;
+    // Targets replaced by a resize, destroyed once every frame submitted before then completed
+    struct RetiredTargets {
+        uint64_t                       frame      = 0;   ///< Last frame submitted before retirement.
+        VkSwapchainKHR                 swapchain  = VK_NULL_HANDLE;
+        VkRenderPass                   renderPass = VK_NULL_HANDLE;   ///< Only if the format changed.
+        std::vector<VkImageView>       imageViews;
+        std::vector<VkFramebuffer>     framebuffers;
+        std::vector<VkImage>           offscreenImages;
+        std::vector<VulkanAllocation*> offscreenMemory;
+    };
+    std::vector<RetiredTargets> retiredTargets;
+
+    // Primary command buffers, from a pool per frame in flight reset once its fence signals
+    VulkanFrameCommands frameCommands;
+    VkCommandBuffer     frameCommandBuffer = VK_NULL_HANDLE;   ///< Recorded by BeginFrame, submitted by EndFrame.
 
-    // Synchronization
+    // Secondary command buffers recorded on the job system, per frame in flight
+    VulkanCommandRecorder secondaryRecorder;
+
+    // Synchronization. The graphics timeline reaches N when frame N completes; without
+    // timeline semaphores a fence per frame in flight records which frame it covers.
     std::vector<VkSemaphore> imageAvailableSemaphores;
     std::vector<VkSemaphore> renderFinishedSemaphores;
-    std::vector<VkFence>     inFlightFences;
+    VkSemaphore              frameTimeline = VK_NULL_HANDLE;
+    std::vector<VkFence>     frameFences;
+    std::vector<uint64_t>    fenceFrames;
+    std::atomic<uint64_t>    completedFrame{0};
+
+    // Scene state submitted for the next frame
+    struct PendingRect {
+        VkClearRect       rect;
+        VkClearColorValue color;
+    };
+    VkClearColorValue        clearColor = {{0.468f, 0.177f, 0.741f, 1.0f}};
+    std::vector<PendingRect> pendingRects;
 
     // Frame state
-    size_t   currentFrame      = 0;
+    std::atomic<bool> framebufferResized{false};  ///< Set by NotifyResized, consumed by BeginFrame.
+    bool     minimized         = false;  ///< The window had no area at the last recreation attempt.
+    std::atomic<uint64_t> submittedFrames{0};  ///< Number of the last submitted frame.
+    size_t   currentFrame      = 0;              ///< Frame in flight slot, (frame number - 1) % framesInFlight.
     uint32_t currentImageIndex = 0;
-    const int MAX_FRAMES_IN_FLIGHT = 2;
+    uint32_t framesInFlight    = DefaultFramesInFlight;
 
     // Internal methods
     void CreateInstance();
     void CreateSurface();
     void PickPhysicalDevice();
     void CreateLogicalDevice();
-    void CreateSwapChain();
+    void CreateSwapChain(VkSwapchainKHR oldSwapchain);
+    void CreateOffscreenTargets();
+    void DestroyOffscreenTargets();
     void CreateImageViews();
     void CreateRenderPass();
     void CreateFramebuffers();
     void CreateCommandPool();
-    void CreateCommandBuffers();
     void CreateSyncObjects();
-    void RecreateSwapChain();
-    void CleanupSwapChain();
-    void RecordCommandBuffer(VkCommandBuffer, uint32_t imageIndex);
+    bool RecreateSwapChain();
+    void DestroyRetiredTargets(bool all);
+    void RefreshCompletedFrame();
+    void RecordPresentInterval();
+    void RecordCommandBuffer(uint32_t imageIndex);
+    void RecordPass(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+    static void RecordClearPass(void* context, VkCommandBuffer commandBuffer);
+    static void RecordRects(void* context, VkCommandBuffer commandBuffer, uint32_t begin, uint32_t end);
 
     // Helpers functions
     static SwapChainSupportDetails QuerySwapChainSupport(VkPhysicalDevice device, VkSurfaceKHR surface);
-    static QueueFamilyIndices FindQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface);
+    static VulkanDeviceCapabilities QueryDeviceCapabilities(VkPhysicalDevice device, VkSurfaceKHR surface);
+    static QueueFamilyIndices FindQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface,
+                                                const std::vector<VkQueueFamilyProperties>& families);
     static VkSurfaceFormatKHR ChooseSurfaceFormat(const std::vector<VkSurfaceFormatKHR> &formats);
-    static VkPresentModeKHR ChoosePresentMode(const std::vector<VkPresentModeKHR> &modes);
+    static PresentMode ChoosePresentMode(const std::vector<VkPresentModeKHR> &modes, PresentMode preferred);
+    static VkPresentModeKHR ToVkPresentMode(PresentMode mode);
+    static uint32_t ChooseImageCount(const VkSurfaceCapabilitiesKHR &caps, PresentMode mode, bool lowLatency);
     static VkExtent2D ChooseSwapExtent(const VkSurfaceCapabilitiesKHR &caps, INativeWindowHandleProvider *win);
 };
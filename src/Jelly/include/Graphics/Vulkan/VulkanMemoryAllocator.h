@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "VulkanDeviceCapabilities.h"
+
+#include "vulkan/vulkan.h"
+
+/// Tiling of the resource an allocation is bound to. Linear resources (buffers, linear
+/// images) and optimal-tiling images must not share a bufferImageGranularity page, so on
+/// devices where that granularity is above one they are carved from separate blocks.
+enum class VulkanResourceTiling : std::uint32_t {
+    Linear,
+    Optimal
+};
+
+/// Range of device memory handed out by VulkanMemoryAllocator. The allocator owns it until
+/// Free; memory, offset and mapped change when a defragmentation move completes.
+struct VulkanAllocation {
+    VkDeviceMemory memory     = VK_NULL_HANDLE;
+    VkDeviceSize   offset     = 0;
+    VkDeviceSize   size       = 0;
+    void*          mapped     = nullptr;   ///< Host address of offset for host-visible memory.
+    std::uint32_t  memoryType = 0;
+    bool           dedicated  = false;     ///< Owns its VkDeviceMemory instead of sharing a block.
+
+private:
+    friend class VulkanMemoryAllocator;
+    void*         block        = nullptr;
+    std::uint32_t node         = 0;
+    void*         pendingBlock = nullptr;   ///< Defragmentation destination until EndDefragmentation.
+    std::uint32_t pendingNode  = 0;
+};
+
+/// Totals reported by VulkanMemoryAllocator::GetStats.
+struct VulkanMemoryStats {
+    std::uint32_t blockCount        = 0;   ///< Shared blocks.
+    std::uint32_t dedicatedCount    = 0;   ///< Allocations with their own VkDeviceMemory.
+    std::uint32_t allocationCount   = 0;   ///< Live allocations, dedicated included.
+    std::uint32_t deviceMemoryCount = 0;   ///< vkAllocateMemory objects, against maxMemoryAllocationCount.
+    VkDeviceSize  reservedBytes     = 0;   ///< Blocks plus dedicated allocations.
+    VkDeviceSize  usedBytes         = 0;   ///< Bytes inside live allocations.
+    VkDeviceSize  largestFreeRange  = 0;   ///< Biggest free range in any block.
+};
+
+/// One allocation the caller must copy during an incremental defragmentation pass.
+struct VulkanDefragmentMove {
+    VulkanAllocation* allocation = nullptr;
+    VkDeviceMemory    srcMemory  = VK_NULL_HANDLE;
+    VkDeviceSize      srcOffset  = 0;
+    VkDeviceMemory    dstMemory  = VK_NULL_HANDLE;
+    VkDeviceSize      dstOffset  = 0;
+    VkDeviceSize      size       = 0;
+};
+
+/// Sub-allocates device memory from large per-memory-type blocks.
+///
+/// Each block keeps its free ranges in a two-level segregated fit (TLSF) index: free ranges
+/// are binned by power of two and then by 16 linear steps, and two bitmaps find the first
+/// bin that satisfies a request in constant time. Freed ranges merge with their physical
+/// neighbours immediately. Requests larger than half a block get their own VkDeviceMemory.
+///
+/// Defragmentation is incremental: BeginDefragmentation reserves new ranges for up to a
+/// byte budget of allocations from the emptiest blocks and returns the copies to make; once
+/// the GPU has executed them and the resources are rebound, EndDefragmentation retargets the
+/// allocations and releases blocks that became empty. Run one pass per frame.
+///
+/// All functions are thread-safe.
+class VulkanMemoryAllocator {
+public:
+    VulkanMemoryAllocator();
+    ~VulkanMemoryAllocator();
+
+    VulkanMemoryAllocator(const VulkanMemoryAllocator&) = delete;
+    VulkanMemoryAllocator& operator=(const VulkanMemoryAllocator&) = delete;
+
+    void Create(VkDevice device, const VulkanDeviceCapabilities& capabilities);
+
+    /// Frees every block. Allocations still alive are reported and invalidated.
+    void Destroy();
+
+    /// Allocates memory for @p requirements from a type with @p properties, or from any
+    /// allowed type if none has them.
+    /// @return The allocation, or null if the device is out of memory.
+    VulkanAllocation* Allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties,
+                               VulkanResourceTiling tiling);
+
+    /// Allocates memory for @p requirements from a type with @p required and @p preferred,
+    /// or from a type with only @p required if none has both. Never picks a type without
+    /// @p required, e.g. for memory that must be mapped but need not be host coherent.
+    /// @return The allocation, or null if no such type has room.
+    VulkanAllocation* Allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags required,
+                               VkMemoryPropertyFlags preferred, VulkanResourceTiling tiling);
+
+    /// Allocates memory for @p buffer and binds it.
+    VulkanAllocation* AllocateForBuffer(VkBuffer buffer, VkMemoryPropertyFlags properties);
+
+    /// Allocates memory for an optimal-tiling @p image and binds it.
+    VulkanAllocation* AllocateForImage(VkImage image, VkMemoryPropertyFlags properties);
+
+    /// Returns an allocation to its block. Null is ignored. Must not have a pending move.
+    void Free(VulkanAllocation* allocation);
+
+    [[nodiscard]] VulkanMemoryStats GetStats() const;
+
+    /// Plans the next defragmentation step, moving at most @p maxBytes. Allocations whose
+    /// move from an earlier call has not been ended yet are left where they are.
+    /// @param moves Receives the copies to record; each source stays valid until EndDefragmentation.
+    /// @return The number of moves planned; 0 when the blocks are as compact as they get.
+    std::uint32_t BeginDefragmentation(VkDeviceSize maxBytes, std::vector<VulkanDefragmentMove>& moves);
+
+    /// Completes the moves of the last BeginDefragmentation once their copies have finished
+    /// on the GPU and their resources are bound to the destinations.
+    void EndDefragmentation(const std::vector<VulkanDefragmentMove>& moves);
+
+private:
+    struct Block;
+    struct Pool {
+        std::uint32_t                       memoryType = 0;
+        VkDeviceSize                        blockSize  = 0;
+        std::vector<std::unique_ptr<Block>> blocks;
+    };
+
+    Pool& PoolFor(std::uint32_t memoryType, VulkanResourceTiling tiling);
+    Block* CreateBlock(Pool& pool);
+    void DestroyBlock(Block* block);
+    void ReleaseEmptyBlocks(Pool& pool);
+    VulkanAllocation* AllocateDedicated(const VkMemoryRequirements& requirements, std::uint32_t memoryType);
+    VulkanAllocation* AllocateFromPool(Pool& pool, const VkMemoryRequirements& requirements);
+    VulkanAllocation* NewRecord();
+    bool IsHostVisible(std::uint32_t memoryType) const;
+
+    VkDevice                         device = VK_NULL_HANDLE;
+    VkPhysicalDeviceMemoryProperties memoryProperties{};
+    VkDeviceSize                     granularity = 1;
+    std::uint32_t                    maxDeviceMemoryCount = 0;
+    std::uint32_t                    deviceMemoryCount = 0;
+    std::uint32_t                    dedicatedCount = 0;
+    std::uint32_t                    allocationCount = 0;
+    VkDeviceSize                     dedicatedBytes = 0;
+
+    std::vector<Pool>             pools;          ///< Memory type x tiling.
+    std::deque<VulkanAllocation>  records;        ///< Stable storage for handed-out allocations.
+    std::vector<VulkanAllocation*> freeRecords;
+    mutable std::mutex            mutex;
+};
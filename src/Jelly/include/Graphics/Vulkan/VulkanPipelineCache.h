@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "vulkan/vulkan.h"
+
+/// VkPipelineCache persisted between runs, so pipelines compiled once are loaded from
+/// disk on later launches instead of being rebuilt from SPIR-V.
+///
+/// The file is the driver's cache blob behind a small header holding its size, checksum
+/// and the driver version. It is only used when that header checks out and the blob's own
+/// header names this device (vendor ID, device ID and pipelineCacheUUID); anything else
+/// starts an empty cache that replaces the file on the next save. Saving writes a temporary
+/// file and renames it over the old one, so a crash never leaves a half-written cache.
+class VulkanPipelineCache {
+public:
+    /// Largest cache read or written (64 MiB); bigger blobs are dropped.
+    static constexpr std::size_t MaxFileSize = std::size_t(64) << 20;
+
+    /// Creates the cache, seeded from the file in @p directory written for this device.
+    /// An empty @p directory keeps the cache in memory only.
+    /// @param properties Properties of the device the cache is created on.
+    void Create(VkDevice device, const VkPhysicalDeviceProperties& properties, const std::string& directory);
+
+    /// Writes the cache to disk if it changed since it was loaded. Failures are logged.
+    /// @return True if the file is up to date.
+    bool Save();
+
+    /// Destroys the cache without saving it.
+    void Destroy();
+
+    /// Returns the handle to pass to vkCreate*Pipelines (null before Create).
+    [[nodiscard]] VkPipelineCache Get() const { return cache; }
+
+    /// Returns the per-user cache directory, or an empty string if none can be found.
+    /// JELLY_CACHE_DIR overrides the platform default.
+    static std::string DefaultDirectory();
+
+private:
+    bool Load(std::string& data) const;
+
+    VkDevice                   device     = VK_NULL_HANDLE;
+    VkPipelineCache            cache      = VK_NULL_HANDLE;
+    VkPhysicalDeviceProperties properties = {};
+    std::string                path;
+    std::size_t                loadedSize = 0;       ///< Blob size at the last load or save.
+    std::uint64_t              loadedChecksum = 0;   ///< Blob checksum then; an unchanged blob skips the save.
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Jobs/JobSystem.h"
+
+#include "vulkan/vulkan.h"
+
+/// Identifies a pipeline requested from VulkanPipelineManager. 0 is never a valid handle.
+using PipelineHandle = std::uint32_t;
+
+/// Everything needed to build a graphics pipeline. Viewport and scissor are dynamic, vertices
+/// are generated by the vertex shader, and both stages share one push constant range.
+struct PipelineDesc {
+    std::vector<std::uint32_t> vertexSpirv;
+    std::vector<std::uint32_t> fragmentSpirv;
+    VkRenderPass        renderPass       = VK_NULL_HANDLE;   ///< Any render pass compatible with the target.
+    std::uint32_t       subpass          = 0;
+    VkFormat            colorFormat      = VK_FORMAT_UNDEFINED;   ///< Target format for dynamic rendering (no render pass).
+    VkPrimitiveTopology topology         = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    bool                alphaBlend       = false;
+    std::uint32_t       pushConstantSize = 0;                ///< Bytes; 0 declares no push constants.
+
+    bool operator==(const PipelineDesc& other) const;
+};
+
+/// Compile state of a requested pipeline.
+enum class PipelineState : std::uint32_t {
+    Pending,    ///< Queued or compiling.
+    Ready,      ///< Usable.
+    Failed      ///< Compilation failed; the handle never becomes ready.
+};
+
+/// Compiles graphics pipelines on the job system against the shared pipeline cache.
+///
+/// Request returns immediately with a handle; a worker builds the pipeline and flips the
+/// handle to Ready. Frames ask for the pipeline with Resolve, which hands back a fallback
+/// (or nothing, so the draw is skipped) until it is ready, so a pipeline first needed
+/// mid-session never stalls the frame that needs it. Identical descriptions share a handle.
+/// Pipelines live until Destroy.
+class VulkanPipelineManager {
+public:
+    /// Called on the compiling thread once a pipeline is ready or has failed.
+    using ReadyCallback = void (*)(void* userData, PipelineHandle handle, bool succeeded);
+
+    /// Most pipelines one manager holds.
+    static constexpr std::uint32_t MaxPipelines = 1024;
+
+    /// @param jobs Job system to compile on; null compiles inside Request.
+    void Create(VkDevice device, VkPipelineCache cache, JobSystem* jobs);
+
+    /// Waits for compilations in flight, then destroys every pipeline.
+    void Destroy();
+
+    /// Queues a pipeline for compilation, or returns the handle of an identical request.
+    /// @param callback Optional. If the pipeline already finished compiling it runs before
+    ///                 Request returns.
+    /// @return The handle, or 0 if the manager is full.
+    PipelineHandle Request(const PipelineDesc& desc, ReadyCallback callback = nullptr, void* userData = nullptr);
+
+    /// Returns the compile state of @p handle (Failed for invalid handles).
+    [[nodiscard]] PipelineState GetState(PipelineHandle handle) const;
+
+    /// Returns the pipeline of @p handle, or VK_NULL_HANDLE until it is ready.
+    [[nodiscard]] VkPipeline Get(PipelineHandle handle) const;
+
+    /// Returns the layout of @p handle, or VK_NULL_HANDLE until it is ready.
+    [[nodiscard]] VkPipelineLayout GetLayout(PipelineHandle handle) const;
+
+    /// Returns the pipeline of @p handle if ready, otherwise that of @p fallback if ready,
+    /// otherwise VK_NULL_HANDLE (skip the draw). Never blocks.
+    [[nodiscard]] VkPipeline Resolve(PipelineHandle handle, PipelineHandle fallback) const;
+
+    /// Returns the number of requests still compiling.
+    [[nodiscard]] std::uint32_t GetPendingCount() const { return compiles.pending.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        PipelineDesc               desc;
+        std::atomic<PipelineState> state{PipelineState::Pending};
+        VkPipeline                 pipeline = VK_NULL_HANDLE;   ///< Published by the release store to state.
+        VkPipelineLayout           layout   = VK_NULL_HANDLE;
+        std::vector<std::pair<ReadyCallback, void*>> callbacks; ///< Guarded by the manager's mutex.
+    };
+
+    const Entry* Find(PipelineHandle handle) const;
+    void Compile(std::uint32_t index);
+    static void CompileJob(void* context, std::uint32_t begin, std::uint32_t end);
+    static std::uint64_t Hash(const PipelineDesc& desc);
+
+    VkDevice                       device = VK_NULL_HANDLE;
+    VkPipelineCache                cache  = VK_NULL_HANDLE;
+    JobSystem*                     jobs   = nullptr;
+    std::unique_ptr<Entry[]>       entries;             ///< MaxPipelines slots; never move.
+    std::atomic<std::uint32_t>     entryCount{0};       ///< Slots in use.
+    std::mutex                     mutex;               ///< Guards requests, lookups and callbacks.
+    std::unordered_multimap<std::uint64_t, std::uint32_t> lookup;   ///< Description hash -> slot.
+    JobCounter                     compiles;
+};
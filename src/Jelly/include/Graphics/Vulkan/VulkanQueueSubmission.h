@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+#include "vulkan/vulkan.h"
+
+/// Kind of work a queue is used for. Transfer and Compute map to dedicated queue families
+/// when the device has them and to the graphics queue otherwise.
+enum class VulkanQueueType : std::uint32_t {
+    Graphics,
+    Compute,
+    Transfer,
+    Count
+};
+
+/// One batch submitted with VulkanGraphicsAPI::Submit. Semaphores order it against work
+/// on the other queues: wait on what another queue signals, signal what it waits on.
+/// Timeline semaphores take their values from waitValues and signalValues; entries for
+/// binary semaphores in those arrays are ignored.
+struct VulkanQueueSubmission {
+    const VkCommandBuffer*      commandBuffers     = nullptr;
+    std::uint32_t               commandBufferCount = 0;
+    const VkSemaphore*          waitSemaphores     = nullptr;
+    const VkPipelineStageFlags* waitStages         = nullptr;   ///< One per wait semaphore.
+    const std::uint64_t*        waitValues         = nullptr;   ///< One per wait semaphore, or null.
+    std::uint32_t               waitSemaphoreCount = 0;
+    const VkSemaphore*          signalSemaphores   = nullptr;
+    const std::uint64_t*        signalValues       = nullptr;   ///< One per signal semaphore, or null.
+    std::uint32_t               signalSemaphoreCount = 0;
+    VkFence                     fence              = VK_NULL_HANDLE;   ///< Optional.
+};
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "VulkanMemoryAllocator.h"
+
+#include "vulkan/vulkan.h"
+
+class VulkanGraphicsAPI;
+
+/// Identifies an upload queued on VulkanUploader. Tickets grow monotonically; 0 means the
+/// upload was rejected.
+using UploadTicket = std::uint64_t;
+
+/// Destination of an image upload. Source texels are tightly packed.
+struct VulkanImageUpload {
+    VkImage                  image       = VK_NULL_HANDLE;
+    VkImageSubresourceLayers subresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    VkOffset3D               offset      = {0, 0, 0};
+    VkExtent3D               extent      = {0, 0, 1};
+    std::uint32_t            texelSize   = 4;   ///< Bytes per texel (uncompressed formats only).
+    VkImageLayout            finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+};
+
+/// Streams buffer and image data to the GPU through a persistently mapped staging ring.
+///
+/// Upload copies the data into the ring and records a copy region; Flush, called once per
+/// frame, records every pending region into one command buffer (one vkCmdCopyBuffer per
+/// destination buffer, image transitions batched into two barriers) and submits it on the
+/// transfer queue, or the graphics queue when the device has no dedicated one. Completion is
+/// tracked with a timeline semaphore whose value counts batches (a fence per batch when
+/// VK_KHR_timeline_semaphore is missing), and ring space is reclaimed as batches retire.
+///
+/// At most the frame budget is copied per frame; the rest waits in a backlog and streams in
+/// over the following frames, so a large asset load never causes a frame spike. Uploads
+/// bigger than the ring are split into chunks (images by rows).
+///
+/// Destinations must be usable on both queues: when a dedicated transfer queue exists, create
+/// them with VK_SHARING_MODE_CONCURRENT over VulkanGraphicsAPI::GetQueueFamilies. Images are
+/// transitioned from UNDEFINED, so their previous contents are discarded. Uploading over a
+/// range the GPU may still be reading is the caller's responsibility.
+///
+/// Upload and IsComplete are thread-safe; BeginFrame and Flush run on the render thread.
+class VulkanUploader {
+public:
+    static constexpr VkDeviceSize  DefaultCapacity    = VkDeviceSize(64) << 20;
+    static constexpr VkDeviceSize  DefaultFrameBudget = VkDeviceSize(16) << 20;
+    static constexpr std::uint32_t MaxBatches         = 8;   ///< Submissions in flight at once.
+
+    /// Creates the staging ring and the transfer command pool.
+    /// @param capacity Ring size in bytes.
+    void Create(VulkanGraphicsAPI& graphics, VkDeviceSize capacity = DefaultCapacity);
+
+    /// Destroys everything; the device must be idle. Queued uploads are dropped.
+    void Destroy();
+
+    /// Queues @p size bytes for @p buffer at @p offset. @p data is copied before returning.
+    /// @return The ticket, or 0 if the uploader is not created or @p size is 0.
+    UploadTicket UploadBuffer(VkBuffer buffer, VkDeviceSize offset, const void* data, VkDeviceSize size);
+
+    /// Queues texels for an image region; @p data holds texelSize * width * height * depth
+    /// * layerCount bytes. Regions with several layers or slices must fit in the ring.
+    /// @return The ticket, or 0 if the region is invalid or too large.
+    UploadTicket UploadImage(const VulkanImageUpload& target, const void* data);
+
+    /// Returns true once the GPU has finished the upload of @p ticket.
+    [[nodiscard]] bool IsComplete(UploadTicket ticket) const {
+        return ticket <= completedTicket.load(std::memory_order_acquire);
+    }
+
+    /// Retires finished batches and starts a new frame budget. Called at the start of a frame.
+    void BeginFrame();
+
+    /// Streams the backlog within the frame budget and submits the pending copies.
+    /// @param waitSemaphore Receives the semaphore the frame's graphics submission must wait on
+    ///                      (at VK_PIPELINE_STAGE_ALL_COMMANDS_BIT), or VK_NULL_HANDLE.
+    /// @param waitValue     Receives the timeline value to wait for.
+    void Flush(VkSemaphore& waitSemaphore, std::uint64_t& waitValue);
+
+    /// Sets the bytes copied into the ring per frame; 0 removes the limit.
+    void SetFrameBudget(VkDeviceSize bytes);
+
+    /// Returns the bytes still waiting in the backlog.
+    [[nodiscard]] VkDeviceSize GetBacklogBytes() const;
+
+private:
+    /// Upload waiting for ring space or budget, with its own copy of the data.
+    struct PendingUpload {
+        UploadTicket              ticket       = 0;
+        VkBuffer                  buffer       = VK_NULL_HANDLE;   ///< Null for image uploads.
+        VkDeviceSize              bufferOffset = 0;
+        VulkanImageUpload         image;
+        VkDeviceSize              size         = 0;
+        VkDeviceSize              consumed     = 0;   ///< Bytes already moved into the ring.
+        VkDeviceSize              dataStart    = 0;   ///< Value of consumed when data was copied.
+        std::vector<std::uint8_t> data;               ///< Bytes from dataStart on.
+    };
+
+    struct BufferRegion {
+        VkBuffer     buffer;
+        VkBufferCopy copy;
+    };
+
+    struct ImageRegion {
+        VkImage           image;
+        VkBufferImageCopy copy;
+        VkImageLayout     finalLayout;
+        bool              first;   ///< Transition from UNDEFINED before the copy.
+        bool              last;    ///< Transition to finalLayout after the copy.
+    };
+
+    /// One submission; retires when the GPU reaches its value.
+    struct Batch {
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        VkFence         fence         = VK_NULL_HANDLE;   ///< Only without timeline semaphores.
+        std::uint64_t   value         = 0;
+        std::uint64_t   ringEnd       = 0;
+        UploadTicket    lastTicket    = 0;
+    };
+
+    UploadTicket Queue(PendingUpload& upload, const std::uint8_t* data);
+    bool Reserve(VkDeviceSize unit, VkDeviceSize maxSize, VkDeviceSize align, VkDeviceSize& size, VkDeviceSize& offset);
+    bool Stage(PendingUpload& upload, const std::uint8_t* data);
+    bool StageBuffer(PendingUpload& upload, const std::uint8_t* data);
+    bool StageImage(PendingUpload& upload, const std::uint8_t* data);
+    VkDeviceSize Budget(VkDeviceSize unit) const;
+    void Retire();
+    void RecordBatch(VkCommandBuffer commandBuffer);
+    void FlushMappedRange();
+
+    VulkanGraphicsAPI* graphics = nullptr;
+    VkDevice           device   = VK_NULL_HANDLE;
+    VkBuffer           staging  = VK_NULL_HANDLE;
+    VulkanAllocation*  stagingMemory = nullptr;
+    std::uint8_t*      mapped   = nullptr;
+    bool               coherent = true;
+    VkDeviceSize       atomSize = 1;
+    VkDeviceSize       alignment = 16;
+    VkDeviceSize       capacity = 0;
+    VkExtent3D         granularity = {1, 1, 1};   ///< minImageTransferGranularity of the queue.
+
+    // Ring positions grow without wrapping; the buffer offset is position % capacity.
+    std::uint64_t head    = 0;
+    std::uint64_t tail    = 0;
+    std::uint64_t flushed = 0;   ///< Head at the last non-coherent flush.
+
+    VkCommandPool      commandPool = VK_NULL_HANDLE;
+    VkSemaphore        timeline    = VK_NULL_HANDLE;
+    std::deque<Batch>  inFlight;
+    std::vector<Batch> freeBatches;
+    std::uint64_t      submittedValue = 0;
+
+    std::vector<BufferRegion>  bufferRegions;
+    std::vector<ImageRegion>   imageRegions;
+    std::deque<PendingUpload>  backlog;
+    VkDeviceSize               backlogBytes = 0;
+    VkDeviceSize               frameBudget  = DefaultFrameBudget;
+    VkDeviceSize               frameBytes   = 0;
+    UploadTicket               nextTicket   = 1;
+    UploadTicket               stagedTicket = 0;   ///< Highest ticket whose last byte is staged.
+    std::atomic<UploadTicket>  completedTicket{0};
+    mutable std::mutex         mutex;
+};
@@ -1,15 +1,25 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <thread>
 
+#include "Core/FrameLoop.h"
+#include "Core/FramePacer.h"
 #include "Graphics/GraphicsAPIType.h"
 #include "Graphics/IGraphicsAPI.h"
+#include "Graphics/RenderCommandRing.h"
+#include "Graphics/RenderPacketQueue.h"
+#include "Jobs/JobSystem.h"
 #include "Window/IWindowSystem.h"
 #include "Window/WindowSettings.h"
 
 /// Core engine class responsible for managing the window and graphics API.
 class JellyEngine {
 public:
+    /// Joins the render thread and releases async logging if the host never called Shutdown.
+    ~JellyEngine();
+
     /// Initializes the engine with the selected graphics API and window settings.
     /// @param apiType The enum of the graphics API (e.g., "Vulkan").
     /// @param settings The configuration for the window.
@@ -19,17 +29,94 @@ public:
     /// Returns true if the engine should keep running (i.e., window is open).
     bool IsRunning();
 
-    /// Polls input and window events.
+    /// Polls input and window events. A reported resize rebuilds the render targets
+    /// at the start of the next frame.
     void PollEvents();
 
-    /// Renders a single frame by beginning and ending the graphics API frame.
-    /// Typically called once per loop iteration.
-    void Render();
+    /// Resizes the offscreen target of a headless engine; the next frame rebuilds it.
+    /// Windowed engines follow their window instead.
+    /// @return False if the engine is not headless.
+    bool ResizeTarget(uint32_t width, uint32_t height);
+
+    /// Returns the input events received by the last poll.
+    const InputEventBuffer& GetInputEvents() const;
+
+    /// Renders a single frame: consumes the render command ring, then begins and ends
+    /// the graphics API frame. Typically called once per loop iteration.
+    /// With the render thread enabled this only queues the frame's commands; it waits
+    /// only when the render thread is a full queue depth behind.
+    /// @return True if a frame was drawn, or queued while the render thread last found the
+    ///         target drawable. False while minimized or when the frame had to be dropped.
+    bool Render();
+
+    /// Starts or stops the dedicated render thread. While it runs, every graphics API call
+    /// happens on it and Render hands frames over in packets. Call from the game thread.
+    /// @param enabled True to render on a dedicated thread, false to render inline.
+    /// @param queueDepth Frames the game thread may run ahead, including the one drawing.
+    void SetRenderThreadEnabled(bool enabled, std::uint32_t queueDepth = 2);
+
+    /// Returns true while frames are drawn on the render thread.
+    [[nodiscard]] bool IsRenderThreadEnabled() const { return renderThread.joinable(); }
+
+    /// Returns the ring managed code writes render commands into.
+    RenderCommandRing& GetRenderCommands() { return renderCommands; }
+
+    /// Polls events, advances the frame clock and, while the window stays open, renders
+    /// one frame and waits for the frame limiter.
+    /// @param rendered Optional; receives the result of Render, or false if the engine stopped.
+    /// @return True if the engine keeps running.
+    bool Tick(bool* rendered = nullptr);
+
+    /// Configures the simulation step and the frame limiter.
+    /// @param fixedStepSeconds Length of a simulation step; non-positive keeps the current one.
+    /// @param targetFps Frame rate to pace Tick to; 0 disables the limiter.
+    void SetFrameTiming(double fixedStepSeconds, double targetFps);
+
+    /// Selects how frames are presented; takes effect from the next frame.
+    /// @param lowLatency Wait for the previous frame to reach the display before polling input,
+    ///                   where supported. Only applies while the render thread is disabled.
+    void SetPresentMode(PresentMode mode, bool lowLatency);
 
-    /// Shuts down the engine and releases window resources.
+    /// Returns the measured intervals between presents.
+    PresentStats GetPresentStats() const;
+
+    /// Returns the timing computed by the last Tick. The reference stays valid for the
+    /// engine's lifetime.
+    const FrameTiming& GetFrameTiming() const { return frameLoop.GetTiming(); }
+
+    /// Returns the engine's job system. Valid between Initialize and Shutdown.
+    JobSystem& GetJobSystem() { return *jobs; }
+
+    /// Shuts down the engine, releases window resources and flushes the logger.
     void Shutdown();
 
 private:
+    /// Translates the commands queued since the last frame into graphics API calls.
+    void ExecuteRenderCommands();
+
+    /// Translates one command, tracking the current transform in @p transform.
+    void ExecuteRenderCommand(const RenderCommand& command, float transform[6]);
+
+    /// Render thread loop: draws packets until the queue closes.
+    void RenderThreadMain();
+
+    /// Closes the packet queue and joins the render thread.
+    void StopRenderThread();
+
+    /// Matches the Logger::StartAsync call made by Initialize, at most once.
+    void StopAsyncLogging();
+
     std::unique_ptr<IWindowSystem> window;  ///< Active window system instance.
     std::unique_ptr<IGraphicsAPI> graphics; ///< Active graphics API instance.
+    RenderCommandRing renderCommands;       ///< Commands produced by managed code.
+    FrameLoop frameLoop;                    ///< Fixed-timestep clock.
+    FramePacer framePacer;                  ///< Frame rate limiter.
+    std::unique_ptr<JobSystem> jobs;        ///< Worker threads, one per spare core.
+
+    std::unique_ptr<RenderPacketQueue> renderPackets; ///< Frames handed to the render thread.
+    std::thread renderThread;               ///< Owns the graphics API while running.
+    std::atomic<bool> renderFailed{false};  ///< Set when the render thread stopped on an error.
+    std::atomic<bool> targetMinimized{false}; ///< Set when the last frame was skipped for a minimized window.
+    std::uint64_t framesQueued = 0;
+    bool asyncLogging = false;              ///< Set while this engine holds a Logger::StartAsync reference.
 };
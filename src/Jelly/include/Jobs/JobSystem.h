@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "Jobs/WorkStealingDeque.h"
+
+/// Completion counter shared by a group of jobs. Each scheduled job adds one and
+/// subtracts one when it finishes; the group is complete when the counter is zero.
+struct JobCounter {
+    std::atomic<std::uint32_t> pending{0};
+
+    /// Returns true once every job of the group has finished.
+    [[nodiscard]] bool IsComplete() const { return pending.load(std::memory_order_acquire) == 0; }
+};
+
+/// Entry point of a job. Range jobs receive their [begin, end) slice.
+using JobFunction = void (*)(void* context, std::uint32_t begin, std::uint32_t end);
+
+/// Work-stealing job scheduler.
+///
+/// Every thread that schedules or runs jobs owns a Chase-Lev deque: it pushes and pops at
+/// the bottom of its own deque and steals from the top of the others when it runs dry.
+/// Threads that wait on a counter keep running jobs instead of blocking, and idle workers
+/// sleep on a condition variable until new work arrives. Jobs are plain function pointers
+/// plus a context, taken from per-thread rings, so scheduling does not allocate.
+class JobSystem {
+public:
+    /// Starts the worker threads.
+    /// @param workerCount Number of background workers; 0 runs every job on the threads that
+    ///                    wait for them, starting with the owner.
+    explicit JobSystem(std::uint32_t workerCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /// Finishes queued jobs and joins the workers. Called by the destructor.
+    void Shutdown();
+
+    /// Returns the number of threads running jobs, including the caller of Wait.
+    [[nodiscard]] std::uint32_t GetThreadCount() const { return static_cast<std::uint32_t>(workers.size()) + 1; }
+
+    /// Queues a job.
+    /// @param function Entry point, called with @p context and the [begin, end) range.
+    /// @param counter Incremented now and decremented when the job finishes; may be null.
+    /// @param dependency The job does not start before this counter reaches zero; may be null.
+    void Schedule(JobFunction function, void* context, std::uint32_t begin, std::uint32_t end,
+                  JobCounter* counter, const JobCounter* dependency = nullptr);
+
+    /// Runs queued jobs on the calling thread until @p counter reaches zero.
+    void Wait(const JobCounter& counter);
+
+    /// Calls body(begin, end) over [0, count) in slices of about @p grain items, spread over
+    /// every thread, and returns when all slices are done.
+    template <typename Body>
+    void ParallelFor(std::uint32_t count, std::uint32_t grain, Body&& body) {
+        if (count == 0) {
+            return;
+        }
+
+        grain = grain > 0 ? grain : 1;
+        JobCounter counter;
+        for (std::uint32_t begin = 0; begin < count; begin += grain) {
+            const std::uint32_t end = count - begin > grain ? begin + grain : count;
+            Schedule(&InvokeRange<std::remove_reference_t<Body>>, &body, begin, end, &counter);
+        }
+        Wait(counter);
+    }
+
+private:
+    static constexpr std::size_t MaxQueues    = 64;
+    static constexpr std::size_t JobsPerQueue = 4096;
+    static constexpr std::size_t MaxParked    = 64;
+
+    struct Job {
+        JobFunction       function;
+        void*             context;
+        std::uint32_t     begin;
+        std::uint32_t     end;
+        JobCounter*       counter;
+        const JobCounter* dependency;
+    };
+
+    /// Deque plus job storage of one thread.
+    struct Queue {
+        // The deque holds at most half the ring, so a slot is only reused long after the
+        // job it held left the deque and was copied out by whoever ran it.
+        explicit Queue(std::size_t capacity) : deque(capacity / 2), jobs(std::make_unique<Job[]>(capacity)) {}
+
+        WorkStealingDeque<Job> deque;
+        std::unique_ptr<Job[]> jobs;      ///< Ring the owner takes job slots from.
+        std::uint32_t          nextJob = 0;
+
+        Job           parked[MaxParked];  ///< Jobs taken while their dependency was pending. Owner only.
+        std::uint32_t parkedCount = 0;
+
+        std::atomic<bool> owned{true};    ///< Cleared when the owning thread exits, so another thread can take the queue over.
+    };
+
+    template <typename Body>
+    static void InvokeRange(void* context, std::uint32_t begin, std::uint32_t end) {
+        (*static_cast<Body*>(context))(begin, end);
+    }
+
+    Queue* LocalQueue();
+    void   Unpark(Queue* local);
+    Job*   FindJob(Queue* local);
+    bool   RunOne(Queue* local);
+    void   Execute(Job* job);
+    void   WorkerMain();
+    void   WakeWorkers();
+
+
+    const std::uint64_t         id;             ///< Distinguishes job systems in thread-local caches.
+    std::shared_ptr<Queue>      queues[MaxQueues];  ///< Shared so exiting threads can release theirs after the system is gone.
+    std::atomic<std::uint32_t>  queueCount{0};
+    std::mutex                  registerMutex;
+
+    std::vector<std::thread>    workers;
+    std::atomic<bool>           stopping{false};
+
+    std::mutex                  sleepMutex;
+    std::condition_variable     sleepCondition;
+    std::atomic<std::uint32_t>  sleepingWorkers{0};
+    std::atomic<std::uint64_t>  workEpoch{0};   ///< Bumped on every schedule; lets sleepers detect missed wakeups.
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/// Fixed-capacity Chase-Lev work-stealing deque of pointers.
+///
+/// The owning thread pushes and pops at the bottom without contention; other threads
+/// steal from the top with a single CAS. Memory orders follow Lê et al., "Correct and
+/// Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013). The buffer does not grow:
+/// Push fails when the deque is full and the caller runs the item itself.
+template <typename T>
+class WorkStealingDeque {
+public:
+    /// Creates a deque with room for @p capacity items (rounded up to a power of two).
+    explicit WorkStealingDeque(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+
+        mask  = static_cast<std::int64_t>(size - 1);
+        items = std::make_unique<std::atomic<T*>[]>(size);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /// Adds an item at the bottom. Owner thread only.
+    /// @return False if the deque is full.
+    bool Push(T* item) {
+        const std::int64_t b = bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = top.load(std::memory_order_acquire);
+        if (b - t > mask) {
+            return false;
+        }
+
+        items[b & mask].store(item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// Takes the most recently pushed item. Owner thread only.
+    /// @return nullptr if the deque is empty or a thief took the last item.
+    T* Pop() {
+        const std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T* item = items[b & mask].load(std::memory_order_relaxed);
+        if (t == b) {
+            // Last item: race the thieves for it.
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    /// Takes the oldest item. Safe from any thread.
+    /// @return nullptr if the deque is empty or another thread won the race.
+    T* Steal() {
+        std::int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) {
+            return nullptr;
+        }
+
+        T* item = items[t & mask].load(std::memory_order_relaxed);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+    /// Returns an estimate of the number of queued items.
+    [[nodiscard]] std::size_t SizeApprox() const {
+        const std::int64_t size = bottom.load(std::memory_order_relaxed) - top.load(std::memory_order_relaxed);
+        return size > 0 ? static_cast<std::size_t>(size) : 0;
+    }
+
+private:
+    std::unique_ptr<std::atomic<T*>[]> items;
+    std::int64_t mask = 0;
+
+    alignas(64) std::atomic<std::int64_t> top{0};
+    alignas(64) std::atomic<std::int64_t> bottom{0};
+};
@@ -1,5 +1,12 @@
 #pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <tuple>
+
+#include "Logging/LogArgs.h"
 
 /// Logging severity levels.
 enum class LogLevel {
@@ -9,11 +16,130 @@ enum class LogLevel {
     Error       ///< Errors that require attention.
 };
 
+/// Subsystem a message comes from. Each category has its own runtime level mask.
+enum class LogCategory {
+    Engine,     ///< Engine lifetime and core services.
+    Window,     ///< Window system and input.
+    Vulkan,     ///< Vulkan graphics backend.
+    Managed,    ///< Messages forwarded from the C# layer.
+    Count
+};
+
+/// Lowest severity compiled into the binary (0 = Info ... 3 = Error).
+/// JELLY_LOG calls below it compile to nothing; set through the JELLY_LOG_MIN_LEVEL CMake option.
+#ifndef JELLY_LOG_MIN_LEVEL
+#define JELLY_LOG_MIN_LEVEL 0
+#endif
+
+/// Bit of a LogLevel inside a category level mask.
+constexpr std::uint32_t LogLevelBit(LogLevel level) {
+    return 1u << static_cast<std::uint32_t>(level);
+}
+
+/// What the asynchronous logger does when its ring buffer is full.
+enum class LogOverflowPolicy {
+    Drop,   ///< Discard the message and report the number of dropped messages later.
+    Block   ///< Wait for the background thread to free a slot.
+};
+
 /// Simple logging utility with platform-specific colored output.
+///
+/// Every message belongs to a LogCategory and is dropped before any work is done when its
+/// level is not set in that category's mask. Records keep their arguments in binary form;
+/// the text is only produced when a record is written. By default that happens on the
+/// calling thread. After StartAsync() callers only copy the record into a bounded ring
+/// buffer and a background thread formats and writes the records in batches.
 class Logger {
 public:
+    /// Returns true if messages of @p level are currently emitted for @p category.
+    static bool IsEnabled(LogCategory category, LogLevel level) {
+        return static_cast<int>(level) >= JELLY_LOG_MIN_LEVEL &&
+               (levelMasks[static_cast<std::size_t>(category)].load(std::memory_order_relaxed) & LogLevelBit(level)) != 0;
+    }
+
+    /// Replaces the level mask of a category (a combination of LogLevelBit values).
+    static void SetLevelMask(LogCategory category, std::uint32_t mask);
+
+    /// Returns the level mask of a category.
+    static std::uint32_t GetLevelMask(LogCategory category);
+
+    /// Returns the mask array, indexed by LogCategory. The array lives for the whole process,
+    /// so foreign callers can keep the pointer and test masks without calling back in.
+    static const std::atomic<std::uint32_t>* LevelMasks() { return levelMasks; }
+
     /// Logs a message with a specified severity level.
+    /// @param category The subsystem the message comes from.
     /// @param level The severity level of the log.
     /// @param message The message to display.
-    static void Log(LogLevel level, const std::string& message);
+    static void Log(LogCategory category, LogLevel level, std::string_view message);
+
+    /// Logs a message whose arguments are encoded as-is and formatted later.
+    /// Prefer JELLY_LOG, which also filters before evaluating the arguments and checks the
+    /// placeholder count at compile time.
+    /// @param category The subsystem the message comes from.
+    /// @param level The severity level of the log.
+    /// @param format Format string with "{}" placeholders. Must be a string literal (or otherwise
+    ///               outlive the logger), since only its address is stored.
+    /// @param args Arguments substituted for the placeholders.
+    template <typename... Args>
+    static void Logf(LogCategory category, LogLevel level, const char* format, const Args&... args) {
+        if (!IsEnabled(category, level)) {
+            return;
+        }
+
+        LogPayload payload;
+        (EncodeLogArg(payload, args), ...);
+        LogEncoded(category, level, format, payload);
+    }
+
+    /// Logf with the arguments packed in a tuple of references (used by JELLY_LOG).
+    template <typename Tuple>
+    static void LogTuple(LogCategory category, LogLevel level, const char* format, const Tuple& args) {
+        std::apply([&](const auto&... unpacked) { Logf(category, level, format, unpacked...); }, args);
+    }
+
+    /// Logs a record whose arguments are already encoded. Does not check the level mask.
+    static void LogEncoded(LogCategory category, LogLevel level, const char* format, const LogPayload& payload);
+
+    /// Starts mirroring every record, unformatted, into a binary log file.
+    /// Use the jelly_logdecode tool to turn the file back into text.
+    /// @return False if the file could not be created.
+    static bool OpenBinaryLog(const std::string& path);
+
+    /// Stops writing the binary log file and closes it.
+    static void CloseBinaryLog();
+
+    /// Switches to asynchronous logging and starts the background writer thread.
+    /// Calls nest: each one must be matched by StopAsync(), and only the first call's
+    /// capacity and policy are used.
+    /// @param capacity Number of records the ring buffer can hold (rounded up to a power of two).
+    /// @param policy What to do when the ring buffer is full.
+    static void StartAsync(std::size_t capacity = 4096, LogOverflowPolicy policy = LogOverflowPolicy::Drop);
+
+    /// Blocks until every message logged before this call has been written.
+    static void Flush();
+
+    /// Matches one StartAsync() call. The last one flushes pending messages, stops the
+    /// background thread and returns to synchronous logging.
+    static void StopAsync();
+
+private:
+    static std::atomic<std::uint32_t> levelMasks[static_cast<std::size_t>(LogCategory::Count)];
 };
+
+/// Logs a message with deferred formatting, e.g.
+/// JELLY_LOG(LogCategory::Window, LogLevel::Info, "Window created: {} ({}x{})", title, width, height);
+/// @p level must be a constant. Calls below JELLY_LOG_MIN_LEVEL compile to nothing, and the
+/// arguments are only evaluated when the category mask enables the level. The number of "{}"
+/// placeholders must match the number of arguments.
+#define JELLY_LOG(category, level, format, ...)                                                   \
+    do {                                                                                          \
+        static_assert(CountLogPlaceholders(format) ==                                             \
+                          std::tuple_size<decltype(std::forward_as_tuple(__VA_ARGS__))>::value,   \
+                      "JELLY_LOG: placeholder count does not match the argument count");          \
+        if constexpr (static_cast<int>(level) >= JELLY_LOG_MIN_LEVEL) {                           \
+            if (Logger::IsEnabled(category, level)) {                                             \
+                Logger::LogTuple(category, level, format, std::forward_as_tuple(__VA_ARGS__));    \
+            }                                                                                     \
+        }                                                                                         \
+    } while (0)
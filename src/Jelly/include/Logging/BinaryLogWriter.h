@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+
+#include "Logger.h"
+
+/// Magic bytes at the start of every binary log file.
+constexpr char BinaryLogMagic[4] = {'J', 'L', 'O', 'G'};
+
+/// Version of the binary log layout described below.
+constexpr std::uint32_t BinaryLogVersion = 2;
+
+/// Tag in front of every entry of a binary log file.
+///
+/// File layout (all integers in the writer's native byte order):
+///   header:  magic, uint32 version
+///   Format:  uint32 id, uint16 length, format bytes
+///   Record:  int64 unix time in ns, uint32 format id, uint8 category, uint8 level, uint8 flags,
+///            uint16 payload size, payload bytes (see LogPayload)
+///
+/// A Format entry always precedes the first Record that references its id.
+enum class BinaryLogEntry : std::uint8_t {
+    Format = 1,
+    Record = 2
+};
+
+/// Record flag set when the payload was truncated while encoding.
+constexpr std::uint8_t BinaryLogTruncated = 0x1;
+
+/// Writes log records to disk without formatting them.
+/// Format strings are written once and referenced by id afterwards.
+class BinaryLogWriter {
+public:
+    ~BinaryLogWriter();
+
+    /// Creates (or truncates) the file and writes the header.
+    /// @return False if the file could not be opened.
+    bool Open(const std::string& path);
+
+    /// Flushes and closes the file.
+    void Close();
+
+    /// Returns true if a file is open.
+    [[nodiscard]] bool IsOpen() const { return file != nullptr; }
+
+    /// Appends one record.
+    void Write(std::int64_t timestamp, LogCategory category, LogLevel level, const char* format,
+               const std::uint8_t* payload, std::uint16_t size, bool truncated);
+
+    /// Hands buffered entries to the operating system.
+    void Flush();
+
+private:
+    std::uint32_t FormatId(const char* format);
+
+    std::FILE* file = nullptr;
+    std::unordered_map<const char*, std::uint32_t> formatIds; ///< Keyed by the format's address.
+};
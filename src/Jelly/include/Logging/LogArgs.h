@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+/// Type tag stored in front of every encoded log argument.
+enum class LogArgType : std::uint8_t {
+    Bool,
+    Char,
+    Int,      ///< Any signed integer or enum, widened to int64.
+    UInt,     ///< Any unsigned integer, widened to uint64.
+    Double,   ///< float or double.
+    String,   ///< uint16 length followed by the bytes (no terminator).
+    Pointer   ///< Raw address, printed in hex.
+};
+
+/// Maximum number of argument bytes carried by a single log record.
+constexpr std::size_t MaxLogPayload = 216;
+
+/// Fixed-capacity buffer holding the binary-encoded arguments of one log call.
+/// Arguments that do not fit are dropped and the payload is marked as truncated.
+struct LogPayload {
+    std::uint8_t  data[MaxLogPayload];
+    std::uint16_t size      = 0;
+    bool          truncated = false;
+
+    /// Appends a tagged scalar.
+    void Write(LogArgType type, const void* value, std::size_t bytes) {
+        if (size + 1 + bytes > MaxLogPayload) {
+            truncated = true;
+            return;
+        }
+        data[size++] = static_cast<std::uint8_t>(type);
+        std::memcpy(data + size, value, bytes);
+        size = static_cast<std::uint16_t>(size + bytes);
+    }
+
+    /// Appends a tagged string, cutting it to whatever space is left.
+    void WriteString(std::string_view text) {
+        constexpr std::size_t header = 1 + sizeof(std::uint16_t);
+        if (size + header > MaxLogPayload) {
+            truncated = true;
+            return;
+        }
+
+        std::size_t length = text.size();
+        if (size + header + length > MaxLogPayload) {
+            length = MaxLogPayload - size - header;
+            truncated = true;
+        }
+
+        const auto length16 = static_cast<std::uint16_t>(length);
+        data[size++] = static_cast<std::uint8_t>(LogArgType::String);
+        std::memcpy(data + size, &length16, sizeof(length16));
+        std::memcpy(data + size + sizeof(length16), text.data(), length);
+        size = static_cast<std::uint16_t>(size + sizeof(length16) + length);
+    }
+};
+
+template <typename>
+inline constexpr bool UnsupportedLogArg = false;
+
+/// Encodes one argument into the payload without formatting it.
+template <typename T>
+void EncodeLogArg(LogPayload& payload, const T& value) {
+    using U = std::decay_t<T>;
+
+    if constexpr (std::is_same_v<U, bool>) {
+        const std::uint8_t v = value ? 1 : 0;
+        payload.Write(LogArgType::Bool, &v, sizeof(v));
+    } else if constexpr (std::is_same_v<U, char>) {
+        payload.Write(LogArgType::Char, &value, sizeof(value));
+    } else if constexpr (std::is_enum_v<U>) {
+        EncodeLogArg(payload, static_cast<std::underlying_type_t<U>>(value));
+    } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+        const std::int64_t v = value;
+        payload.Write(LogArgType::Int, &v, sizeof(v));
+    } else if constexpr (std::is_integral_v<U>) {
+        const std::uint64_t v = value;
+        payload.Write(LogArgType::UInt, &v, sizeof(v));
+    } else if constexpr (std::is_floating_point_v<U>) {
+        const double v = value;
+        payload.Write(LogArgType::Double, &v, sizeof(v));
+    } else if constexpr (std::is_array_v<T> && std::is_same_v<U, char*>) {
+        payload.WriteString(std::string_view(value));
+    } else if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+        payload.WriteString(value ? std::string_view(value) : std::string_view("(null)"));
+    } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+        payload.WriteString(std::string_view(value));
+    } else if constexpr (std::is_pointer_v<U>) {
+        const auto v = reinterpret_cast<std::uintptr_t>(value);
+        payload.Write(LogArgType::Pointer, &v, sizeof(v));
+    } else {
+        static_assert(UnsupportedLogArg<U>, "Unsupported log argument type");
+    }
+}
+
+/// Counts the "{}" placeholders in a format string; "{{" is an escaped brace.
+/// Used by JELLY_LOG to reject mismatched argument lists at compile time.
+constexpr std::size_t CountLogPlaceholders(const char* format) {
+    std::size_t count = 0;
+    for (std::size_t i = 0; format[i] != '\0'; ++i) {
+        if (format[i] != '{') {
+            continue;
+        }
+        if (format[i + 1] == '{') {
+            ++i;
+            continue;
+        }
+
+        ++count;
+        while (format[i] != '\0' && format[i] != '}') {
+            ++i;
+        }
+        if (format[i] == '\0') {
+            break;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Logger.h"
+
+/// Expands a format string with its binary-encoded arguments and appends the result to @p out.
+/// Supported placeholders are "{}" and "{:x}" (hex for integers); "{{" and "}}" print braces.
+/// @param out Destination string.
+/// @param format Format string the record was logged with.
+/// @param payload Encoded arguments (see LogPayload).
+/// @param size Number of payload bytes.
+/// @param truncated Whether the payload lost arguments or characters when it was encoded.
+void FormatLogMessage(std::string& out, const char* format, const std::uint8_t* payload, std::size_t size, bool truncated);
+
+/// Returns the tag printed in front of a message, e.g. "[WARN] ".
+const char* LogLevelTag(LogLevel level);
+
+/// Returns the category tag printed after the level tag, e.g. "[Vulkan] ".
+const char* LogCategoryTag(LogCategory category);
+
+/// Formats log timestamps as HH:MM:SS, calling into the C library only when the second changes.
+class LogTimestampCache {
+public:
+    /// @param unixNanoseconds Time since the Unix epoch in nanoseconds.
+    /// @return Null-terminated HH:MM:SS text, valid until the next call.
+    const char* Format(std::int64_t unixNanoseconds);
+
+private:
+    std::int64_t cachedSecond = -1;
+    char         text[9]      = {};
+};
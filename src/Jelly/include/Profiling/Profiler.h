@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/// Compiles the profiling macros in (1) or out (0); set through the JELLY_ENABLE_PROFILER CMake option.
+#ifndef JELLY_ENABLE_PROFILER
+#define JELLY_ENABLE_PROFILER 0
+#endif
+
+/// Low-overhead CPU zone profiler.
+///
+/// Each thread writes completed zones (name, begin, end) into its own fixed ring buffer, so
+/// recording is two clock reads and three relaxed stores with no locks or allocation. Zone
+/// names are string literals and are stored by address. Frame boundaries are marked with
+/// MarkFrame; WriteChromeTrace exports the zones of the last N frames as Chrome Trace Event
+/// JSON, which opens in Perfetto (ui.perfetto.dev) or chrome://tracing.
+class Profiler {
+public:
+    /// Returns the current profiler time in nanoseconds.
+    static std::int64_t Now();
+
+    /// Returns true while zones are being recorded.
+    static bool IsEnabled();
+
+    /// Starts or stops recording. Recording is on by default when the profiler is compiled in.
+    static void SetEnabled(bool enabled);
+
+    /// Records a completed zone on the calling thread.
+    /// @param name String literal naming the zone.
+    static void Record(const char* name, std::int64_t begin, std::int64_t end);
+
+    /// Names the calling thread in exported traces.
+    /// @param name String literal.
+    static void SetThreadName(const char* name);
+
+    /// Marks the start of a new frame.
+    static void MarkFrame();
+
+    /// Writes the zones of the last @p frames frames (at most the frames still buffered)
+    /// to @p path as Chrome Trace Event JSON.
+    /// @return False if the file could not be written.
+    static bool WriteChromeTrace(const std::string& path, std::uint32_t frames);
+};
+
+/// Records the enclosing scope as a zone. Use through JELLY_PROFILE_ZONE.
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) : name(name), begin(Profiler::Now()) {}
+    ~ProfileZone() { Profiler::Record(name, begin, Profiler::Now()); }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char*  name;
+    std::int64_t begin;
+};
+
+#define JELLY_PROFILE_CONCAT_INNER(a, b) a##b
+#define JELLY_PROFILE_CONCAT(a, b) JELLY_PROFILE_CONCAT_INNER(a, b)
+
+#if JELLY_ENABLE_PROFILER
+/// Profiles the rest of the enclosing scope under @p name, which must be a string literal.
+#define JELLY_PROFILE_ZONE(name) ProfileZone JELLY_PROFILE_CONCAT(jellyProfileZone, __LINE__)("" name)
+/// Marks the start of a frame.
+#define JELLY_PROFILE_FRAME() Profiler::MarkFrame()
+/// Names the calling thread; @p name must be a string literal.
+#define JELLY_PROFILE_THREAD(name) Profiler::SetThreadName("" name)
+#else
+#define JELLY_PROFILE_ZONE(name) do {} while (0)
+#define JELLY_PROFILE_FRAME() do {} while (0)
+#define JELLY_PROFILE_THREAD(name) do {} while (0)
+#endif
@@ -3,16 +3,24 @@
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
 
+#include <atomic>
+#include <thread>
+
 #include "IWindowSystem.h"
 #include "INativeWindowHandleProvider.h"
 
 /// GLFW-based implementation of IWindowSystem.
+///
+/// GLFW only allows window calls on the main thread, so the framebuffer size is cached on
+/// every poll and WaitEvents degrades to a short sleep elsewhere; both may then be used
+/// from a render thread.
 class GLFWindowSystem final : public IWindowSystem, public INativeWindowHandleProvider {
 public:
     void CreateWindow(const WindowSettings& settings) override;
     void ShowWindow() override;
     bool IsWindowOpen() override;
     void PollEvents() override;
+    const InputEventBuffer& GetInputEvents() const override { return inputEvents; }
     void DestroyWindow() override;
 
     void *GetNativeWindowHandle() override;
@@ -22,5 +30,12 @@ public:
     std::vector<const char*>GetVulkanRequiredExtensions() override;
 
 private:
-    GLFWwindow* window = nullptr; ///< Pointer to the GLFW window instance.
+    void InstallInputCallbacks();
+    void UpdateFramebufferSize();
+
+    GLFWwindow* window = nullptr;  ///< Pointer to the GLFW window instance.
+    InputEventBuffer inputEvents;  ///< Events received since the last poll.
+    std::thread::id mainThread;    ///< Thread that created the window.
+    std::atomic<uint32_t> framebufferWidth{0};   ///< Framebuffer size as of the last poll.
+    std::atomic<uint32_t> framebufferHeight{0};
 };
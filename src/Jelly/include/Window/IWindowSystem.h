@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+
+#include "InputEventBuffer.h"
 #include "WindowSettings.h"
 
 /// Interface for platform-specific window systems (e.g., GLFW, SDL).
@@ -17,8 +20,15 @@ public:
     virtual bool IsWindowOpen() = 0;
 
     /// Polls window system events (input, window resize, etc.).
+    /// Replaces the contents of the input event buffer with the events received.
     virtual void PollEvents() = 0;
 
+    /// Returns the input events collected by the last PollEvents call.
+    virtual const InputEventBuffer& GetInputEvents() const = 0;
+
+    /// Retrieves the size of the surface rendered to, in pixels.
+    virtual void GetFramebufferSize(uint32_t& width, uint32_t& height) = 0;
+
     /// Destroys the current window and releases associated resources.
     virtual void DestroyWindow() = 0;
 };
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+/// Kind of an InputEvent. Values are shared with managed code.
+enum class InputEventType : std::uint32_t {
+    Key          = 1,   ///< code = GLFW key, scancode in x; action = press/release/repeat.
+    Char         = 2,   ///< code = Unicode code point.
+    MouseButton  = 3,   ///< code = GLFW mouse button; action = press/release.
+    MouseMove    = 4,   ///< x, y = cursor position in screen coordinates.
+    Scroll       = 5,   ///< x, y = scroll offsets.
+    Resize       = 6    ///< x, y = new framebuffer width and height in pixels.
+};
+
+/// Fixed-size input record. The layout is part of the C API and mirrored by
+/// Jelly.Assembly.InputEvent, so managed code reads the buffer in place.
+struct InputEvent {
+    InputEventType type;
+    std::int32_t   code;     ///< Key, button or code point; 0 when unused.
+    std::int32_t   action;   ///< GLFW_PRESS, GLFW_RELEASE or GLFW_REPEAT; 0 when unused.
+    std::int32_t   mods;     ///< GLFW modifier bits; 0 when unused.
+    float          x;
+    float          y;
+};
+
+static_assert(sizeof(InputEvent) == 24, "InputEvent is mirrored by managed code and must stay 24 bytes");
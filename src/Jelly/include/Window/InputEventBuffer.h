@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "Window/InputEvent.h"
+
+/// Per-frame list of input events with fixed storage.
+///
+/// Window callbacks append records between polls; the storage never moves, so the
+/// pointer handed to managed code stays valid until the next Clear(). Events past the
+/// capacity are counted and dropped rather than reallocating mid-frame.
+class InputEventBuffer {
+public:
+    /// Default number of events kept per frame.
+    static constexpr std::uint32_t DefaultCapacity = 1024;
+
+    explicit InputEventBuffer(std::uint32_t capacity = DefaultCapacity)
+        : events(std::make_unique<InputEvent[]>(capacity)), capacity(capacity) {}
+
+    /// Appends an event, or counts it as dropped when the buffer is full.
+    void Push(const InputEvent& event) {
+        if (count < capacity) {
+            events[count++] = event;
+        } else {
+            ++dropped;
+        }
+    }
+
+    /// Forgets the events of the previous frame.
+    void Clear() {
+        count   = 0;
+        dropped = 0;
+    }
+
+    /// Returns the first event of the current frame.
+    [[nodiscard]] const InputEvent* Data() const { return events.get(); }
+
+    /// Returns the number of events of the current frame.
+    [[nodiscard]] std::uint32_t Size() const { return count; }
+
+    /// Returns how many events did not fit since the last Clear().
+    [[nodiscard]] std::uint32_t Dropped() const { return dropped; }
+
+private:
+    std::unique_ptr<InputEvent[]> events;
+    std::uint32_t capacity = 0;
+    std::uint32_t count    = 0;
+    std::uint32_t dropped  = 0;
+};
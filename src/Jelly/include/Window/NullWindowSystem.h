@@ -0,0 +1,29 @@
+#pragma once
+
+#include <atomic>
+
+#include "IWindowSystem.h"
+
+/// Window system for headless runs: no display connection, no input.
+///
+/// The "window" only remembers its size, which graphics APIs use for their offscreen
+/// targets, and stays open until DestroyWindow.
+class NullWindowSystem final : public IWindowSystem {
+public:
+    void CreateWindow(const WindowSettings& settings) override;
+    void ShowWindow() override {}
+    bool IsWindowOpen() override { return open; }
+    void PollEvents() override { inputEvents.Clear(); }
+    const InputEventBuffer& GetInputEvents() const override { return inputEvents; }
+    void DestroyWindow() override { open = false; }
+    void GetFramebufferSize(uint32_t& width, uint32_t& height) override;
+
+    /// Changes the size reported to the graphics API (at least 1x1).
+    void Resize(uint32_t width, uint32_t height);
+
+private:
+    std::atomic<uint32_t> width{0};   ///< Read by the render thread, if any.
+    std::atomic<uint32_t> height{0};
+    bool     open   = false;
+    InputEventBuffer inputEvents{0};  ///< Always empty.
+};
@@ -6,4 +6,6 @@ struct WindowSettings {
     int height;          ///< Height of the window in pixels.
     bool vsync;          ///< Whether VSync should be enabled.
     const char* title;   ///< Title of the window.
+    bool headless = false; ///< Render offscreen without creating a window (see NullWindowSystem).
+    unsigned framesInFlight = 2; ///< Frames the CPU may record ahead of the GPU (1 = lowest latency, 3 = throughput).
 };
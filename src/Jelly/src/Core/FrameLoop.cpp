@@ -0,0 +1,55 @@
+#include "Core/FrameLoop.h"
+
+#include <algorithm>
+
+// -----------------------------------------------------------------------------
+// Creates a loop that has not begun a frame yet.
+// -----------------------------------------------------------------------------
+FrameLoop::FrameLoop(double fixedStepSeconds, std::uint32_t maxStepsPerFrame)
+    : maxStepsPerFrame(std::max<std::uint32_t>(maxStepsPerFrame, 1)) {
+    timing.fixedStepSeconds = fixedStepSeconds > 0.0 ? fixedStepSeconds : 1.0 / 60.0;
+}
+
+// -----------------------------------------------------------------------------
+// Changes the simulation step; time already accumulated is kept.
+// -----------------------------------------------------------------------------
+void FrameLoop::SetFixedStep(double fixedStepSeconds) {
+    if (fixedStepSeconds > 0.0) {
+        timing.fixedStepSeconds = fixedStepSeconds;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Advances the accumulator by the clamped frame delta and drains it in whole steps.
+// -----------------------------------------------------------------------------
+const FrameTiming& FrameLoop::BeginFrame() {
+    const auto now = Clock::now();
+    double delta = 0.0;
+    if (lastFrame != Clock::time_point{}) {
+        delta = std::chrono::duration<double>(now - lastFrame).count();
+    }
+    lastFrame = now;
+
+    delta = std::min(delta, MaxDeltaSeconds);
+    accumulator += delta;
+
+    const double step = timing.fixedStepSeconds;
+    std::uint32_t steps = 0;
+    while (accumulator >= step && steps < maxStepsPerFrame) {
+        accumulator -= step;
+        ++steps;
+    }
+
+    timing.droppedSteps = 0;
+    if (accumulator >= step) {
+        timing.droppedSteps = static_cast<std::uint32_t>(accumulator / step);
+        accumulator -= timing.droppedSteps * step;
+    }
+
+    timing.frameIndex   = framesBegun++;
+    timing.deltaSeconds = delta;
+    timing.fixedSteps   = steps;
+    timing.totalSeconds += steps * step;
+    timing.alpha        = accumulator / step;
+    return timing;
+}
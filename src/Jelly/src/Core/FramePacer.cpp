@@ -0,0 +1,58 @@
+#include "Core/FramePacer.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+    /// Smallest and largest spin margins the pacer adapts between.
+    constexpr auto MinSpinMargin = std::chrono::microseconds(200);
+    constexpr auto MaxSpinMargin = std::chrono::microseconds(4000);
+}
+
+// -----------------------------------------------------------------------------
+// Sets the target frame rate and restarts the schedule.
+// -----------------------------------------------------------------------------
+void FramePacer::SetTargetFps(double fps) {
+    targetFps = fps > 0.0 ? fps : 0.0;
+    period = targetFps > 0.0
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFps))
+        : Clock::duration{0};
+    deadline = Clock::time_point{};
+}
+
+// -----------------------------------------------------------------------------
+// Sleeps until shortly before the deadline, spins the remainder and advances the deadline.
+// -----------------------------------------------------------------------------
+void FramePacer::WaitForNextFrame() {
+    if (period.count() == 0) {
+        return;
+    }
+
+    auto now = Clock::now();
+    if (deadline == Clock::time_point{} || now - deadline > period) {
+        deadline = now + period;
+        return;
+    }
+
+    const auto sleepUntil = deadline - spinMargin;
+    if (now < sleepUntil) {
+        std::this_thread::sleep_until(sleepUntil);
+        now = Clock::now();
+
+        // Widen the margin right away when a sleep overshoots it, and narrow it slowly
+        // when sleeps are accurate, so the spin phase stays as short as the OS allows.
+        const auto overshoot = now - sleepUntil;
+        if (overshoot > spinMargin / 2) {
+            spinMargin = std::min<Clock::duration>(overshoot * 2, MaxSpinMargin);
+        } else {
+            spinMargin = std::max<Clock::duration>(spinMargin - spinMargin / 16, MinSpinMargin);
+        }
+    }
+
+    while (now < deadline) {
+        std::this_thread::yield();
+        now = Clock::now();
+    }
+
+    deadline += period;
+}
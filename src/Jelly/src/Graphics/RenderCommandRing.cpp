@@ -0,0 +1,43 @@
+#include "Graphics/RenderCommandRing.h"
+
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t) &&
+              std::atomic<std::uint32_t>::is_always_lock_free,
+              "Ring indices are shared with managed code as plain 32-bit integers");
+
+// -----------------------------------------------------------------------------
+// Allocates the command slots, rounding the capacity up to a power of two.
+// -----------------------------------------------------------------------------
+RenderCommandRing::RenderCommandRing(std::uint32_t requested) {
+    capacity = 2;
+    while (capacity < requested) {
+        capacity <<= 1;
+    }
+
+    mask     = capacity - 1;
+    commands = std::make_unique<RenderCommand[]>(capacity);
+}
+
+// -----------------------------------------------------------------------------
+// Writes one command and publishes it. Must not race with another producer.
+// -----------------------------------------------------------------------------
+bool RenderCommandRing::TryPush(const RenderCommand& command) {
+    const std::uint32_t write = writeIndex.load(std::memory_order_relaxed);
+    if (write - readIndex.load(std::memory_order_acquire) >= capacity) {
+        return false;
+    }
+
+    commands[write & mask] = command;
+    writeIndex.store(write + 1, std::memory_order_release);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Exposes the slots and indices for a producer living outside the engine.
+// -----------------------------------------------------------------------------
+void RenderCommandRing::Describe(RenderCommandRingView& view) {
+    view.commands   = commands.get();
+    view.capacity   = capacity;
+    view.reserved   = 0;
+    view.writeIndex = reinterpret_cast<std::uint32_t*>(&writeIndex);
+    view.readIndex  = reinterpret_cast<const std::uint32_t*>(&readIndex);
+}
@@ -0,0 +1,62 @@
+#include "Graphics/RenderPacketQueue.h"
+
+#include <algorithm>
+
+// -----------------------------------------------------------------------------
+// Creates the packet slots.
+// -----------------------------------------------------------------------------
+RenderPacketQueue::RenderPacketQueue(std::uint32_t depth)
+    : packets(std::max(1u, depth)) {
+}
+
+// -----------------------------------------------------------------------------
+// Waits for a free packet. A packet is free once the render thread released it.
+// -----------------------------------------------------------------------------
+RenderPacket* RenderPacketQueue::BeginWrite() {
+    std::unique_lock<std::mutex> lock(mutex);
+    writable.wait(lock, [&] { return closed || written - read < packets.size(); });
+    return closed ? nullptr : &packets[written % packets.size()];
+}
+
+// -----------------------------------------------------------------------------
+// Publishes the packet being written.
+// -----------------------------------------------------------------------------
+void RenderPacketQueue::EndWrite() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++written;
+    }
+    readable.notify_one();
+}
+
+// -----------------------------------------------------------------------------
+// Waits for a submitted packet that has not been drawn yet.
+// -----------------------------------------------------------------------------
+RenderPacket* RenderPacketQueue::BeginRead() {
+    std::unique_lock<std::mutex> lock(mutex);
+    readable.wait(lock, [&] { return closed || read < written; });
+    return closed ? nullptr : &packets[read % packets.size()];
+}
+
+// -----------------------------------------------------------------------------
+// Releases the packet being drawn back to the producer.
+// -----------------------------------------------------------------------------
+void RenderPacketQueue::EndRead() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++read;
+    }
+    writable.notify_one();
+}
+
+// -----------------------------------------------------------------------------
+// Closes the queue and wakes any waiting thread.
+// -----------------------------------------------------------------------------
+void RenderPacketQueue::Close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+    }
+    writable.notify_all();
+    readable.notify_all();
+}
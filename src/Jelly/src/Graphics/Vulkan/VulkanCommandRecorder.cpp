@@ -0,0 +1,125 @@
+#include "Graphics/Vulkan/VulkanCommandRecorder.h"
+
+#include "Graphics/GraphicsApiException.h"
+#include "Jobs/JobSystem.h"
+#include "Profiling/Profiler.h"
+
+#include <algorithm>
+
+// -----------------------------------------------------------------------------
+// Creates one transient command pool per frame in flight and recording slot.
+// -----------------------------------------------------------------------------
+void VulkanCommandRecorder::Create(VkDevice device, std::uint32_t queueFamily, std::uint32_t framesInFlight,
+                                   std::uint32_t slots) {
+    Destroy();
+
+    this->device = device;
+    slotCount = std::max(1u, slots);
+    pools.resize(static_cast<std::size_t>(framesInFlight) * slotCount);
+
+    VkCommandPoolCreateInfo poolInfo{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = queueFamily;
+
+    for (SlotPool& slot : pools) {
+        if (vkCreateCommandPool(device, &poolInfo, nullptr, &slot.pool) != VK_SUCCESS) {
+            throw GraphicsApiException("Failed to create secondary command pool!");
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Destroys every pool; their command buffers are freed with them.
+// -----------------------------------------------------------------------------
+void VulkanCommandRecorder::Destroy() {
+    for (SlotPool& slot : pools) {
+        if (slot.pool != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(device, slot.pool, nullptr);
+        }
+    }
+    pools.clear();
+    recorded.clear();
+    slotCount = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Resets the frame's pools in one call each and makes their buffers reusable.
+// -----------------------------------------------------------------------------
+void VulkanCommandRecorder::ResetFrame(std::uint32_t frame) {
+    for (std::uint32_t i = 0; i < slotCount; ++i) {
+        SlotPool& slot = Slot(frame, i);
+        if (slot.used == 0) {
+            continue;
+        }
+
+        vkResetCommandPool(device, slot.pool, 0);
+        slot.used = 0;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Splits the items into slices, records each slice on a job and returns the
+// buffers in slice order.
+// -----------------------------------------------------------------------------
+const std::vector<VkCommandBuffer>& VulkanCommandRecorder::Record(JobSystem* jobs, std::uint32_t frame,
+                                                                  const VkCommandBufferInheritanceInfo& inheritance,
+                                                                  std::uint32_t count, std::uint32_t minItemsPerSlice,
+                                                                  RecordFunction function, void* context) {
+    JELLY_PROFILE_ZONE("Vulkan::RecordSecondary");
+
+    recorded.clear();
+    if (count == 0) {
+        return recorded;
+    }
+
+    minItemsPerSlice = std::max(1u, minItemsPerSlice);
+    const std::uint32_t maxSlices = std::min(slotCount, (count + minItemsPerSlice - 1) / minItemsPerSlice);
+    const std::uint32_t perSlice = (count + maxSlices - 1) / maxSlices;
+    const std::uint32_t slices = (count + perSlice - 1) / perSlice;
+
+    // Buffers are allocated here so allocation failures surface on the calling thread.
+    for (std::uint32_t i = 0; i < slices; ++i) {
+        recorded.push_back(Acquire(Slot(frame, i)));
+    }
+
+    auto recordSlice = [&](std::uint32_t first, std::uint32_t last) {
+        for (std::uint32_t i = first; i < last; ++i) {
+            VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+            beginInfo.pInheritanceInfo = &inheritance;
+
+            const std::uint32_t begin = i * perSlice;
+            const std::uint32_t end = std::min(count, begin + perSlice);
+
+            vkBeginCommandBuffer(recorded[i], &beginInfo);
+            function(context, recorded[i], begin, end);
+            vkEndCommandBuffer(recorded[i]);
+        }
+    };
+
+    if (jobs && slices > 1) {
+        jobs->ParallelFor(slices, 1, recordSlice);
+    } else {
+        recordSlice(0, slices);
+    }
+    return recorded;
+}
+
+// -----------------------------------------------------------------------------
+// Returns the slot's next unused buffer, allocating one when all are in use.
+// -----------------------------------------------------------------------------
+VkCommandBuffer VulkanCommandRecorder::Acquire(SlotPool& slot) {
+    if (slot.used == slot.buffers.size()) {
+        VkCommandBufferAllocateInfo allocInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+        allocInfo.commandPool = slot.pool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandBufferCount = 1;
+
+        VkCommandBuffer buffer = VK_NULL_HANDLE;
+        if (vkAllocateCommandBuffers(device, &allocInfo, &buffer) != VK_SUCCESS) {
+            throw GraphicsApiException("Failed to allocate secondary command buffer!");
+        }
+        slot.buffers.push_back(buffer);
+    }
+    return slot.buffers[slot.used++];
+}
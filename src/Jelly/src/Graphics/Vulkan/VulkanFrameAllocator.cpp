@@ -0,0 +1,139 @@
+#include "Graphics/Vulkan/VulkanFrameAllocator.h"
+
+#include "Logger.h"
+#include "Graphics/GraphicsApiException.h"
+
+#include <algorithm>
+
+namespace {
+    // -----------------------------------------------------------------------------
+    // Rounds @p value up to a multiple of @p alignment (a power of two).
+    // -----------------------------------------------------------------------------
+    VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Creates and maps the buffer holding every frame's segment.
+// -----------------------------------------------------------------------------
+void VulkanFrameAllocator::Create(VkDevice device, VulkanMemoryAllocator& allocator,
+                                  const VulkanDeviceCapabilities& capabilities, std::uint32_t frameCount,
+                                  VkDeviceSize frameSize) {
+    Destroy();
+
+    this->device = device;
+    this->allocator = &allocator;
+    this->frameCount = std::max(frameCount, 1u);
+
+    const VkPhysicalDeviceLimits& limits = capabilities.properties.limits;
+    atomSize = std::max<VkDeviceSize>(limits.nonCoherentAtomSize, 1);
+    defaultAlignment = std::max<VkDeviceSize>(
+        std::max(limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment), 16);
+
+    // Segments start on atom boundaries so flushing one never touches its neighbour.
+    this->frameSize = AlignUp(frameSize, std::max(atomSize, defaultAlignment));
+
+    VkBufferCreateInfo bufferInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    bufferInfo.size = this->frameSize * this->frameCount;
+    bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                       VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+        throw GraphicsApiException("Failed to create frame buffer!");
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device, buffer, &requirements);
+    requirements.alignment = std::max(requirements.alignment, atomSize);
+    requirements.size = AlignUp(requirements.size, atomSize);
+
+    // The GPU reads this every frame, so device-local host-visible memory is best where the
+    // device has it. Coherence is not required: Flush writes back the dirty range otherwise.
+    memory = allocator.Allocate(requirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                VulkanResourceTiling::Linear);
+    if (!memory || !memory->mapped || vkBindBufferMemory(device, buffer, memory->memory, memory->offset) != VK_SUCCESS) {
+        throw GraphicsApiException("Failed to allocate frame buffer memory!");
+    }
+    mapped = static_cast<std::uint8_t*>(memory->mapped);
+    coherent = (capabilities.memoryProperties.memoryTypes[memory->memoryType].propertyFlags &
+                VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+    frameStart = 0;
+    head.store(0, std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+// Destroys the buffer and returns its memory.
+// -----------------------------------------------------------------------------
+void VulkanFrameAllocator::Destroy() {
+    if (device == VK_NULL_HANDLE) {
+        return;
+    }
+
+    vkDestroyBuffer(device, buffer, nullptr);
+    allocator->Free(memory);
+
+    buffer = VK_NULL_HANDLE;
+    memory = nullptr;
+    mapped = nullptr;
+    allocator = nullptr;
+    device = VK_NULL_HANDLE;
+}
+
+// -----------------------------------------------------------------------------
+// Points the allocator at the segment of @p frame and rewinds it.
+// -----------------------------------------------------------------------------
+void VulkanFrameAllocator::BeginFrame(std::uint32_t frame) {
+    frameStart = static_cast<VkDeviceSize>(frame % frameCount) * frameSize;
+    head.store(frameStart, std::memory_order_relaxed);
+    exhausted.store(false, std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+// Bumps the head past an aligned range of @p size bytes.
+// -----------------------------------------------------------------------------
+VulkanFrameAllocation VulkanFrameAllocator::Allocate(VkDeviceSize size, VkDeviceSize alignment) {
+    VulkanFrameAllocation allocation;
+    if (!mapped || size == 0) {
+        return allocation;
+    }
+
+    const VkDeviceSize align = alignment ? alignment : defaultAlignment;
+    const VkDeviceSize frameEnd = frameStart + frameSize;
+
+    VkDeviceSize current = head.load(std::memory_order_relaxed);
+    VkDeviceSize offset;
+    do {
+        offset = AlignUp(current, align);
+        if (offset + size > frameEnd) {
+            if (!exhausted.exchange(true, std::memory_order_relaxed)) {
+                JELLY_LOG(LogCategory::Vulkan, LogLevel::Warning, "Frame allocator out of space ({} bytes per frame)",
+                          frameSize);
+            }
+            return allocation;
+        }
+    } while (!head.compare_exchange_weak(current, offset + size, std::memory_order_relaxed));
+
+    allocation.data = mapped + offset;
+    allocation.buffer = buffer;
+    allocation.offset = static_cast<std::uint32_t>(offset);
+    allocation.size = size;
+    return allocation;
+}
+
+// -----------------------------------------------------------------------------
+// Flushes the used part of the current segment when the memory is not coherent.
+// -----------------------------------------------------------------------------
+void VulkanFrameAllocator::Flush() {
+    const VkDeviceSize end = head.load(std::memory_order_relaxed);
+    if (coherent || end == frameStart) {
+        return;
+    }
+
+    VkMappedMemoryRange range{VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE};
+    range.memory = memory->memory;
+    range.offset = memory->offset + frameStart;
+    range.size = std::min(AlignUp(end - frameStart, atomSize), frameSize);
+    vkFlushMappedMemoryRanges(device, 1, &range);
+}
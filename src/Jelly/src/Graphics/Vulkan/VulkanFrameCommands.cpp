@@ -0,0 +1,147 @@
+#include "Graphics/Vulkan/VulkanFrameCommands.h"
+
+#include "Graphics/GraphicsApiException.h"
+#include "Profiling/Profiler.h"
+
+// -----------------------------------------------------------------------------
+// Creates a transient pool and a static pool per frame in flight.
+// -----------------------------------------------------------------------------
+void VulkanFrameCommands::Create(VkDevice device, std::uint32_t queueFamily, std::uint32_t framesInFlight) {
+    Destroy();
+
+    this->device = device;
+    frames.resize(framesInFlight);
+
+    // Neither pool allows resetting single buffers: transient buffers go back with the
+    // whole pool, stale cached ones are freed and allocated again.
+    VkCommandPoolCreateInfo poolInfo{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+    poolInfo.queueFamilyIndex = queueFamily;
+
+    for (FramePool& frame : frames) {
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        if (vkCreateCommandPool(device, &poolInfo, nullptr, &frame.pool) != VK_SUCCESS) {
+            throw GraphicsApiException("Failed to create command pool!");
+        }
+
+        poolInfo.flags = 0;
+        if (vkCreateCommandPool(device, &poolInfo, nullptr, &frame.staticPool) != VK_SUCCESS) {
+            throw GraphicsApiException("Failed to create static command pool!");
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Destroys every pool; their command buffers are freed with them.
+// -----------------------------------------------------------------------------
+void VulkanFrameCommands::Destroy() {
+    for (FramePool& frame : frames) {
+        if (frame.pool != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(device, frame.pool, nullptr);
+        }
+        if (frame.staticPool != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(device, frame.staticPool, nullptr);
+        }
+    }
+    frames.clear();
+    statics.clear();
+}
+
+// -----------------------------------------------------------------------------
+// Resets the frame's transient pool in one call and makes its buffers reusable.
+// -----------------------------------------------------------------------------
+void VulkanFrameCommands::ResetFrame(std::uint32_t frame) {
+    FramePool& pool = frames[frame];
+    if (pool.used == 0) {
+        return;
+    }
+
+    vkResetCommandPool(device, pool.pool, 0);
+    pool.used = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Returns the frame's next unused buffer, allocating one when all are in use.
+// -----------------------------------------------------------------------------
+VkCommandBuffer VulkanFrameCommands::Allocate(std::uint32_t frame) {
+    FramePool& pool = frames[frame];
+    if (pool.used == pool.buffers.size()) {
+        VkCommandBufferAllocateInfo allocInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+        allocInfo.commandPool = pool.pool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+
+        VkCommandBuffer buffer = VK_NULL_HANDLE;
+        if (vkAllocateCommandBuffers(device, &allocInfo, &buffer) != VK_SUCCESS) {
+            throw GraphicsApiException("Failed to allocate command buffer!");
+        }
+        pool.buffers.push_back(buffer);
+    }
+    return pool.buffers[pool.used++];
+}
+
+// -----------------------------------------------------------------------------
+// Returns the frame's copy of a cached pass, re-recording it when stale. The copy
+// can only be pending with this frame's fence, which the caller has waited on.
+// -----------------------------------------------------------------------------
+VkCommandBuffer VulkanFrameCommands::GetStatic(std::uint32_t frame, std::uint64_t key, VkCommandBufferLevel level,
+                                               const VkCommandBufferInheritanceInfo* inheritance,
+                                               RecordFunction function, void* context) {
+    StaticEntry& entry = statics[key];
+    if (entry.buffers.empty()) {
+        entry.buffers.assign(frames.size(), VK_NULL_HANDLE);
+        entry.recorded.assign(frames.size(), 0);
+    }
+
+    VkCommandBuffer& buffer = entry.buffers[frame];
+    if (buffer != VK_NULL_HANDLE && entry.recorded[frame] >= entry.invalidated &&
+        entry.recorded[frame] >= invalidatedAll) {
+        return buffer;
+    }
+
+    JELLY_PROFILE_ZONE("Vulkan::RecordStatic");
+
+    FramePool& pool = frames[frame];
+    if (buffer != VK_NULL_HANDLE) {
+        vkFreeCommandBuffers(device, pool.staticPool, 1, &buffer);
+        buffer = VK_NULL_HANDLE;
+    }
+
+    VkCommandBufferAllocateInfo allocInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+    allocInfo.commandPool = pool.staticPool;
+    allocInfo.level = level;
+    allocInfo.commandBufferCount = 1;
+
+    if (vkAllocateCommandBuffers(device, &allocInfo, &buffer) != VK_SUCCESS) {
+        throw GraphicsApiException("Failed to allocate static command buffer!");
+    }
+
+    VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    if (level == VK_COMMAND_BUFFER_LEVEL_SECONDARY) {
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        beginInfo.pInheritanceInfo = inheritance;
+    }
+
+    vkBeginCommandBuffer(buffer, &beginInfo);
+    function(context, buffer);
+    vkEndCommandBuffer(buffer);
+
+    entry.recorded[frame] = version;
+    return buffer;
+}
+
+// -----------------------------------------------------------------------------
+// Marks one cached pass as stale.
+// -----------------------------------------------------------------------------
+void VulkanFrameCommands::Invalidate(std::uint64_t key) {
+    auto it = statics.find(key);
+    if (it != statics.end()) {
+        it->second.invalidated = ++version;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Marks every cached pass as stale.
+// -----------------------------------------------------------------------------
+void VulkanFrameCommands::InvalidateAll() {
+    invalidatedAll = ++version;
+}
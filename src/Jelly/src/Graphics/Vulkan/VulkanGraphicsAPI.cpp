@@ -2,10 +2,55 @@
 
 #include "Logger.h"
 #include "Graphics/GraphicsApiException.h"
+#include "Jobs/JobSystem.h"
+#include "Profiling/Profiler.h"
 #include "Window/IWindowSystem.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
+
+namespace {
+    /// Below this many rects recording stays inline in the primary command buffer.
+    constexpr size_t ParallelRecordThreshold = 512;
+
+    /// Fewest rects a secondary command buffer is recorded with.
+    constexpr uint32_t RectsPerSlice = 256;
+
+    /// Static pass keys of the clear-only frame, one per image from this value on.
+    constexpr uint64_t ClearPassKey = uint64_t(1) << 32;
+
+    /// Longest WaitForPresent blocks, so a present the compositor holds back cannot stall input.
+    constexpr uint64_t PresentWaitTimeoutNs = 100'000'000;
+
+    /// Weight of the newest interval in the moving average of PresentStats.
+    constexpr double PresentIntervalSmoothing = 0.1;
+
+    const char* PresentModeName(PresentMode mode) {
+        switch (mode) {
+        case PresentMode::FifoRelaxed: return "FIFO relaxed";
+        case PresentMode::Mailbox:     return "mailbox";
+        case PresentMode::Immediate:   return "immediate";
+        default:                       return "FIFO";
+        }
+    }
+
+    /// Records a layout transition of a single-level color image.
+    void TransitionImage(VkCommandBuffer commandBuffer, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
+                         VkPipelineStageFlags srcStage, VkAccessFlags srcAccess,
+                         VkPipelineStageFlags dstStage, VkAccessFlags dstAccess) {
+        VkImageMemoryBarrier barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+        barrier.srcAccessMask = srcAccess;
+        barrier.dstAccessMask = dstAccess;
+        barrier.oldLayout = oldLayout;
+        barrier.newLayout = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = image;
+        barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    }
+}
 
 // -----------------------------------------------------------------------------
 // Disabled default initializer. Forces users to provide a window system for proper Vulkan setup.
@@ -18,24 +63,37 @@ void VulkanGraphicsAPI::Initialize()
 // -----------------------------------------------------------------------------
 // Initializes the Vulkan API using the provided window system.
 // This is the main entry point for setting up Vulkan and must be called before rendering.
+// Window systems without native handles get an offscreen image ring instead of a swapchain.
 // -----------------------------------------------------------------------------
 void VulkanGraphicsAPI::Initialize(IWindowSystem *windowSystem)
 {
-    windowProvider = dynamic_cast<INativeWindowHandleProvider*>(windowSystem);
-    if (!windowProvider) {
-        throw GraphicsApiException("Window system lacks native handle interface");
+    if (!windowSystem) {
+        throw GraphicsApiException("Vulkan needs a window system");
     }
 
+    // A window system without native handles (NullWindowSystem) selects offscreen rendering.
+    this->windowSystem = windowSystem;
+    windowProvider = dynamic_cast<INativeWindowHandleProvider*>(windowSystem);
+    headless = windowProvider == nullptr;
+
     CreateInstance();
-    CreateSurface();
+    if (!headless) {
+        CreateSurface();
+    }
     PickPhysicalDevice();
     CreateLogicalDevice();
-    CreateSwapChain();
+    memoryAllocator.Create(device, capabilities);
+    frameAllocator.Create(device, memoryAllocator, capabilities, framesInFlight);
+    uploader.Create(*this);
+    pipelineCache.Create(device, capabilities.properties, VulkanPipelineCache::DefaultDirectory());
+    pipelines.Create(device, pipelineCache.Get(), jobSystem);
+    CreateSwapChain(VK_NULL_HANDLE);
     CreateImageViews();
-    CreateRenderPass();
-    CreateFramebuffers();
+    if (!dynamicRendering) {
+        CreateRenderPass();
+        CreateFramebuffers();
+    }
     CreateCommandPool();
-    CreateCommandBuffers();
     CreateSyncObjects();
 }
 
@@ -43,7 +101,30 @@ void VulkanGraphicsAPI::Initialize(IWindowSystem *windowSystem)
 // Creates the Vulkan instance, which is the base of the Vulkan context.
 // -----------------------------------------------------------------------------
 void VulkanGraphicsAPI::CreateInstance() {
-    std::vector<const char*> extensions = windowProvider->GetVulkanRequiredExtensions();
+    std::vector<const char*> extensions;
+    if (!headless) {
+        extensions = windowProvider->GetVulkanRequiredExtensions();
+    }
+
+    // Vulkan 1.0 device extensions such as VK_KHR_timeline_semaphore depend on this one.
+    uint32_t availableCount = 0;
+    vkEnumerateInstanceExtensionProperties(nullptr, &availableCount, nullptr);
+    std::vector<VkExtensionProperties> available(availableCount);
+    vkEnumerateInstanceExtensionProperties(nullptr, &availableCount, available.data());
+    for (const VkExtensionProperties& extension : available) {
+        if (std::strcmp(extension.extensionName, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) == 0) {
+            extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+            physicalDeviceProperties2 = true;
+        }
+    }
+
+    // Ask for 1.3, where dynamic rendering is core, but never for more than the loader
+    // implements: a 1.0 loader fails instance creation for any higher version.
+    uint32_t loaderVersion = VK_API_VERSION_1_0;
+    if (vkEnumerateInstanceVersion(&loaderVersion) != VK_SUCCESS) {
+        loaderVersion = VK_API_VERSION_1_0;
+    }
+    instanceApiVersion = std::min<uint32_t>(loaderVersion, VK_API_VERSION_1_3);
 
     VkApplicationInfo appInfo{};
     appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
@@ -51,7 +132,7 @@ void VulkanGraphicsAPI::CreateInstance() {
     appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
     appInfo.pEngineName = "Jelly Engine";
     appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-    appInfo.apiVersion = VK_API_VERSION_1_0;
+    appInfo.apiVersion = instanceApiVersion;
 
     VkInstanceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -65,16 +146,12 @@ void VulkanGraphicsAPI::CreateInstance() {
         throw GraphicsApiException("Failed to create Vulkan instance!");
     }
 
-    uint32_t apiVersion = 0;
-    if (vkEnumerateInstanceVersion(&apiVersion) == VK_SUCCESS) {
-        char message[128];
-        snprintf(message, sizeof(message),
-                "Vulkan instance created (API version %u.%u.%u)",
-                VK_VERSION_MAJOR(apiVersion),
-                VK_VERSION_MINOR(apiVersion),
-                VK_VERSION_PATCH(apiVersion));
-        Logger::Log(LogLevel::Info, message);
-    }
+    JELLY_LOG(LogCategory::Vulkan, LogLevel::Info, "Vulkan instance created (API version {}.{}, loader {}.{}.{})",
+              VK_VERSION_MAJOR(instanceApiVersion),
+              VK_VERSION_MINOR(instanceApiVersion),
+              VK_VERSION_MAJOR(loaderVersion),
+              VK_VERSION_MINOR(loaderVersion),
+              VK_VERSION_PATCH(loaderVersion));
 }
 
 // -----------------------------------------------------------------------------
@@ -102,30 +179,20 @@ void VulkanGraphicsAPI::PickPhysicalDevice() {
     vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
 
     for (const auto &device : devices) {
-        QueueFamilyIndices indices = FindQueueFamilies(device, surface);
+        VulkanDeviceCapabilities candidate = QueryDeviceCapabilities(device, surface);
+        const QueueFamilyIndices& indices = candidate.queueFamilies;
 
-        bool extensionsSupported = false;
-        {
-            uint32_t extCount = 0;
-            vkEnumerateDeviceExtensionProperties(device, nullptr, &extCount, nullptr);
-            std::vector<VkExtensionProperties> availableExtensions(extCount);
-            vkEnumerateDeviceExtensionProperties(device, nullptr, &extCount, availableExtensions.data());
-
-            std::set<std::string> requiredExtensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
-            for (const auto &ext : availableExtensions)
-                requiredExtensions.erase(ext.extensionName);
-
-            extensionsSupported = requiredExtensions.empty();
-        }
+        const bool extensionsSupported = headless || candidate.HasExtension(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
 
-        bool swapchainAdequate = false;
-        if (extensionsSupported) {
+        bool swapchainAdequate = headless;
+        if (extensionsSupported && !headless) {
             SwapChainSupportDetails swapChainSupport = QuerySwapChainSupport(device, surface);
             swapchainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
         }
 
         if (indices.IsComplete() && extensionsSupported && swapchainAdequate) {
             physicalDevice = device;
+            capabilities = std::move(candidate);
             break;
         }
     }
@@ -133,17 +200,28 @@ void VulkanGraphicsAPI::PickPhysicalDevice() {
     if (physicalDevice == VK_NULL_HANDLE) {
         throw GraphicsApiException("Failed to find a suitable GPU with Vulkan support and swapchain capabilities!");
     }
+
+    const QueueFamilyIndices& families = capabilities.queueFamilies;
+    JELLY_LOG(LogCategory::Vulkan, LogLevel::Info,
+              "Using {} (dedicated transfer queue: {}, async compute queue: {}, timeline semaphores: {})",
+              capabilities.properties.deviceName, families.transferFamily.has_value(),
+              families.computeFamily.has_value(),
+              physicalDeviceProperties2 && capabilities.HasExtension(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME));
 }
 
 // -----------------------------------------------------------------------------
 // Creates a logical device and retrieves queue handles for graphics and presentation.
 // -----------------------------------------------------------------------------
 void VulkanGraphicsAPI::CreateLogicalDevice() {
-    QueueFamilyIndices indices = FindQueueFamilies(physicalDevice, surface);
+    const QueueFamilyIndices& indices = capabilities.queueFamilies;
+    const uint32_t graphicsFamily = indices.graphicsFamily.value();
 
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-    std::set<uint32_t> uniqueFamilies = {
-        indices.graphicsFamily.value(), indices.presentFamily.value()};
+    std::set<uint32_t> uniqueFamilies = {graphicsFamily, indices.presentFamily.value()};
+    if (indices.transferFamily)
+        uniqueFamilies.insert(indices.transferFamily.value());
+    if (indices.computeFamily)
+        uniqueFamilies.insert(indices.computeFamily.value());
 
     float queuePriority = 1.0f;
     for (uint32_t family : uniqueFamilies) {
@@ -163,33 +241,155 @@ void VulkanGraphicsAPI::CreateLogicalDevice() {
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
     createInfo.pEnabledFeatures = &deviceFeatures;
 
-    const char *extensions[] = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
-    createInfo.enabledExtensionCount = 1;
-    createInfo.ppEnabledExtensionNames = extensions;
+    std::vector<const char*> extensions;
+    if (!headless)
+        extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+
+    // Every implementation of the extension supports the feature, so it only needs enabling.
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineFeatures{};
+    timelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+    timelineFeatures.timelineSemaphore = VK_TRUE;
+    timelineSemaphores = physicalDeviceProperties2 && capabilities.HasExtension(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+    if (timelineSemaphores) {
+        extensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+    }
+
+    // Optional features need their extension and the feature bit, and only the driver knows
+    // the latter, so the candidates are queried in one chain and only the supported ones enabled.
+    VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures{};
+    presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+    VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{};
+    presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures{};
+    dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+
+    presentWait = !headless && physicalDeviceProperties2 &&
+                  capabilities.HasExtension(VK_KHR_PRESENT_ID_EXTENSION_NAME) &&
+                  capabilities.HasExtension(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+
+    // The extension's dependencies are core from 1.2, so older devices keep the render pass.
+    const uint32_t deviceApiVersion = std::min(instanceApiVersion, capabilities.properties.apiVersion);
+    const bool dynamicRenderingCore = deviceApiVersion >= VK_API_VERSION_1_3;
+    dynamicRendering = dynamicRenderingCore || (deviceApiVersion >= VK_API_VERSION_1_2 &&
+                                                capabilities.HasExtension(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME));
+
+    if (presentWait || dynamicRendering) {
+        // Core from 1.1; older instances only have the extension's entry point.
+        auto getFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(vkGetInstanceProcAddr(
+            instance, instanceApiVersion >= VK_API_VERSION_1_1 ? "vkGetPhysicalDeviceFeatures2"
+                                                               : "vkGetPhysicalDeviceFeatures2KHR"));
+
+        VkPhysicalDeviceFeatures2KHR query{};
+        query.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+        query.pNext = &presentIdFeatures;
+        presentIdFeatures.pNext = &presentWaitFeatures;
+        presentWaitFeatures.pNext = &dynamicRenderingFeatures;
+        if (getFeatures2) {
+            getFeatures2(physicalDevice, &query);
+        }
+        presentWait = presentWait && presentIdFeatures.presentId && presentWaitFeatures.presentWait;
+        dynamicRendering = dynamicRendering && dynamicRenderingFeatures.dynamicRendering;
+    }
+
+    void* enabledFeatures = timelineSemaphores ? &timelineFeatures : nullptr;
+    if (presentWait) {
+        extensions.push_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+        extensions.push_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+        presentWaitFeatures.pNext = enabledFeatures;
+        presentIdFeatures.pNext = &presentWaitFeatures;
+        enabledFeatures = &presentIdFeatures;
+    }
+    if (dynamicRendering) {
+        if (!dynamicRenderingCore)
+            extensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+        dynamicRenderingFeatures.pNext = enabledFeatures;
+        enabledFeatures = &dynamicRenderingFeatures;
+    }
+    createInfo.pNext = enabledFeatures;
+
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    createInfo.ppEnabledExtensionNames = extensions.empty() ? nullptr : extensions.data();
 
     if (vkCreateDevice(physicalDevice, &createInfo, nullptr, &device) != VK_SUCCESS) {
         throw GraphicsApiException("Failed to create logical device!");
     }
 
-    vkGetDeviceQueue(device, indices.graphicsFamily.value(), 0, &graphicsQueue);
+    if (timelineSemaphores) {
+        getSemaphoreCounterValue = reinterpret_cast<PFN_vkGetSemaphoreCounterValueKHR>(
+            vkGetDeviceProcAddr(device, "vkGetSemaphoreCounterValueKHR"));
+        waitSemaphores = reinterpret_cast<PFN_vkWaitSemaphoresKHR>(
+            vkGetDeviceProcAddr(device, "vkWaitSemaphoresKHR"));
+        timelineSemaphores = getSemaphoreCounterValue != nullptr && waitSemaphores != nullptr;
+    }
+
+    if (presentWait) {
+        waitForPresent = reinterpret_cast<PFN_vkWaitForPresentKHR>(vkGetDeviceProcAddr(device, "vkWaitForPresentKHR"));
+        presentWait = waitForPresent != nullptr;
+    }
+
+    if (dynamicRendering) {
+        cmdBeginRendering = reinterpret_cast<PFN_vkCmdBeginRenderingKHR>(vkGetDeviceProcAddr(
+            device, dynamicRenderingCore ? "vkCmdBeginRendering" : "vkCmdBeginRenderingKHR"));
+        cmdEndRendering = reinterpret_cast<PFN_vkCmdEndRenderingKHR>(vkGetDeviceProcAddr(
+            device, dynamicRenderingCore ? "vkCmdEndRendering" : "vkCmdEndRenderingKHR"));
+        dynamicRendering = cmdBeginRendering != nullptr && cmdEndRendering != nullptr;
+    }
+    JELLY_LOG(LogCategory::Vulkan, LogLevel::Info, "Recording frames with {}",
+              dynamicRendering ? (dynamicRenderingCore ? "dynamic rendering" : "VK_KHR_dynamic_rendering")
+                               : "a render pass");
+
+    vkGetDeviceQueue(device, graphicsFamily, 0, &graphicsQueue);
     vkGetDeviceQueue(device, indices.presentFamily.value(), 0, &presentQueue);
+
+    // Missing dedicated families fall back to the graphics queue.
+    const uint32_t slotFamilies[] = {graphicsFamily, indices.computeFamily.value_or(graphicsFamily),
+                                     indices.transferFamily.value_or(graphicsFamily)};
+    for (size_t i = 0; i < static_cast<size_t>(VulkanQueueType::Count); ++i) {
+        queues[i].family = slotFamilies[i];
+        vkGetDeviceQueue(device, slotFamilies[i], 0, &queues[i].queue);
+    }
+
+    // vkQueueSubmit and vkQueuePresentKHR need external synchronization per VkQueue,
+    // so slots on the same queue share one lock.
+    auto lockFor = [this](VkQueue queue, size_t fallback) {
+        for (const QueueSlot& slot : queues) {
+            if (slot.lock && slot.queue == queue)
+                return slot.lock;
+        }
+        return &queueLocks[fallback];
+    };
+    for (size_t i = 0; i < static_cast<size_t>(VulkanQueueType::Count); ++i) {
+        queues[i].lock = lockFor(queues[i].queue, i);
+    }
+    presentLock = lockFor(presentQueue, static_cast<size_t>(VulkanQueueType::Count));
+
+    uniqueQueueFamilies.assign(uniqueFamilies.begin(), uniqueFamilies.end());
 }
 
 // -----------------------------------------------------------------------------
 // Creates the swapchain, which manages the images to be presented to the screen.
+// The caller owns oldSwapchain and retires it; the member is only set on success.
 // -----------------------------------------------------------------------------
-void VulkanGraphicsAPI::CreateSwapChain() {
+void VulkanGraphicsAPI::CreateSwapChain(VkSwapchainKHR oldSwapchain) {
+    // The swapchain built here applies any pending present mode request.
+    presentModeChanged.store(false);
+
+    if (headless) {
+        CreateOffscreenTargets();
+        return;
+    }
+
     SwapChainSupportDetails support = QuerySwapChainSupport(physicalDevice, surface);
 
     VkSurfaceFormatKHR surfaceFmt = ChooseSurfaceFormat(support.formats);
-    VkPresentModeKHR present = ChoosePresentMode(support.presentModes);
+    const PresentMode requested = requestedPresentMode.load();
+    const PresentMode present = ChoosePresentMode(support.presentModes, requested);
     VkExtent2D extent = ChooseSwapExtent(support.capabilities, windowProvider);
 
-    uint32_t imageCount = support.capabilities.minImageCount + 1;
-    if (support.capabilities.maxImageCount &&
-        imageCount > support.capabilities.maxImageCount) {
-        imageCount = support.capabilities.maxImageCount;
-    }
+    const bool changed = oldSwapchain == VK_NULL_HANDLE || present != activePresentMode ||
+                         requestedLowLatency.load() != lowLatency;
+    lowLatency = requestedLowLatency.load();
+    uint32_t imageCount = ChooseImageCount(support.capabilities, present, lowLatency);
 
     VkSwapchainCreateInfoKHR sci{};
     sci.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
@@ -201,7 +401,7 @@ void VulkanGraphicsAPI::CreateSwapChain() {
     sci.imageArrayLayers = 1;
     sci.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
 
-    QueueFamilyIndices idx = FindQueueFamilies(physicalDevice, surface);
+    const QueueFamilyIndices& idx = capabilities.queueFamilies;
     uint32_t qfams[] = {idx.graphicsFamily.value(), idx.presentFamily.value()};
 
     if (idx.graphicsFamily != idx.presentFamily) {
@@ -215,12 +415,17 @@ void VulkanGraphicsAPI::CreateSwapChain() {
 
     sci.preTransform = support.capabilities.currentTransform;
     sci.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-    sci.presentMode = present;
+    sci.presentMode = ToVkPresentMode(present);
     sci.clipped = VK_TRUE;
+    // Handing over the previous swapchain lets the driver reuse its resources and keep
+    // presenting it until the new one takes over.
+    sci.oldSwapchain = oldSwapchain;
 
-    if (vkCreateSwapchainKHR(device, &sci, nullptr, &swapchain) != VK_SUCCESS) {
+    VkSwapchainKHR created = VK_NULL_HANDLE;
+    if (vkCreateSwapchainKHR(device, &sci, nullptr, &created) != VK_SUCCESS) {
         throw GraphicsApiException("Failed to create swapchain");
     }
+    swapchain = created;
 
     swapchainImageFormat = surfaceFmt.format;
     swapchainExtent = extent;
@@ -229,6 +434,74 @@ void VulkanGraphicsAPI::CreateSwapChain() {
     vkGetSwapchainImagesKHR(device, swapchain, &count, nullptr);
     swapchainImages.resize(count);
     vkGetSwapchainImagesKHR(device, swapchain, &count, swapchainImages.data());
+
+    if (changed)
+    {
+        JELLY_LOG(LogCategory::Vulkan, LogLevel::Info, "Presenting with {} ({} requested), {} image(s){}",
+                  PresentModeName(present), PresentModeName(requested), count,
+                  lowLatency ? (presentWait ? ", low latency with present wait" : ", low latency") : "");
+    }
+
+    std::lock_guard<std::mutex> lock(statsLock);
+    activePresentMode = present;
+    presentStats.mode = static_cast<uint32_t>(present);
+    presentStats.onDisplay = lowLatency && presentWait ? 1 : 0;
+}
+
+// -----------------------------------------------------------------------------
+// Creates the offscreen ring that stands in for the swapchain in headless mode: one
+// device-local color image per frame in flight, sized like the null window.
+// -----------------------------------------------------------------------------
+void VulkanGraphicsAPI::CreateOffscreenTargets() {
+    uint32_t width = 0, height = 0;
+    windowSystem->GetFramebufferSize(width, height);
+
+    swapchainImageFormat = VK_FORMAT_R8G8B8A8_UNORM;
+    swapchainExtent = {std::max(width, 1u), std::max(height, 1u)};
+
+    swapchainImages.assign(framesInFlight, VK_NULL_HANDLE);
+    offscreenMemory.assign(framesInFlight, nullptr);
+
+    for (size_t i = 0; i < swapchainImages.size(); ++i) {
+        VkImageCreateInfo ici{VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+        ici.imageType = VK_IMAGE_TYPE_2D;
+        ici.format = swapchainImageFormat;
+        ici.extent = {swapchainExtent.width, swapchainExtent.height, 1};
+        ici.mipLevels = 1;
+        ici.arrayLayers = 1;
+        ici.samples = VK_SAMPLE_COUNT_1_BIT;
+        ici.tiling = VK_IMAGE_TILING_OPTIMAL;
+        ici.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        ici.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        ici.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        if (vkCreateImage(device, &ici, nullptr, &swapchainImages[i]) != VK_SUCCESS) {
+            throw GraphicsApiException("Failed to create offscreen image!");
+        }
+
+        offscreenMemory[i] = memoryAllocator.AllocateForImage(swapchainImages[i], VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        if (!offscreenMemory[i]) {
+            throw GraphicsApiException("Failed to allocate offscreen image memory!");
+        }
+    }
+
+    JELLY_LOG(LogCategory::Vulkan, LogLevel::Info, "Rendering offscreen to {} image(s) of {}x{}",
+              swapchainImages.size(), swapchainExtent.width, swapchainExtent.height);
+}
+
+// -----------------------------------------------------------------------------
+// Destroys the offscreen images and their memory.
+// -----------------------------------------------------------------------------
+void VulkanGraphicsAPI::DestroyOffscreenTargets() {
+    for (VkImage image : swapchainImages) {
+        vkDestroyImage(device, image, nullptr);
+    }
+    swapchainImages.clear();
+
+    for (VulkanAllocation* allocation : offscreenMemory) {
+        memoryAllocator.Free(allocation);
+    }
+    offscreenMemory.clear();
 }
 
 // -----------------------------------------------------------------------------
@@ -267,7 +540,8 @@ void VulkanGraphicsAPI::CreateRenderPass() {
     colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    // Offscreen images end up ready for readback instead of presentation.
+    colorAttachment.finalLayout = headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
     VkAttachmentReference colorAttachmentRef{};
     colorAttachmentRef.attachment = 0;
@@ -317,109 +591,137 @@ void VulkanGraphicsAPI::CreateFramebuffers() {
 }
 
 // -----------------------------------------------------------------------------
-// Creates a command pool from which command buffers will be allocated.
+// Creates the command pools of every frame in flight, for primary and secondary buffers.
 // -----------------------------------------------------------------------------
 void VulkanGraphicsAPI::CreateCommandPool() {
-    QueueFamilyIndices queueFamilyIndices = FindQueueFamilies(physicalDevice, surface);
-
-    VkCommandPoolCreateInfo poolInfo {};
-    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-    poolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
+    const QueueFamilyIndices& queueFamilyIndices = capabilities.queueFamilies;
 
-    if (vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {
-        throw GraphicsApiException("Failed to create command pool!");
-    }
-}
+    frameCommands.Create(device, queueFamilyIndices.graphicsFamily.value(), framesInFlight);
 
-// -----------------------------------------------------------------------------
-// Allocates and prepares command buffers used to record rendering commands.
-// -----------------------------------------------------------------------------
-void VulkanGraphicsAPI::CreateCommandBuffers() {
-    if (!commandBuffers.empty()) {
-        vkFreeCommandBuffers(device, commandPool, static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data());
-        commandBuffers.clear();
-    }
-
-    commandBuffers.resize(swapchainImages.size());
-
-    VkCommandBufferAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.commandPool = commandPool;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
-
-    if (vkAllocateCommandBuffers(device, &allocInfo, commandBuffers.data()) != VK_SUCCESS) {
-        throw GraphicsApiException("Failed to allocate command buffers!");
-    }
+    const uint32_t recordSlots = jobSystem ? jobSystem->GetThreadCount() : 1;
+    secondaryRecorder.Create(device, queueFamilyIndices.graphicsFamily.value(), framesInFlight, recordSlots);
 }
 
 // -----------------------------------------------------------------------------
-// Creates synchronization objects such as semaphores and fences to coordinate rendering.
+// Creates the per-frame semaphores and the frame timeline, or a fence per frame in
+// flight when timeline semaphores are unavailable.
 // -----------------------------------------------------------------------------
 void VulkanGraphicsAPI::CreateSyncObjects() {
-    for (VkFence f : inFlightFences) {
-        if (f) {
-            vkDestroyFence(device, f, nullptr);
-        }
-    }
-
-    for (VkSemaphore s : imageAvailableSemaphores)
-        if (s)
-            vkDestroySemaphore(device, s, nullptr);
-    for (VkSemaphore s : renderFinishedSemaphores)
-        if (s)
-            vkDestroySemaphore(device, s, nullptr);
-
-    inFlightFences.clear();
-    imageAvailableSemaphores.clear();
-    renderFinishedSemaphores.clear();
+    imageAvailableSemaphores.resize(framesInFlight, VK_NULL_HANDLE);
+    renderFinishedSemaphores.resize(framesInFlight, VK_NULL_HANDLE);
 
-    // 2) Redimensiona corretamente
-    inFlightFences.resize(MAX_FRAMES_IN_FLIGHT, VK_NULL_HANDLE);
-    imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT, VK_NULL_HANDLE);
-    renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT, VK_NULL_HANDLE);
-
-    // 3) Infos de criação
     VkSemaphoreCreateInfo semInfo{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
-    VkFenceCreateInfo fenceInfo{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
-    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-
-    // 4) Use o tamanho real dos vetores para iterar
-    for (std::size_t i = 0; i < inFlightFences.size(); ++i)
+    for (uint32_t i = 0; i < framesInFlight; ++i)
     {
         if (vkCreateSemaphore(device, &semInfo, nullptr, &imageAvailableSemaphores[i]) != VK_SUCCESS ||
-            vkCreateSemaphore(device, &semInfo, nullptr, &renderFinishedSemaphores[i]) != VK_SUCCESS ||
-            vkCreateFence(device, &fenceInfo, nullptr, &inFlightFences[i]) != VK_SUCCESS)
+            vkCreateSemaphore(device, &semInfo, nullptr, &renderFinishedSemaphores[i]) != VK_SUCCESS)
         {
             throw GraphicsApiException("Failed to create sync objects!");
         }
     }
+
+    if (timelineSemaphores)
+    {
+        VkSemaphoreTypeCreateInfoKHR typeInfo{};
+        typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+        typeInfo.initialValue = 0;
+
+        VkSemaphoreCreateInfo timelineInfo{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+        timelineInfo.pNext = &typeInfo;
+        if (vkCreateSemaphore(device, &timelineInfo, nullptr, &frameTimeline) != VK_SUCCESS)
+        {
+            throw GraphicsApiException("Failed to create frame timeline semaphore!");
+        }
+    }
+    else
+    {
+        // Created signaled so the first wait on every slot returns at once.
+        VkFenceCreateInfo fenceInfo{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+        fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+        frameFences.resize(framesInFlight, VK_NULL_HANDLE);
+        fenceFrames.assign(framesInFlight, 0);
+        for (VkFence& fence : frameFences)
+        {
+            if (vkCreateFence(device, &fenceInfo, nullptr, &fence) != VK_SUCCESS)
+            {
+                throw GraphicsApiException("Failed to create sync objects!");
+            }
+        }
+    }
+
+    JELLY_LOG(LogCategory::Vulkan, LogLevel::Info, "Frame sync: {}, {} frame(s) in flight",
+              timelineSemaphores ? "timeline semaphore" : "fences", framesInFlight);
 }
 
 // -----------------------------------------------------------------------------
-// Begins the frame by waiting for the previous frame to finish, acquiring the next image from the swapchain,
-// and recording rendering commands into the appropriate command buffer.
+// Begins the frame by waiting for the frame that last used this slot to finish, acquiring the next image
+// from the swapchain, and recording rendering commands into the appropriate command buffer.
+// Returns false without blocking when the window is minimized.
 // -----------------------------------------------------------------------------
-void VulkanGraphicsAPI::BeginFrame()
+bool VulkanGraphicsAPI::BeginFrame()
 {
-    // Aguarda o frame atual terminar
-    vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
-    vkResetFences(device, 1, &inFlightFences[currentFrame]);
+    JELLY_PROFILE_ZONE("Vulkan::BeginFrame");
+
+    // Only the frame framesInFlight back shares this slot's allocator segment and pools.
+    const uint64_t frame = GetFrameNumber();
+    if (frame > framesInFlight)
+    {
+        JELLY_PROFILE_ZONE("Vulkan::WaitForFrame");
+        WaitForFrame(frame - framesInFlight);
+    }
+    RefreshCompletedFrame();
+
+    // The wait covers everything the frame read from its segment of the frame allocator.
+    frameAllocator.BeginFrame(static_cast<uint32_t>(currentFrame));
+    uploader.BeginFrame();
+    DestroyRetiredTargets(false);
+
+    // Rebuild targets up front when the size change was reported rather than discovered,
+    // and keep probing while minimized until the window has an area again. A swapchain
+    // whose recreation failed is retried as well.
+    const bool lostSwapchain = !headless && swapchain == VK_NULL_HANDLE;
+    if (framebufferResized.exchange(false) | presentModeChanged.load() || minimized || lostSwapchain)
+    {
+        if (!RecreateSwapChain())
+        {
+            pendingRects.clear();
+            return false;
+        }
+    }
+
+    // The frame's command buffers finished with the wait, so their pools can be recycled.
+    frameCommands.ResetFrame(static_cast<uint32_t>(currentFrame));
+    secondaryRecorder.ResetFrame(static_cast<uint32_t>(currentFrame));
+
+    // Headless frames render into the offscreen image owned by this frame in flight.
+    if (headless)
+    {
+        currentImageIndex = static_cast<uint32_t>(currentFrame);
+        RecordCommandBuffer(currentImageIndex);
+        return true;
+    }
 
     // Adquire imagem do swapchain
-    VkResult result = vkAcquireNextImageKHR(
-        device,
-        swapchain,
-        UINT64_MAX,
-        imageAvailableSemaphores[currentFrame], // sinaliza quando a imagem estiver disponível
-        VK_NULL_HANDLE,
-        &currentImageIndex);
+    VkResult result;
+    {
+        JELLY_PROFILE_ZONE("Vulkan::AcquireImage");
+        result = vkAcquireNextImageKHR(
+            device,
+            swapchain,
+            UINT64_MAX,
+            imageAvailableSemaphores[currentFrame], // sinaliza quando a imagem estiver disponível
+            VK_NULL_HANDLE,
+            &currentImageIndex);
+    }
 
+    // Nothing was signaled, so the frame is dropped before it takes a number.
     if (result == VK_ERROR_OUT_OF_DATE_KHR)
     {
-        RecreateSwapChain();
-        return;
+        pendingRects.clear();
+        framebufferResized.store(true);
+        return false;
     }
     else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
     {
@@ -427,7 +729,8 @@ void VulkanGraphicsAPI::BeginFrame()
     }
 
     // Grava comandos de renderização
-    RecordCommandBuffer(commandBuffers[currentImageIndex], currentImageIndex);
+    RecordCommandBuffer(currentImageIndex);
+    return true;
 }
 
 // -----------------------------------------------------------------------------
@@ -436,40 +739,127 @@ void VulkanGraphicsAPI::BeginFrame()
 // -----------------------------------------------------------------------------
 void VulkanGraphicsAPI::EndFrame()
 {
-    VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    JELLY_PROFILE_ZONE("Vulkan::EndFrame");
 
-    VkSemaphore waitSemaphores[] = {imageAvailableSemaphores[currentFrame]};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
+    VulkanQueueSubmission submission;
 
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffers[currentImageIndex];
+    // Copies submitted for this frame must land before anything reads them.
+    VkSemaphore uploadSemaphore = VK_NULL_HANDLE;
+    uint64_t uploadValue = 0;
+    uploader.Flush(uploadSemaphore, uploadValue);
 
-    VkSemaphore signalSemaphores[] = {renderFinishedSemaphores[currentFrame]};
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
+    // Offscreen frames have no image to wait for and nothing to present.
+    VkSemaphore waitSemaphores[2];
+    VkPipelineStageFlags waitStages[2];
+    uint64_t waitValues[2];
+    uint32_t waitCount = 0;
+    if (!headless)
+    {
+        waitSemaphores[waitCount] = imageAvailableSemaphores[currentFrame];
+        waitStages[waitCount] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        waitValues[waitCount++] = 0;
+    }
+    if (uploadSemaphore != VK_NULL_HANDLE)
+    {
+        waitSemaphores[waitCount] = uploadSemaphore;
+        waitStages[waitCount] = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        waitValues[waitCount++] = uploadValue;
+        submission.waitValues = waitValues;
+    }
+    submission.waitSemaphoreCount = waitCount;
+    submission.waitSemaphores = waitSemaphores;
+    submission.waitStages = waitStages;
+
+    submission.commandBufferCount = 1;
+    submission.commandBuffers = &frameCommandBuffer;
+
+    // The frame timeline reaches this frame's number when the submission completes.
+    const uint64_t frame = GetFrameNumber();
+    VkSemaphore signalSemaphores[2];
+    uint64_t signalValues[2];
+    uint32_t signalCount = 0;
+    if (!headless)
+    {
+        signalSemaphores[signalCount] = renderFinishedSemaphores[currentFrame];
+        signalValues[signalCount++] = 0;
+    }
+    if (frameTimeline != VK_NULL_HANDLE)
+    {
+        signalSemaphores[signalCount] = frameTimeline;
+        signalValues[signalCount++] = frame;
+        submission.signalValues = signalValues;
+    }
+    submission.signalSemaphoreCount = signalCount;
+    submission.signalSemaphores = signalSemaphores;
+
+    // The slot's fence was waited on in BeginFrame, so it can be reused right away.
+    if (!frameFences.empty())
+    {
+        vkResetFences(device, 1, &frameFences[currentFrame]);
+        submission.fence = frameFences[currentFrame];
+    }
+
+    frameAllocator.Flush();
 
     // Envia os comandos para execução
-    if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS)
+    if (Submit(VulkanQueueType::Graphics, submission) != VK_SUCCESS)
     {
         throw GraphicsApiException("Failed to submit draw command buffer!");
     }
+    if (!frameFences.empty())
+    {
+        fenceFrames[currentFrame] = frame;
+    }
+    submittedFrames.store(frame, std::memory_order_release);
+
+    if (headless)
+    {
+        currentFrame = (currentFrame + 1) % framesInFlight;
+        return;
+    }
 
     // Apresenta a imagem no swapchain
     VkPresentInfoKHR presentInfo{VK_STRUCTURE_TYPE_PRESENT_INFO_KHR};
     presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores;
+    presentInfo.pWaitSemaphores = &renderFinishedSemaphores[currentFrame];
     presentInfo.swapchainCount = 1;
     presentInfo.pSwapchains = &swapchain;
     presentInfo.pImageIndices = &currentImageIndex;
 
-    VkResult result = vkQueuePresentKHR(presentQueue, &presentInfo);
+    // Ids let WaitForPresent find out when this image reached the display.
+    VkPresentIdKHR presentIdInfo{};
+    const uint64_t presentId = lastPresentId + 1;
+    if (presentWait)
+    {
+        presentIdInfo.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+        presentIdInfo.swapchainCount = 1;
+        presentIdInfo.pPresentIds = &presentId;
+        presentInfo.pNext = &presentIdInfo;
+    }
+
+    VkResult result;
+    {
+        JELLY_PROFILE_ZONE("Vulkan::Present");
+        std::lock_guard<std::mutex> lock(*presentLock);
+        result = vkQueuePresentKHR(presentQueue, &presentInfo);
+    }
+
+    if (presentWait)
+    {
+        lastPresentId = presentId;
+        lastPresentSwapchain = swapchain;
+    }
 
+    // Without present wait, or outside low-latency mode, intervals are taken at queue time.
+    if (!presentWait || !lowLatency)
+    {
+        RecordPresentInterval();
+    }
+
+    // Rebuilt at the start of the next frame, once the frame that last used its slot completed.
     if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
     {
-        RecreateSwapChain();
+        framebufferResized.store(true);
     }
     else if (result != VK_SUCCESS)
     {
@@ -477,84 +867,498 @@ void VulkanGraphicsAPI::EndFrame()
     }
 
     // Avança para o próximo frame
-    currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+    currentFrame = (currentFrame + 1) % framesInFlight;
 }
 
 // -----------------------------------------------------------------------------
-// Recreates the swapchain and all related resources when the window is resized or becomes incompatible.
+// Recreates the swapchain and the targets built on it without idling the device. The old
+// swapchain is handed to the new one, and its views and framebuffers are retired until
+// the frames that may use them complete. The render pass is kept unless the format changed;
+// with dynamic rendering there is neither a render pass nor framebuffers to rebuild.
+// Returns false, leaving the current targets in place, while the window has no area.
 // -----------------------------------------------------------------------------
-void VulkanGraphicsAPI::RecreateSwapChain()
+bool VulkanGraphicsAPI::RecreateSwapChain()
 {
+    JELLY_PROFILE_ZONE("Vulkan::RecreateSwapChain");
+
     uint32_t width = 0, height = 0;
-    windowProvider->GetFramebufferSize(width, height);
+    windowSystem->GetFramebufferSize(width, height);
 
-    while (width == 0 || height == 0) {
-        windowProvider->GetFramebufferSize(width, height);
-        windowProvider->WaitEvents();
+    minimized = windowProvider && (width == 0 || height == 0);
+    if (minimized)
+    {
+        return false;
     }
 
-    vkDeviceWaitIdle(device);
+    RetiredTargets retired;
+    retired.frame = submittedFrames.load(std::memory_order_relaxed);
+    retired.swapchain = swapchain;
+    swapchain = VK_NULL_HANDLE;
+    retired.imageViews.swap(swapchainImageViews);
+    retired.framebuffers.swap(swapChainFramebuffers);
+    if (headless)
+    {
+        retired.offscreenImages.swap(swapchainImages);
+        retired.offscreenMemory.swap(offscreenMemory);
+    }
 
-    CleanupSwapChain();
+    // Queue the old targets first so they are still released, exactly once, if creation throws.
+    const VkSwapchainKHR oldSwapchain = retired.swapchain;
+    retiredTargets.push_back(std::move(retired));
 
-    CreateSwapChain();
+    const VkFormat previousFormat = swapchainImageFormat;
+    CreateSwapChain(oldSwapchain);
     CreateImageViews();
-    CreateRenderPass();
-    CreateFramebuffers();
-    CreateCommandBuffers();
-    //CreateSyncObjects();
+    if (!dynamicRendering)
+    {
+        if (swapchainImageFormat != previousFormat)
+        {
+            retiredTargets.back().renderPass = renderPass;
+            CreateRenderPass();
+        }
+        CreateFramebuffers();
+    }
+
+    // Cached passes reference the old views and framebuffers.
+    frameCommands.InvalidateAll();
+    return true;
 }
 
 // -----------------------------------------------------------------------------
-// Cleans up all Vulkan resources related to the swapchain, including framebuffers, image views, and the render pass.
+// Destroys retired targets no frame in flight can still reference: those retired after
+// the last submission the GPU has completed. Pass true, with the device idle, to destroy all.
 // -----------------------------------------------------------------------------
-void VulkanGraphicsAPI::CleanupSwapChain()
+void VulkanGraphicsAPI::DestroyRetiredTargets(bool all)
 {
-    for (auto framebuffer : swapChainFramebuffers)
+    const uint64_t completed = GetCompletedFrame();
+
+    auto released = std::remove_if(retiredTargets.begin(), retiredTargets.end(), [&](RetiredTargets& retired) {
+        if (!all && retired.frame > completed)
+        {
+            return false;
+        }
+
+        for (VkFramebuffer framebuffer : retired.framebuffers)
+        {
+            vkDestroyFramebuffer(device, framebuffer, nullptr);
+        }
+        for (VkImageView view : retired.imageViews)
+        {
+            vkDestroyImageView(device, view, nullptr);
+        }
+        for (VkImage image : retired.offscreenImages)
+        {
+            vkDestroyImage(device, image, nullptr);
+        }
+        for (VulkanAllocation* allocation : retired.offscreenMemory)
+        {
+            memoryAllocator.Free(allocation);
+        }
+        if (retired.swapchain != VK_NULL_HANDLE)
+        {
+            vkDestroySwapchainKHR(device, retired.swapchain, nullptr);
+        }
+        if (retired.renderPass != VK_NULL_HANDLE)
+        {
+            vkDestroyRenderPass(device, retired.renderPass, nullptr);
+        }
+        return true;
+    });
+    retiredTargets.erase(released, retiredTargets.end());
+}
+
+// -----------------------------------------------------------------------------
+// Records the frame's commands for the given swapchain image into a buffer from the
+// frame's pool. A frame with nothing but the clear replays the pass cached for its image.
+// -----------------------------------------------------------------------------
+void VulkanGraphicsAPI::RecordCommandBuffer(uint32_t imageIndex)
+{
+    JELLY_PROFILE_ZONE("Vulkan::RecordCommands");
+
+    const uint32_t frame = static_cast<uint32_t>(currentFrame);
+    if (pendingRects.empty())
     {
-        vkDestroyFramebuffer(device, framebuffer, nullptr);
+        frameCommandBuffer = frameCommands.GetStatic(frame, ClearPassKey + imageIndex, VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+                                                     nullptr, &RecordClearPass, this);
+        return;
     }
-    swapChainFramebuffers.clear();
 
-    for (auto imageView : swapchainImageViews)
+    frameCommandBuffer = frameCommands.Allocate(frame);
+
+    VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    vkBeginCommandBuffer(frameCommandBuffer, &beginInfo);
+    RecordPass(frameCommandBuffer, imageIndex);
+    vkEndCommandBuffer(frameCommandBuffer);
+}
+
+// -----------------------------------------------------------------------------
+// Records the pass: the clear, then the pending rects. With dynamic rendering the image
+// is bound at record time and its layout transitions are recorded around the pass.
+// -----------------------------------------------------------------------------
+void VulkanGraphicsAPI::RecordPass(VkCommandBuffer commandBuffer, uint32_t imageIndex)
+{
+    VkClearValue clearValue{};
+    clearValue.color = clearColor;
+
+    // Large scenes are split into secondary command buffers recorded on the job system;
+    // the primary buffer only executes them, in order, inside the pass.
+    const bool parallel = pendingRects.size() >= ParallelRecordThreshold;
+
+    VkCommandBufferInheritanceInfo inheritance{VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO};
+    VkCommandBufferInheritanceRenderingInfoKHR inheritanceRendering{};
+
+    if (dynamicRendering)
     {
-        vkDestroyImageView(device, imageView, nullptr);
+        // Previous contents are discarded, as the render pass's UNDEFINED initial layout did.
+        TransitionImage(commandBuffer, swapchainImages[imageIndex],
+                        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0,
+                        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+
+        VkRenderingAttachmentInfoKHR colorAttachment{};
+        colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        colorAttachment.imageView = swapchainImageViews[imageIndex];
+        colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        colorAttachment.clearValue = clearValue;
+
+        VkRenderingInfoKHR renderingInfo{};
+        renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+        renderingInfo.flags = parallel ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR : 0;
+        renderingInfo.renderArea.offset = {0, 0};
+        renderingInfo.renderArea.extent = swapchainExtent;
+        renderingInfo.layerCount = 1;
+        renderingInfo.colorAttachmentCount = 1;
+        renderingInfo.pColorAttachments = &colorAttachment;
+        cmdBeginRendering(commandBuffer, &renderingInfo);
+
+        inheritanceRendering.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
+        inheritanceRendering.colorAttachmentCount = 1;
+        inheritanceRendering.pColorAttachmentFormats = &swapchainImageFormat;
+        inheritanceRendering.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+        inheritance.pNext = &inheritanceRendering;
+    }
+    else
+    {
+        VkRenderPassBeginInfo renderPassInfo{VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
+        renderPassInfo.renderPass = renderPass;
+        renderPassInfo.framebuffer = swapChainFramebuffers[imageIndex];
+        renderPassInfo.renderArea.offset = {0, 0};
+        renderPassInfo.renderArea.extent = swapchainExtent;
+        renderPassInfo.clearValueCount = 1;
+        renderPassInfo.pClearValues = &clearValue;
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo,
+                             parallel ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+
+        inheritance.renderPass = renderPass;
+        inheritance.subpass = 0;
+        inheritance.framebuffer = swapChainFramebuffers[imageIndex];
     }
-    swapchainImageViews.clear();
 
-    vkDestroySwapchainKHR(device, swapchain, nullptr);
+    if (parallel)
+    {
+        const std::vector<VkCommandBuffer>& secondaries = secondaryRecorder.Record(
+            jobSystem, static_cast<uint32_t>(currentFrame), inheritance,
+            static_cast<uint32_t>(pendingRects.size()), RectsPerSlice, &RecordRects, this);
+        vkCmdExecuteCommands(commandBuffer, static_cast<uint32_t>(secondaries.size()), secondaries.data());
+    }
+    else
+    {
+        RecordRects(this, commandBuffer, 0, static_cast<uint32_t>(pendingRects.size()));
+    }
+    pendingRects.clear();
 
-    if (renderPass != VK_NULL_HANDLE) {
-        vkDestroyRenderPass(device, renderPass, nullptr);
-        renderPass = VK_NULL_HANDLE;
+    // TODO: vkCmdDraw / vkCmdBindPipeline etc aqui...
+
+    if (dynamicRendering)
+    {
+        cmdEndRendering(commandBuffer);
+
+        // Offscreen images end up ready for readback instead of presentation.
+        TransitionImage(commandBuffer, swapchainImages[imageIndex], VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                        headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0);
+    }
+    else
+    {
+        vkCmdEndRenderPass(commandBuffer);
     }
 }
 
 // -----------------------------------------------------------------------------
-// Records rendering commands into the specified command buffer for the given swapchain image.
+// Records the clear-only pass of the current image into a cached command buffer.
 // -----------------------------------------------------------------------------
-void VulkanGraphicsAPI::RecordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex)
+void VulkanGraphicsAPI::RecordClearPass(void* context, VkCommandBuffer commandBuffer)
 {
-    VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    auto* api = static_cast<VulkanGraphicsAPI*>(context);
+    api->RecordPass(commandBuffer, api->currentImageIndex);
+}
 
-    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+// -----------------------------------------------------------------------------
+// Records pending rects [begin, end) into a command buffer inside the render pass.
+// Solid sprites are cleared rectangles until a sprite pipeline exists.
+// -----------------------------------------------------------------------------
+void VulkanGraphicsAPI::RecordRects(void* context, VkCommandBuffer commandBuffer, uint32_t begin, uint32_t end)
+{
+    const auto* api = static_cast<const VulkanGraphicsAPI*>(context);
 
-    VkRenderPassBeginInfo renderPassInfo{VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
-    renderPassInfo.renderPass = renderPass;
-    renderPassInfo.framebuffer = swapChainFramebuffers[imageIndex];
-    renderPassInfo.renderArea.offset = {0, 0};
-    renderPassInfo.renderArea.extent = swapchainExtent;
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        const PendingRect& pending = api->pendingRects[i];
 
-    VkClearValue clearColor = {0.468f, 0.177f, 0.741f, 1.0f};
-    renderPassInfo.clearValueCount = 1;
-    renderPassInfo.pClearValues = &clearColor;
+        VkClearAttachment attachment{};
+        attachment.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        attachment.colorAttachment = 0;
+        attachment.clearValue.color = pending.color;
+        vkCmdClearAttachments(commandBuffer, 1, &attachment, 1, &pending.rect);
+    }
+}
 
-    vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+// -----------------------------------------------------------------------------
+// Returns true if the queue of @p type is not the graphics queue.
+// -----------------------------------------------------------------------------
+bool VulkanGraphicsAPI::HasDedicatedQueue(VulkanQueueType type) const
+{
+    return type != VulkanQueueType::Graphics && queues[static_cast<size_t>(type)].queue != graphicsQueue;
+}
 
-    // TODO: vkCmdDraw / vkCmdBindPipeline etc aqui...
+// -----------------------------------------------------------------------------
+// Reads the current value of a timeline semaphore.
+// -----------------------------------------------------------------------------
+uint64_t VulkanGraphicsAPI::GetSemaphoreCounterValue(VkSemaphore semaphore) const
+{
+    uint64_t value = 0;
+    getSemaphoreCounterValue(device, semaphore, &value);
+    return value;
+}
+
+// -----------------------------------------------------------------------------
+// Returns the newest completed frame: the frame timeline's value, or the value the
+// fences were last polled at.
+// -----------------------------------------------------------------------------
+uint64_t VulkanGraphicsAPI::GetCompletedFrame() const
+{
+    if (frameTimeline != VK_NULL_HANDLE)
+    {
+        return GetSemaphoreCounterValue(frameTimeline);
+    }
+    return completedFrame.load(std::memory_order_acquire);
+}
+
+// -----------------------------------------------------------------------------
+// Waits for a frame on the frame timeline, or on the fence of its slot. A slot's fence
+// may already cover a later frame, which only completes after this one.
+// -----------------------------------------------------------------------------
+void VulkanGraphicsAPI::WaitForFrame(uint64_t frame)
+{
+    if (frame > submittedFrames.load(std::memory_order_acquire) || IsFrameComplete(frame))
+    {
+        return;
+    }
+
+    if (frameTimeline != VK_NULL_HANDLE)
+    {
+        VkSemaphoreWaitInfoKHR waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &frameTimeline;
+        waitInfo.pValues = &frame;
+        waitSemaphores(device, &waitInfo, UINT64_MAX);
+        return;
+    }
+
+    const size_t slot = static_cast<size_t>((frame - 1) % framesInFlight);
+    vkWaitForFences(device, 1, &frameFences[slot], VK_TRUE, UINT64_MAX);
+
+    uint64_t completed = completedFrame.load(std::memory_order_relaxed);
+    completedFrame.store(std::max(completed, fenceFrames[slot]), std::memory_order_release);
+}
+
+// -----------------------------------------------------------------------------
+// Polls the frame fences without blocking and advances the completed frame. Frames
+// complete in submission order, so the newest signaled fence bounds every older frame.
+// -----------------------------------------------------------------------------
+void VulkanGraphicsAPI::RefreshCompletedFrame()
+{
+    uint64_t completed = completedFrame.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < frameFences.size(); ++i)
+    {
+        if (fenceFrames[i] > completed && vkGetFenceStatus(device, frameFences[i]) == VK_SUCCESS)
+        {
+            completed = fenceFrames[i];
+        }
+    }
+    completedFrame.store(completed, std::memory_order_release);
+}
+
+// -----------------------------------------------------------------------------
+// Submits a batch to the queue of @p type under that queue's lock.
+// -----------------------------------------------------------------------------
+VkResult VulkanGraphicsAPI::Submit(VulkanQueueType type, const VulkanQueueSubmission& submission)
+{
+    JELLY_PROFILE_ZONE("Vulkan::Submit");
+
+    VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    submitInfo.waitSemaphoreCount = submission.waitSemaphoreCount;
+    submitInfo.pWaitSemaphores = submission.waitSemaphores;
+    submitInfo.pWaitDstStageMask = submission.waitStages;
+    submitInfo.commandBufferCount = submission.commandBufferCount;
+    submitInfo.pCommandBuffers = submission.commandBuffers;
+    submitInfo.signalSemaphoreCount = submission.signalSemaphoreCount;
+    submitInfo.pSignalSemaphores = submission.signalSemaphores;
+
+    VkTimelineSemaphoreSubmitInfoKHR timelineInfo{};
+    if (submission.waitValues || submission.signalValues)
+    {
+        timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+        timelineInfo.waitSemaphoreValueCount = submission.waitValues ? submission.waitSemaphoreCount : 0;
+        timelineInfo.pWaitSemaphoreValues = submission.waitValues;
+        timelineInfo.signalSemaphoreValueCount = submission.signalValues ? submission.signalSemaphoreCount : 0;
+        timelineInfo.pSignalSemaphoreValues = submission.signalValues;
+        submitInfo.pNext = &timelineInfo;
+    }
 
-    vkCmdEndRenderPass(commandBuffer);
-    vkEndCommandBuffer(commandBuffer);
+    QueueSlot& slot = queues[static_cast<size_t>(type)];
+    std::lock_guard<std::mutex> lock(*slot.lock);
+    return vkQueueSubmit(slot.queue, 1, &submitInfo, submission.fence);
+}
+
+// -----------------------------------------------------------------------------
+// Flags the render targets for recreation at the start of the next frame.
+// -----------------------------------------------------------------------------
+void VulkanGraphicsAPI::NotifyResized()
+{
+    framebufferResized.store(true);
+}
+
+// -----------------------------------------------------------------------------
+// Sets the number of frames in flight, clamped to 1..MaxFramesInFlight.
+// -----------------------------------------------------------------------------
+void VulkanGraphicsAPI::SetFramesInFlight(uint32_t count)
+{
+    if (device != VK_NULL_HANDLE)
+    {
+        JELLY_LOG(LogCategory::Vulkan, LogLevel::Warning, "Frames in flight can only be set before Initialize");
+        return;
+    }
+    framesInFlight = std::clamp(count, 1u, MaxFramesInFlight);
+}
+
+// -----------------------------------------------------------------------------
+// Requests a present mode; the swapchain is rebuilt with it at the start of the next frame,
+// or created with it if Initialize has not run yet.
+// -----------------------------------------------------------------------------
+void VulkanGraphicsAPI::SetPresentMode(PresentMode mode, bool lowLatency)
+{
+    requestedPresentMode.store(mode);
+    requestedLowLatency.store(lowLatency);
+    presentModeChanged.store(true);
+}
+
+// -----------------------------------------------------------------------------
+// Waits until the last present reached the display and records the interval since the
+// one before. Timeouts are ignored: the frame simply starts without the wait.
+// -----------------------------------------------------------------------------
+void VulkanGraphicsAPI::WaitForPresent()
+{
+    if (!presentWait || !lowLatency || lastPresentId == waitedPresentId || lastPresentSwapchain != swapchain)
+    {
+        return;
+    }
+
+    JELLY_PROFILE_ZONE("Vulkan::WaitForPresent");
+
+    const VkResult result = waitForPresent(device, swapchain, lastPresentId, PresentWaitTimeoutNs);
+    if (result == VK_SUCCESS)
+    {
+        waitedPresentId = lastPresentId;
+        RecordPresentInterval();
+    }
+    else if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+    {
+        framebufferResized.store(true);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Returns a copy of the present pacing statistics.
+// -----------------------------------------------------------------------------
+PresentStats VulkanGraphicsAPI::GetPresentStats() const
+{
+    std::lock_guard<std::mutex> lock(statsLock);
+    return presentStats;
+}
+
+// -----------------------------------------------------------------------------
+// Adds the time since the previous present to the statistics.
+// -----------------------------------------------------------------------------
+void VulkanGraphicsAPI::RecordPresentInterval()
+{
+    const auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(statsLock);
+    if (lastPresentTime != std::chrono::steady_clock::time_point{})
+    {
+        const double interval = std::chrono::duration<double>(now - lastPresentTime).count();
+        presentStats.lastIntervalSeconds = interval;
+        presentStats.averageIntervalSeconds = presentStats.presentCount == 0
+            ? interval
+            : presentStats.averageIntervalSeconds + (interval - presentStats.averageIntervalSeconds) * PresentIntervalSmoothing;
+        ++presentStats.presentCount;
+    }
+    lastPresentTime = now;
+}
+
+// -----------------------------------------------------------------------------
+// Sets the job system secondary command buffers are recorded on.
+// -----------------------------------------------------------------------------
+void VulkanGraphicsAPI::SetJobSystem(JobSystem* jobs)
+{
+    jobSystem = jobs;
+}
+
+// -----------------------------------------------------------------------------
+// Sets the color the render pass clears to.
+// -----------------------------------------------------------------------------
+void VulkanGraphicsAPI::SetClearColor(const float color[4])
+{
+    if (std::memcmp(clearColor.float32, color, sizeof(clearColor.float32)) == 0)
+    {
+        return;
+    }
+
+    clearColor = {{color[0], color[1], color[2], color[3]}};
+    for (size_t i = 0; i < swapchainImages.size(); ++i)
+    {
+        frameCommands.Invalidate(ClearPassKey + i);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Queues a solid rectangle for the next recorded frame, clipped to the swapchain extent.
+// -----------------------------------------------------------------------------
+void VulkanGraphicsAPI::DrawRect(float x, float y, float width, float height, const float color[4])
+{
+    const float left   = std::max(x, 0.0f);
+    const float top    = std::max(y, 0.0f);
+    const float right  = std::min(x + width, static_cast<float>(swapchainExtent.width));
+    const float bottom = std::min(y + height, static_cast<float>(swapchainExtent.height));
+    if (right <= left || bottom <= top)
+    {
+        return;
+    }
+
+    PendingRect pending{};
+    pending.rect.rect.offset = {static_cast<int32_t>(left), static_cast<int32_t>(top)};
+    pending.rect.rect.extent = {static_cast<uint32_t>(right - left), static_cast<uint32_t>(bottom - top)};
+    pending.rect.baseArrayLayer = 0;
+    pending.rect.layerCount = 1;
+    pending.color = {{color[0], color[1], color[2], color[3]}};
+    pendingRects.push_back(pending);
 }
 
 // -----------------------------------------------------------------------------
@@ -562,6 +1366,14 @@ void VulkanGraphicsAPI::RecordCommandBuffer(VkCommandBuffer commandBuffer, uint3
 // -----------------------------------------------------------------------------
 void VulkanGraphicsAPI::Shutdown()
 {
+    // Frames still in flight reference everything destroyed below.
+    if (device != VK_NULL_HANDLE)
+    {
+        vkDeviceWaitIdle(device);
+    }
+
+    DestroyRetiredTargets(true);
+
     for (auto view : swapchainImageViews)
         vkDestroyImageView(device, view, nullptr);
     swapchainImageViews.clear();
@@ -571,6 +1383,7 @@ void VulkanGraphicsAPI::Shutdown()
         vkDestroySwapchainKHR(device, swapchain, nullptr);
         swapchain = VK_NULL_HANDLE;
     }
+    DestroyOffscreenTargets();
 
     if (renderPass != VK_NULL_HANDLE)
     {
@@ -584,21 +1397,40 @@ void VulkanGraphicsAPI::Shutdown()
     }
     swapChainFramebuffers.clear();
 
-    if (commandPool != VK_NULL_HANDLE)
-    {
-        vkDestroyCommandPool(device, commandPool, nullptr);
-        commandPool = VK_NULL_HANDLE;
-    }
+    secondaryRecorder.Destroy();
+
+    uploader.Destroy();
+    frameAllocator.Destroy();
+
+    // Pending compilations finish first so their results reach the saved cache.
+    pipelines.Destroy();
+    pipelineCache.Save();
+    pipelineCache.Destroy();
+
+    frameCommands.Destroy();
 
     for (std::size_t i = 0; i < imageAvailableSemaphores.size(); ++i)
     {
         vkDestroySemaphore(device, renderFinishedSemaphores[i], nullptr);
         vkDestroySemaphore(device, imageAvailableSemaphores[i], nullptr);
-        vkDestroyFence(device, inFlightFences[i], nullptr);
     }
     imageAvailableSemaphores.clear();
     renderFinishedSemaphores.clear();
-    inFlightFences.clear();
+
+    for (VkFence fence : frameFences)
+    {
+        vkDestroyFence(device, fence, nullptr);
+    }
+    frameFences.clear();
+    fenceFrames.clear();
+
+    if (frameTimeline != VK_NULL_HANDLE)
+    {
+        vkDestroySemaphore(device, frameTimeline, nullptr);
+        frameTimeline = VK_NULL_HANDLE;
+    }
+
+    memoryAllocator.Destroy();
 
     if (device != VK_NULL_HANDLE)
     {
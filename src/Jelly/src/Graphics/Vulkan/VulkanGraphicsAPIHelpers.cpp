@@ -33,29 +33,81 @@ SwapChainSupportDetails VulkanGraphicsAPI::QuerySwapChainSupport(VkPhysicalDevic
 }
 
 // -----------------------------------------------------------------------------
-// Creates a platform-specific window surface to present rendered images.
+// Queries properties, features, memory types and queue families of a device once.
 // -----------------------------------------------------------------------------
-QueueFamilyIndices VulkanGraphicsAPI::FindQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface)
+VulkanDeviceCapabilities VulkanGraphicsAPI::QueryDeviceCapabilities(VkPhysicalDevice device, VkSurfaceKHR surface)
 {
-    QueueFamilyIndices indices;
+    VulkanDeviceCapabilities capabilities;
+    vkGetPhysicalDeviceProperties(device, &capabilities.properties);
+    vkGetPhysicalDeviceFeatures(device, &capabilities.features);
+    vkGetPhysicalDeviceMemoryProperties(device, &capabilities.memoryProperties);
 
     uint32_t count = 0;
     vkGetPhysicalDeviceQueueFamilyProperties(device, &count, nullptr);
-    std::vector<VkQueueFamilyProperties> families(count);
-    vkGetPhysicalDeviceQueueFamilyProperties(device, &count, families.data());
+    capabilities.queueFamilyProperties.resize(count);
+    vkGetPhysicalDeviceQueueFamilyProperties(device, &count, capabilities.queueFamilyProperties.data());
+
+    count = 0;
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &count, nullptr);
+    capabilities.extensions.resize(count);
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &count, capabilities.extensions.data());
+
+    capabilities.queueFamilies = FindQueueFamilies(device, surface, capabilities.queueFamilyProperties);
+    return capabilities;
+}
+
+// -----------------------------------------------------------------------------
+// Picks the graphics and present families, plus dedicated transfer and compute
+// families when the device exposes them.
+// -----------------------------------------------------------------------------
+QueueFamilyIndices VulkanGraphicsAPI::FindQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface,
+                                                        const std::vector<VkQueueFamilyProperties>& families)
+{
+    QueueFamilyIndices indices;
+    const uint32_t count = static_cast<uint32_t>(families.size());
 
     for (uint32_t i = 0; i < count; ++i)
     {
-        if (families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)
-            indices.graphicsFamily = i;
+        const VkQueueFlags flags = families[i].queueFlags;
+        const bool graphics = (flags & VK_QUEUE_GRAPHICS_BIT) != 0;
 
+        // Without a surface (headless) nothing is presented; the graphics queue stands in.
         VkBool32 presentSupport = false;
-        vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
-        if (presentSupport)
+        if (surface != VK_NULL_HANDLE)
+            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+        else
+            presentSupport = graphics;
+
+        // Prefer a graphics family that can also present, so frames stay on one queue.
+        if (graphics && (!indices.graphicsFamily || (presentSupport && indices.presentFamily != indices.graphicsFamily)))
+            indices.graphicsFamily = i;
+        if (presentSupport && (!indices.presentFamily || i == indices.graphicsFamily))
             indices.presentFamily = i;
 
-        if (indices.IsComplete())
-            break;
+        if (!graphics && (flags & VK_QUEUE_COMPUTE_BIT) && !indices.computeFamily)
+            indices.computeFamily = i;
+
+        // A transfer-only family is the copy engine; settle for any non-graphics family otherwise.
+        if (!graphics && (flags & VK_QUEUE_TRANSFER_BIT))
+        {
+            const bool transferOnly = (flags & VK_QUEUE_COMPUTE_BIT) == 0;
+            if (!indices.transferFamily || transferOnly)
+                indices.transferFamily = i;
+        }
+    }
+
+    // A shared non-graphics family serves compute; transfer keeps it only if nothing better exists.
+    if (indices.transferFamily && indices.transferFamily == indices.computeFamily)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (i != indices.computeFamily && !(families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) &&
+                (families[i].queueFlags & VK_QUEUE_TRANSFER_BIT))
+            {
+                indices.transferFamily = i;
+                break;
+            }
+        }
     }
 
     return indices;
@@ -76,18 +128,70 @@ VkSurfaceFormatKHR VulkanGraphicsAPI::ChooseSurfaceFormat(const std::vector<VkSu
 }
 
 // -----------------------------------------------------------------------------
-// Chooses the best available surface format (color format and color space) from the supported list.
+// Chooses the preferred present mode, or the closest one the surface supports.
+// -----------------------------------------------------------------------------
+PresentMode VulkanGraphicsAPI::ChoosePresentMode(const std::vector<VkPresentModeKHR> &modes, PresentMode preferred)
+{
+    auto supported = [&](PresentMode mode) {
+        return std::find(modes.begin(), modes.end(), ToVkPresentMode(mode)) != modes.end();
+    };
+
+    // Without tearing or without vsync, the other tear-free / uncapped mode is the closest
+    // match; FIFO is the only mode every surface supports.
+    PresentMode fallbacks[3] = {preferred, PresentMode::Fifo, PresentMode::Fifo};
+    if (preferred == PresentMode::Mailbox)
+        fallbacks[1] = PresentMode::Immediate;
+    else if (preferred == PresentMode::Immediate)
+        fallbacks[1] = PresentMode::Mailbox;
+
+    for (PresentMode mode : fallbacks)
+        if (supported(mode))
+            return mode;
+    return PresentMode::Fifo;
+}
+
+// -----------------------------------------------------------------------------
+// Maps an engine present mode to its Vulkan equivalent.
+// -----------------------------------------------------------------------------
+VkPresentModeKHR VulkanGraphicsAPI::ToVkPresentMode(PresentMode mode)
+{
+    switch (mode)
+    {
+    case PresentMode::FifoRelaxed: return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+    case PresentMode::Mailbox:     return VK_PRESENT_MODE_MAILBOX_KHR;
+    case PresentMode::Immediate:   return VK_PRESENT_MODE_IMMEDIATE_KHR;
+    default:                       return VK_PRESENT_MODE_FIFO_KHR;
+    }
+}
+
 // -----------------------------------------------------------------------------
-VkPresentModeKHR VulkanGraphicsAPI::ChoosePresentMode(const std::vector<VkPresentModeKHR> &modes)
+// Chooses how many swapchain images a present mode needs: mailbox needs a spare image to
+// replace, and FIFO queues one frame less in low-latency mode.
+// -----------------------------------------------------------------------------
+uint32_t VulkanGraphicsAPI::ChooseImageCount(const VkSurfaceCapabilitiesKHR &caps, PresentMode mode, bool lowLatency)
 {
-    for (VkPresentModeKHR m : modes)
-        if (m == VK_PRESENT_MODE_MAILBOX_KHR) // triplo buffering, suave
-            return m;
-    return VK_PRESENT_MODE_FIFO_KHR; // vs-sync garantido, 100% compat.
+    uint32_t count = caps.minImageCount + 1;
+    switch (mode)
+    {
+    case PresentMode::Mailbox:
+        count = std::max(caps.minImageCount + 1, 3u);
+        break;
+    case PresentMode::Immediate:
+        count = std::max(caps.minImageCount, 2u);
+        break;
+    case PresentMode::Fifo:
+    case PresentMode::FifoRelaxed:
+        count = lowLatency ? std::max(caps.minImageCount, 2u) : caps.minImageCount + 1;
+        break;
+    }
+
+    if (caps.maxImageCount && count > caps.maxImageCount)
+        count = caps.maxImageCount;
+    return count;
 }
 
 // -----------------------------------------------------------------------------
-// Chooses the preferred present mode (e.g., mailbox, FIFO) for image presentation.
+// Chooses the swapchain extent, following the window's framebuffer size when the surface allows.
 // -----------------------------------------------------------------------------
 VkExtent2D VulkanGraphicsAPI::ChooseSwapExtent(const VkSurfaceCapabilitiesKHR &caps, INativeWindowHandleProvider *win)
 {
@@ -0,0 +1,737 @@
+#include "Graphics/Vulkan/VulkanMemoryAllocator.h"
+
+#include "Logger.h"
+#include "Profiling/Profiler.h"
+
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+    constexpr std::uint32_t NoNode     = UINT32_MAX;
+    constexpr std::uint32_t SLBits     = 4;                 ///< Second-level bins per power of two = 1 << SLBits.
+    constexpr std::uint32_t SLCount    = 1u << SLBits;
+    constexpr std::uint32_t FLCount    = 64;
+    constexpr VkDeviceSize  SmallHeap  = VkDeviceSize(1) << 30;
+    constexpr VkDeviceSize  LargeBlock = VkDeviceSize(64) << 20;
+
+    // -----------------------------------------------------------------------------
+    // Index of the highest set bit; @p value must not be 0.
+    // -----------------------------------------------------------------------------
+    std::uint32_t HighestBit(std::uint64_t value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return static_cast<std::uint32_t>(index);
+#else
+        return 63u - static_cast<std::uint32_t>(__builtin_clzll(value));
+#endif
+    }
+
+    // -----------------------------------------------------------------------------
+    // Index of the lowest set bit; @p value must not be 0.
+    // -----------------------------------------------------------------------------
+    std::uint32_t LowestBit(std::uint64_t value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return static_cast<std::uint32_t>(index);
+#else
+        return static_cast<std::uint32_t>(__builtin_ctzll(value));
+#endif
+    }
+
+    // -----------------------------------------------------------------------------
+    // Rounds @p value up to a multiple of @p alignment (a power of two).
+    // -----------------------------------------------------------------------------
+    VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    // -----------------------------------------------------------------------------
+    // Maps a size to its first- and second-level bin.
+    // -----------------------------------------------------------------------------
+    void MapSize(VkDeviceSize size, std::uint32_t& fl, std::uint32_t& sl) {
+        fl = HighestBit(size);
+        sl = fl >= SLBits ? static_cast<std::uint32_t>(size >> (fl - SLBits)) & (SLCount - 1)
+                          : static_cast<std::uint32_t>(size << (SLBits - fl)) & (SLCount - 1);
+    }
+}
+
+/// One VkDeviceMemory carved into ranges. Nodes form a physical list in offset order;
+/// free nodes are also linked into the list of their TLSF bin.
+struct VulkanMemoryAllocator::Block {
+    struct Node {
+        VkDeviceSize      offset    = 0;
+        VkDeviceSize      size      = 0;        ///< 0 while the node sits in unusedNodes.
+        VkDeviceSize      alignment = 1;        ///< Alignment the owner was placed with.
+        std::uint32_t     prevPhys  = NoNode;
+        std::uint32_t     nextPhys  = NoNode;
+        std::uint32_t     prevFree  = NoNode;
+        std::uint32_t     nextFree  = NoNode;
+        bool              free      = false;
+        VulkanAllocation* owner     = nullptr;
+    };
+
+    Pool*          pool    = nullptr;
+    VkDeviceMemory memory  = VK_NULL_HANDLE;
+    VkDeviceSize   size    = 0;
+    std::uint8_t*  mapped  = nullptr;
+    VkDeviceSize   used    = 0;
+    std::uint32_t  liveCount = 0;
+
+    std::vector<Node>          nodes;
+    std::vector<std::uint32_t> unusedNodes;
+    std::uint64_t              flBitmap = 0;
+    std::uint32_t              slBitmap[FLCount] = {};
+    std::uint32_t              heads[FLCount][SLCount];
+
+    // -----------------------------------------------------------------------------
+    // Starts with one free node spanning the whole block.
+    // -----------------------------------------------------------------------------
+    explicit Block(VkDeviceSize blockSize) : size(blockSize) {
+        std::fill(&heads[0][0], &heads[0][0] + FLCount * SLCount, NoNode);
+        const std::uint32_t first = NewNode();
+        nodes[first].size = blockSize;
+        InsertFree(first);
+    }
+
+    std::uint32_t NewNode() {
+        if (!unusedNodes.empty()) {
+            const std::uint32_t index = unusedNodes.back();
+            unusedNodes.pop_back();
+            nodes[index] = Node{};
+            return index;
+        }
+        nodes.emplace_back();
+        return static_cast<std::uint32_t>(nodes.size() - 1);
+    }
+
+    void InsertFree(std::uint32_t index) {
+        Node& node = nodes[index];
+        std::uint32_t fl, sl;
+        MapSize(node.size, fl, sl);
+
+        node.free = true;
+        node.owner = nullptr;
+        node.prevFree = NoNode;
+        node.nextFree = heads[fl][sl];
+        if (node.nextFree != NoNode) {
+            nodes[node.nextFree].prevFree = index;
+        }
+        heads[fl][sl] = index;
+        flBitmap |= std::uint64_t(1) << fl;
+        slBitmap[fl] |= 1u << sl;
+    }
+
+    void RemoveFree(std::uint32_t index) {
+        Node& node = nodes[index];
+        std::uint32_t fl, sl;
+        MapSize(node.size, fl, sl);
+
+        if (node.prevFree != NoNode) {
+            nodes[node.prevFree].nextFree = node.nextFree;
+        } else {
+            heads[fl][sl] = node.nextFree;
+        }
+        if (node.nextFree != NoNode) {
+            nodes[node.nextFree].prevFree = node.prevFree;
+        }
+        if (heads[fl][sl] == NoNode) {
+            slBitmap[fl] &= ~(1u << sl);
+            if (slBitmap[fl] == 0) {
+                flBitmap &= ~(std::uint64_t(1) << fl);
+            }
+        }
+        node.free = false;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Returns a free node of at least @p size bytes from the first non-empty bin at or
+    // above the size's bin, rounded up so every node in it is large enough.
+    // -----------------------------------------------------------------------------
+    std::uint32_t FindFree(VkDeviceSize size) const {
+        std::uint32_t fl = HighestBit(size);
+        if (fl >= SLBits) {
+            const VkDeviceSize rounded = size + (VkDeviceSize(1) << (fl - SLBits)) - 1;
+            if (rounded < size) {
+                return NoNode;
+            }
+            size = rounded;
+        }
+
+        std::uint32_t sl;
+        MapSize(size, fl, sl);
+
+        std::uint32_t slMap = slBitmap[fl] & (~0u << sl);
+        if (slMap == 0) {
+            const std::uint64_t flMap = fl + 1 < FLCount ? flBitmap & (~std::uint64_t(0) << (fl + 1)) : 0;
+            if (flMap == 0) {
+                return NoNode;
+            }
+            fl = LowestBit(flMap);
+            slMap = slBitmap[fl];
+        }
+        return heads[fl][LowestBit(slMap)];
+    }
+
+    // -----------------------------------------------------------------------------
+    // Carves an aligned range out of the block; returns its node or NoNode.
+    // -----------------------------------------------------------------------------
+    std::uint32_t Allocate(VkDeviceSize allocSize, VkDeviceSize alignment, VulkanAllocation* owner) {
+        const std::uint32_t index = FindFree(allocSize + alignment - 1);
+        if (index == NoNode) {
+            return NoNode;
+        }
+        RemoveFree(index);
+
+        // Alignment padding in front becomes its own free node.
+        const VkDeviceSize aligned = AlignUp(nodes[index].offset, alignment);
+        const VkDeviceSize padding = aligned - nodes[index].offset;
+        if (padding > 0) {
+            const std::uint32_t front = NewNode();
+            Node& node = nodes[index];
+            nodes[front].offset = node.offset;
+            nodes[front].size = padding;
+            nodes[front].prevPhys = node.prevPhys;
+            nodes[front].nextPhys = index;
+            if (node.prevPhys != NoNode) {
+                nodes[node.prevPhys].nextPhys = front;
+            }
+            nodes[index].prevPhys = front;
+            nodes[index].offset = aligned;
+            nodes[index].size -= padding;
+            InsertFree(front);
+        }
+
+        // So does whatever is left behind the allocation.
+        if (nodes[index].size > allocSize) {
+            const std::uint32_t back = NewNode();
+            Node& node = nodes[index];
+            nodes[back].offset = node.offset + allocSize;
+            nodes[back].size = node.size - allocSize;
+            nodes[back].prevPhys = index;
+            nodes[back].nextPhys = node.nextPhys;
+            if (node.nextPhys != NoNode) {
+                nodes[node.nextPhys].prevPhys = back;
+            }
+            nodes[index].nextPhys = back;
+            nodes[index].size = allocSize;
+            InsertFree(back);
+        }
+
+        nodes[index].owner = owner;
+        nodes[index].alignment = alignment;
+        used += allocSize;
+        ++liveCount;
+        return index;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Returns a node to the free bins, merging it with free physical neighbours.
+    // -----------------------------------------------------------------------------
+    void Free(std::uint32_t index) {
+        used -= nodes[index].size;
+        --liveCount;
+
+        const std::uint32_t prev = nodes[index].prevPhys;
+        if (prev != NoNode && nodes[prev].free) {
+            RemoveFree(prev);
+            nodes[index].offset = nodes[prev].offset;
+            nodes[index].size += nodes[prev].size;
+            nodes[index].prevPhys = nodes[prev].prevPhys;
+            if (nodes[prev].prevPhys != NoNode) {
+                nodes[nodes[prev].prevPhys].nextPhys = index;
+            }
+            nodes[prev].size = 0;
+            unusedNodes.push_back(prev);
+        }
+
+        const std::uint32_t next = nodes[index].nextPhys;
+        if (next != NoNode && nodes[next].free) {
+            RemoveFree(next);
+            nodes[index].size += nodes[next].size;
+            nodes[index].nextPhys = nodes[next].nextPhys;
+            if (nodes[next].nextPhys != NoNode) {
+                nodes[nodes[next].nextPhys].prevPhys = index;
+            }
+            nodes[next].size = 0;
+            unusedNodes.push_back(next);
+        }
+
+        InsertFree(index);
+    }
+
+    // -----------------------------------------------------------------------------
+    // Size of the largest free node.
+    // -----------------------------------------------------------------------------
+    VkDeviceSize LargestFree() const {
+        if (flBitmap == 0) {
+            return 0;
+        }
+
+        const std::uint32_t fl = HighestBit(flBitmap);
+        const std::uint32_t sl = HighestBit(slBitmap[fl]);
+        VkDeviceSize largest = 0;
+        for (std::uint32_t i = heads[fl][sl]; i != NoNode; i = nodes[i].nextFree) {
+            largest = std::max(largest, nodes[i].size);
+        }
+        return largest;
+    }
+};
+
+VulkanMemoryAllocator::VulkanMemoryAllocator() = default;
+
+VulkanMemoryAllocator::~VulkanMemoryAllocator() {
+    Destroy();
+}
+
+// -----------------------------------------------------------------------------
+// Records the device limits and creates one (empty) pool per memory type and tiling.
+// -----------------------------------------------------------------------------
+void VulkanMemoryAllocator::Create(VkDevice device, const VulkanDeviceCapabilities& capabilities) {
+    Destroy();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    this->device = device;
+    memoryProperties = capabilities.memoryProperties;
+    granularity = std::max<VkDeviceSize>(1, capabilities.properties.limits.bufferImageGranularity);
+    maxDeviceMemoryCount = capabilities.properties.limits.maxMemoryAllocationCount;
+
+    pools.resize(static_cast<std::size_t>(memoryProperties.memoryTypeCount) * 2);
+    for (std::uint32_t type = 0; type < memoryProperties.memoryTypeCount; ++type) {
+        const VkDeviceSize heapSize = memoryProperties.memoryHeaps[memoryProperties.memoryTypes[type].heapIndex].size;
+        const VkDeviceSize blockSize = heapSize <= SmallHeap ? std::max<VkDeviceSize>(heapSize / 8, 1) : LargeBlock;
+        for (std::uint32_t tiling = 0; tiling < 2; ++tiling) {
+            Pool& pool = pools[type * 2 + tiling];
+            pool.memoryType = type;
+            pool.blockSize = blockSize;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Frees every block and dedicated allocation.
+// -----------------------------------------------------------------------------
+void VulkanMemoryAllocator::Destroy() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (device == VK_NULL_HANDLE) {
+        return;
+    }
+
+    if (allocationCount > 0) {
+        JELLY_LOG(LogCategory::Vulkan, LogLevel::Warning, "{} GPU allocation(s) still alive at shutdown", allocationCount);
+    }
+
+    for (VulkanAllocation& record : records) {
+        if (record.dedicated && record.memory != VK_NULL_HANDLE) {
+            vkFreeMemory(device, record.memory, nullptr);
+        }
+    }
+    for (Pool& pool : pools) {
+        for (auto& block : pool.blocks) {
+            vkFreeMemory(device, block->memory, nullptr);
+        }
+    }
+
+    pools.clear();
+    records.clear();
+    freeRecords.clear();
+    deviceMemoryCount = 0;
+    dedicatedCount = 0;
+    allocationCount = 0;
+    dedicatedBytes = 0;
+    device = VK_NULL_HANDLE;
+}
+
+// -----------------------------------------------------------------------------
+// Picks a memory type and serves the request from a block or a dedicated allocation.
+// -----------------------------------------------------------------------------
+VulkanAllocation* VulkanMemoryAllocator::Allocate(const VkMemoryRequirements& requirements,
+                                                  VkMemoryPropertyFlags properties, VulkanResourceTiling tiling) {
+    // Software drivers expose a single heap, so any allowed type beats failing.
+    return Allocate(requirements, 0, properties, tiling);
+}
+
+// -----------------------------------------------------------------------------
+// Allocates from a type with the required and preferred properties, falling back to
+// types with only the required ones.
+// -----------------------------------------------------------------------------
+VulkanAllocation* VulkanMemoryAllocator::Allocate(const VkMemoryRequirements& requirements,
+                                                  VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred,
+                                                  VulkanResourceTiling tiling) {
+    JELLY_PROFILE_ZONE("VulkanMemoryAllocator::Allocate");
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (device == VK_NULL_HANDLE || requirements.size == 0) {
+        return nullptr;
+    }
+
+    // Types with every requested property first, then those with the required ones.
+    // A type whose heap is exhausted falls through to the next.
+    const VkMemoryPropertyFlags wanted = required | preferred;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (std::uint32_t type = 0; type < memoryProperties.memoryTypeCount; ++type) {
+            const VkMemoryPropertyFlags flags = memoryProperties.memoryTypes[type].propertyFlags;
+            const bool allowed = (requirements.memoryTypeBits & (1u << type)) != 0 && (flags & required) == required;
+            const bool matches = (flags & wanted) == wanted;
+            if (!allowed || (pass == 0) != matches) {
+                continue;
+            }
+
+            Pool& pool = PoolFor(type, tiling);
+            VulkanAllocation* allocation = requirements.size > pool.blockSize / 2
+                                               ? AllocateDedicated(requirements, type)
+                                               : AllocateFromPool(pool, requirements);
+            if (allocation) {
+                ++allocationCount;
+                return allocation;
+            }
+        }
+    }
+
+    JELLY_LOG(LogCategory::Vulkan, LogLevel::Error, "Out of GPU memory allocating {} bytes", requirements.size);
+    return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+// Allocates and binds memory for a buffer.
+// -----------------------------------------------------------------------------
+VulkanAllocation* VulkanMemoryAllocator::AllocateForBuffer(VkBuffer buffer, VkMemoryPropertyFlags properties) {
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device, buffer, &requirements);
+
+    VulkanAllocation* allocation = Allocate(requirements, properties, VulkanResourceTiling::Linear);
+    if (allocation && vkBindBufferMemory(device, buffer, allocation->memory, allocation->offset) != VK_SUCCESS) {
+        Free(allocation);
+        return nullptr;
+    }
+    return allocation;
+}
+
+// -----------------------------------------------------------------------------
+// Allocates and binds memory for an optimal-tiling image.
+// -----------------------------------------------------------------------------
+VulkanAllocation* VulkanMemoryAllocator::AllocateForImage(VkImage image, VkMemoryPropertyFlags properties) {
+    VkMemoryRequirements requirements;
+    vkGetImageMemoryRequirements(device, image, &requirements);
+
+    VulkanAllocation* allocation = Allocate(requirements, properties, VulkanResourceTiling::Optimal);
+    if (allocation && vkBindImageMemory(device, image, allocation->memory, allocation->offset) != VK_SUCCESS) {
+        Free(allocation);
+        return nullptr;
+    }
+    return allocation;
+}
+
+// -----------------------------------------------------------------------------
+// Releases a range back to its block, or the whole memory object if dedicated.
+// -----------------------------------------------------------------------------
+void VulkanMemoryAllocator::Free(VulkanAllocation* allocation) {
+    if (!allocation) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (allocation->dedicated) {
+        vkFreeMemory(device, allocation->memory, nullptr);
+        --deviceMemoryCount;
+        --dedicatedCount;
+        dedicatedBytes -= allocation->size;
+    } else {
+        auto* block = static_cast<Block*>(allocation->block);
+        block->Free(allocation->node);
+        if (block->liveCount == 0) {
+            ReleaseEmptyBlocks(*block->pool);
+        }
+    }
+
+    --allocationCount;
+    *allocation = VulkanAllocation{};
+    freeRecords.push_back(allocation);
+}
+
+// -----------------------------------------------------------------------------
+// Sums the blocks and dedicated allocations.
+// -----------------------------------------------------------------------------
+VulkanMemoryStats VulkanMemoryAllocator::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    VulkanMemoryStats stats;
+    stats.dedicatedCount = dedicatedCount;
+    stats.allocationCount = allocationCount;
+    stats.deviceMemoryCount = deviceMemoryCount;
+    stats.reservedBytes = dedicatedBytes;
+    stats.usedBytes = dedicatedBytes;
+
+    for (const Pool& pool : pools) {
+        for (const auto& block : pool.blocks) {
+            ++stats.blockCount;
+            stats.reservedBytes += block->size;
+            stats.usedBytes += block->used;
+            stats.largestFreeRange = std::max(stats.largestFreeRange, block->LargestFree());
+        }
+    }
+    return stats;
+}
+
+// -----------------------------------------------------------------------------
+// Reserves new homes, in fuller blocks, for allocations of each pool's emptiest block.
+// -----------------------------------------------------------------------------
+std::uint32_t VulkanMemoryAllocator::BeginDefragmentation(VkDeviceSize maxBytes,
+                                                          std::vector<VulkanDefragmentMove>& moves) {
+    JELLY_PROFILE_ZONE("VulkanMemoryAllocator::BeginDefragmentation");
+
+    std::lock_guard<std::mutex> lock(mutex);
+    moves.clear();
+
+    VkDeviceSize budget = maxBytes;
+    for (Pool& pool : pools) {
+        if (pool.blocks.size() < 2) {
+            continue;
+        }
+
+        // Draining the emptiest block frees a whole VkDeviceMemory for the fewest bytes copied.
+        Block* source = nullptr;
+        for (auto& block : pool.blocks) {
+            if (block->liveCount > 0 && (!source || block->used < source->used)) {
+                source = block.get();
+            }
+        }
+        if (!source) {
+            continue;
+        }
+
+        for (std::uint32_t i = 0; i < source->nodes.size() && budget > 0; ++i) {
+            const Block::Node& node = source->nodes[i];
+            if (node.free || node.size == 0 || node.size > budget) {
+                continue;
+            }
+
+            // Allocations already moving in an earlier pass keep that move until it ends.
+            // This also skips the ranges reserved for them, which belong to the same owner.
+            if (node.owner->pendingBlock) {
+                continue;
+            }
+
+            for (auto& target : pool.blocks) {
+                // The spare empty block is skipped too, or passes would just shuttle ranges into it.
+                if (target.get() == source || target->liveCount == 0) {
+                    continue;
+                }
+
+                const std::uint32_t placed = target->Allocate(node.size, node.alignment, node.owner);
+                if (placed == NoNode) {
+                    continue;
+                }
+
+                node.owner->pendingBlock = target.get();
+                node.owner->pendingNode = placed;
+
+                VulkanDefragmentMove move;
+                move.allocation = node.owner;
+                move.srcMemory = source->memory;
+                move.srcOffset = node.offset;
+                move.dstMemory = target->memory;
+                move.dstOffset = target->nodes[placed].offset;
+                move.size = node.size;
+                moves.push_back(move);
+
+                budget -= node.size;
+                break;
+            }
+        }
+    }
+    return static_cast<std::uint32_t>(moves.size());
+}
+
+// -----------------------------------------------------------------------------
+// Frees the move sources, points the allocations at their destinations and drops
+// blocks that ended up empty.
+// -----------------------------------------------------------------------------
+void VulkanMemoryAllocator::EndDefragmentation(const std::vector<VulkanDefragmentMove>& moves) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (const VulkanDefragmentMove& move : moves) {
+        VulkanAllocation* allocation = move.allocation;
+        auto* source = static_cast<Block*>(allocation->block);
+        auto* target = static_cast<Block*>(allocation->pendingBlock);
+        if (!target) {
+            continue;
+        }
+
+        source->Free(allocation->node);
+        allocation->block = target;
+        allocation->node = allocation->pendingNode;
+        allocation->pendingBlock = nullptr;
+        allocation->memory = target->memory;
+        allocation->offset = move.dstOffset;
+        allocation->mapped = target->mapped ? target->mapped + move.dstOffset : nullptr;
+    }
+
+    for (Pool& pool : pools) {
+        ReleaseEmptyBlocks(pool);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Returns the pool of a memory type; tilings only get separate blocks when the device
+// has a bufferImageGranularity above one.
+// -----------------------------------------------------------------------------
+VulkanMemoryAllocator::Pool& VulkanMemoryAllocator::PoolFor(std::uint32_t memoryType, VulkanResourceTiling tiling) {
+    const std::uint32_t split = granularity > 1 && tiling == VulkanResourceTiling::Optimal ? 1 : 0;
+    return pools[memoryType * 2 + split];
+}
+
+// -----------------------------------------------------------------------------
+// Allocates a new block for @p pool, mapping it when the memory is host visible.
+// -----------------------------------------------------------------------------
+VulkanMemoryAllocator::Block* VulkanMemoryAllocator::CreateBlock(Pool& pool) {
+    if (maxDeviceMemoryCount > 0 && deviceMemoryCount >= maxDeviceMemoryCount) {
+        return nullptr;
+    }
+
+    VkMemoryAllocateInfo allocateInfo{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+    allocateInfo.allocationSize = pool.blockSize;
+    allocateInfo.memoryTypeIndex = pool.memoryType;
+
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    if (vkAllocateMemory(device, &allocateInfo, nullptr, &memory) != VK_SUCCESS) {
+        return nullptr;
+    }
+
+    auto block = std::make_unique<Block>(pool.blockSize);
+    block->pool = &pool;
+    block->memory = memory;
+    if (IsHostVisible(pool.memoryType)) {
+        void* mapped = nullptr;
+        vkMapMemory(device, memory, 0, VK_WHOLE_SIZE, 0, &mapped);
+        block->mapped = static_cast<std::uint8_t*>(mapped);
+    }
+
+    ++deviceMemoryCount;
+    pool.blocks.push_back(std::move(block));
+    return pool.blocks.back().get();
+}
+
+// -----------------------------------------------------------------------------
+// Frees a block's device memory and removes it from its pool.
+// -----------------------------------------------------------------------------
+void VulkanMemoryAllocator::DestroyBlock(Block* block) {
+    Pool& pool = *block->pool;
+    vkFreeMemory(device, block->memory, nullptr);
+    --deviceMemoryCount;
+
+    pool.blocks.erase(std::find_if(pool.blocks.begin(), pool.blocks.end(),
+                                   [block](const std::unique_ptr<Block>& b) { return b.get() == block; }));
+}
+
+// -----------------------------------------------------------------------------
+// Frees empty blocks, keeping one so a pool that drains and refills does not thrash.
+// -----------------------------------------------------------------------------
+void VulkanMemoryAllocator::ReleaseEmptyBlocks(Pool& pool) {
+    bool keptOne = false;
+    for (std::size_t i = pool.blocks.size(); i-- > 0;) {
+        Block* block = pool.blocks[i].get();
+        if (block->liveCount > 0) {
+            continue;
+        }
+        if (!keptOne) {
+            keptOne = true;
+            continue;
+        }
+        DestroyBlock(block);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Gives a large request its own VkDeviceMemory.
+// -----------------------------------------------------------------------------
+VulkanAllocation* VulkanMemoryAllocator::AllocateDedicated(const VkMemoryRequirements& requirements,
+                                                           std::uint32_t memoryType) {
+    if (maxDeviceMemoryCount > 0 && deviceMemoryCount >= maxDeviceMemoryCount) {
+        return nullptr;
+    }
+
+    VkMemoryAllocateInfo allocateInfo{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+    allocateInfo.allocationSize = requirements.size;
+    allocateInfo.memoryTypeIndex = memoryType;
+
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    if (vkAllocateMemory(device, &allocateInfo, nullptr, &memory) != VK_SUCCESS) {
+        return nullptr;
+    }
+
+    VulkanAllocation* allocation = NewRecord();
+    allocation->memory = memory;
+    allocation->size = requirements.size;
+    allocation->memoryType = memoryType;
+    allocation->dedicated = true;
+    if (IsHostVisible(memoryType)) {
+        vkMapMemory(device, memory, 0, VK_WHOLE_SIZE, 0, &allocation->mapped);
+    }
+
+    ++deviceMemoryCount;
+    ++dedicatedCount;
+    dedicatedBytes += requirements.size;
+    return allocation;
+}
+
+// -----------------------------------------------------------------------------
+// Serves a request from the first block with room, adding a block if none has any.
+// -----------------------------------------------------------------------------
+VulkanAllocation* VulkanMemoryAllocator::AllocateFromPool(Pool& pool, const VkMemoryRequirements& requirements) {
+    VulkanAllocation* allocation = NewRecord();
+    const VkDeviceSize alignment = std::max<VkDeviceSize>(requirements.alignment, 1);
+
+    Block* block = nullptr;
+    std::uint32_t node = NoNode;
+    for (auto& candidate : pool.blocks) {
+        node = candidate->Allocate(requirements.size, alignment, allocation);
+        if (node != NoNode) {
+            block = candidate.get();
+            break;
+        }
+    }
+
+    if (!block) {
+        block = CreateBlock(pool);
+        node = block ? block->Allocate(requirements.size, alignment, allocation) : NoNode;
+    }
+
+    if (node == NoNode) {
+        freeRecords.push_back(allocation);
+        return nullptr;
+    }
+
+    allocation->block = block;
+    allocation->node = node;
+    allocation->memory = block->memory;
+    allocation->offset = block->nodes[node].offset;
+    allocation->size = requirements.size;
+    allocation->memoryType = pool.memoryType;
+    allocation->mapped = block->mapped ? block->mapped + allocation->offset : nullptr;
+    return allocation;
+}
+
+// -----------------------------------------------------------------------------
+// Returns a recycled or new allocation record.
+// -----------------------------------------------------------------------------
+VulkanAllocation* VulkanMemoryAllocator::NewRecord() {
+    if (!freeRecords.empty()) {
+        VulkanAllocation* record = freeRecords.back();
+        freeRecords.pop_back();
+        return record;
+    }
+    records.emplace_back();
+    return &records.back();
+}
+
+// -----------------------------------------------------------------------------
+// Returns true if the memory type can be mapped.
+// -----------------------------------------------------------------------------
+bool VulkanMemoryAllocator::IsHostVisible(std::uint32_t memoryType) const {
+    return (memoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+}
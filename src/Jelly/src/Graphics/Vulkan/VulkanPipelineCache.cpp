@@ -0,0 +1,251 @@
+#include "Graphics/Vulkan/VulkanPipelineCache.h"
+
+#include "Logger.h"
+#include "Graphics/GraphicsApiException.h"
+#include "Profiling/Profiler.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+namespace {
+    constexpr char          FileMagic[8] = {'J', 'E', 'L', 'L', 'Y', 'P', 'C', '\0'};
+    constexpr std::uint32_t FileVersion  = 1;
+
+    /// Header written in front of the driver's cache blob.
+    struct FileHeader {
+        char          magic[8];
+        std::uint32_t version;
+        std::uint32_t driverVersion;
+        std::uint64_t dataSize;
+        std::uint64_t checksum;     ///< FNV-1a of the blob.
+    };
+
+    /// Leading fields of a VK_PIPELINE_CACHE_HEADER_VERSION_ONE blob, as laid out by the spec.
+    struct DriverHeader {
+        std::uint32_t headerSize;
+        std::uint32_t headerVersion;
+        std::uint32_t vendorID;
+        std::uint32_t deviceID;
+        std::uint8_t  pipelineCacheUUID[VK_UUID_SIZE];
+    };
+
+    static_assert(sizeof(DriverHeader) == 32, "DriverHeader must match the Vulkan cache header");
+
+    // -----------------------------------------------------------------------------
+    // 64-bit FNV-1a hash, enough to catch truncated or damaged files.
+    // -----------------------------------------------------------------------------
+    std::uint64_t Checksum(const void* data, std::size_t size) {
+        auto bytes = static_cast<const std::uint8_t*>(data);
+        std::uint64_t hash = 14695981039346656037ull;
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Returns an environment variable, or an empty string when it is unset.
+    // -----------------------------------------------------------------------------
+    std::string Environment(const char* name) {
+        const char* value = std::getenv(name);
+        return value ? value : "";
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Creates the pipeline cache, seeded with the on-disk blob when it matches this device.
+// -----------------------------------------------------------------------------
+void VulkanPipelineCache::Create(VkDevice device, const VkPhysicalDeviceProperties& properties, const std::string& directory) {
+    JELLY_PROFILE_ZONE("VulkanPipelineCache::Create");
+
+    Destroy();
+
+    this->device = device;
+    this->properties = properties;
+
+    // One file per device, so machines with several GPUs keep a warm cache for each.
+    path.clear();
+    if (!directory.empty()) {
+        char name[64];
+        std::snprintf(name, sizeof(name), "pipelines-%04x-%04x.bin", properties.vendorID, properties.deviceID);
+        path = (std::filesystem::path(directory) / name).string();
+    }
+
+    std::string data;
+    loadedSize = 0;
+    loadedChecksum = 0;
+    if (!path.empty() && Load(data)) {
+        loadedSize = data.size();
+        loadedChecksum = Checksum(data.data(), data.size());
+        JELLY_LOG(LogCategory::Vulkan, LogLevel::Info, "Pipeline cache loaded: {} ({} bytes)", path, loadedSize);
+    }
+
+    VkPipelineCacheCreateInfo createInfo{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+    createInfo.initialDataSize = data.size();
+    createInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+    if (vkCreatePipelineCache(device, &createInfo, nullptr, &cache) != VK_SUCCESS) {
+        // The driver rejected the blob despite the checks; fall back to an empty cache.
+        createInfo.initialDataSize = 0;
+        createInfo.pInitialData = nullptr;
+        loadedSize = 0;
+        loadedChecksum = 0;
+        if (vkCreatePipelineCache(device, &createInfo, nullptr, &cache) != VK_SUCCESS) {
+            throw GraphicsApiException("Failed to create pipeline cache!");
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Reads and validates the cache file. Returns false if it is missing, damaged, too
+// large or written by another device or driver.
+// -----------------------------------------------------------------------------
+bool VulkanPipelineCache::Load(std::string& data) const {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    FileHeader header{};
+    const bool headerRead = std::fread(&header, sizeof(header), 1, file) == 1;
+    const bool headerValid = headerRead && std::memcmp(header.magic, FileMagic, sizeof(FileMagic)) == 0 &&
+                             header.version == FileVersion && header.dataSize >= sizeof(DriverHeader) &&
+                             header.dataSize <= MaxFileSize;
+
+    bool valid = false;
+    if (headerValid) {
+        data.resize(static_cast<std::size_t>(header.dataSize));
+        valid = std::fread(&data[0], 1, data.size(), file) == data.size() && std::fgetc(file) == EOF &&
+                Checksum(data.data(), data.size()) == header.checksum;
+    }
+    std::fclose(file);
+
+    if (!valid) {
+        JELLY_LOG(LogCategory::Vulkan, LogLevel::Warning, "Ignoring damaged pipeline cache {}", path);
+        data.clear();
+        return false;
+    }
+
+    DriverHeader driver{};
+    std::memcpy(&driver, data.data(), sizeof(driver));
+    if (header.driverVersion != properties.driverVersion || driver.headerSize < sizeof(DriverHeader) ||
+        driver.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE || driver.vendorID != properties.vendorID ||
+        driver.deviceID != properties.deviceID ||
+        std::memcmp(driver.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+        JELLY_LOG(LogCategory::Vulkan, LogLevel::Info, "Pipeline cache {} belongs to another device or driver; starting empty",
+                  path);
+        data.clear();
+        return false;
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Writes the cache next to its file, then renames it into place.
+// -----------------------------------------------------------------------------
+bool VulkanPipelineCache::Save() {
+    JELLY_PROFILE_ZONE("VulkanPipelineCache::Save");
+
+    if (cache == VK_NULL_HANDLE || path.empty()) {
+        return false;
+    }
+
+    std::size_t size = 0;
+    if (vkGetPipelineCacheData(device, cache, &size, nullptr) != VK_SUCCESS) {
+        return false;
+    }
+    if (size > MaxFileSize) {
+        JELLY_LOG(LogCategory::Vulkan, LogLevel::Warning, "Pipeline cache of {} bytes exceeds the {} byte cap; not saved",
+                  size, MaxFileSize);
+        return false;
+    }
+
+    std::string data(size, '\0');
+    if (vkGetPipelineCacheData(device, cache, &size, &data[0]) != VK_SUCCESS || size < sizeof(DriverHeader)) {
+        return false;
+    }
+    data.resize(size);
+
+    // The blob can change without changing size, so compare the contents.
+    const std::uint64_t checksum = Checksum(data.data(), data.size());
+    if (size == loadedSize && checksum == loadedChecksum) {
+        return true;
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, FileMagic, sizeof(FileMagic));
+    header.version = FileVersion;
+    header.driverVersion = properties.driverVersion;
+    header.dataSize = size;
+    header.checksum = checksum;
+
+    std::error_code error;
+    const std::filesystem::path target(path);
+    std::filesystem::create_directories(target.parent_path(), error);
+
+    const std::string temporary = path + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) {
+        JELLY_LOG(LogCategory::Vulkan, LogLevel::Warning, "Cannot write pipeline cache {}", temporary);
+        return false;
+    }
+
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    written = std::fclose(file) == 0 && written;
+
+    if (written) {
+        std::filesystem::rename(temporary, target, error);
+        written = !error;
+    }
+    if (!written) {
+        std::filesystem::remove(temporary, error);
+        JELLY_LOG(LogCategory::Vulkan, LogLevel::Warning, "Cannot write pipeline cache {}", path);
+        return false;
+    }
+
+    loadedSize = size;
+    loadedChecksum = checksum;
+    JELLY_LOG(LogCategory::Vulkan, LogLevel::Info, "Pipeline cache saved: {} ({} bytes)", path, size);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Destroys the cache handle.
+// -----------------------------------------------------------------------------
+void VulkanPipelineCache::Destroy() {
+    if (cache != VK_NULL_HANDLE) {
+        vkDestroyPipelineCache(device, cache, nullptr);
+        cache = VK_NULL_HANDLE;
+    }
+    loadedSize = 0;
+    loadedChecksum = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Picks the platform's per-user cache directory.
+// -----------------------------------------------------------------------------
+std::string VulkanPipelineCache::DefaultDirectory() {
+    std::string directory = Environment("JELLY_CACHE_DIR");
+    if (!directory.empty()) {
+        return directory;
+    }
+
+#if defined(_WIN32)
+    directory = Environment("LOCALAPPDATA");
+    return directory.empty() ? directory : directory + "\\Jelly";
+#elif defined(__APPLE__)
+    directory = Environment("HOME");
+    return directory.empty() ? directory : directory + "/Library/Caches/Jelly";
+#else
+    directory = Environment("XDG_CACHE_HOME");
+    if (!directory.empty()) {
+        return directory + "/jelly";
+    }
+    directory = Environment("HOME");
+    return directory.empty() ? directory : directory + "/.cache/jelly";
+#endif
+}
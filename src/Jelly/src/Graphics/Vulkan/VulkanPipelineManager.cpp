@@ -0,0 +1,342 @@
+#include "Graphics/Vulkan/VulkanPipelineManager.h"
+
+#include "Logger.h"
+#include "Profiling/Profiler.h"
+
+#include <cstring>
+
+namespace {
+    // -----------------------------------------------------------------------------
+    // Folds @p size bytes into a 64-bit FNV-1a hash.
+    // -----------------------------------------------------------------------------
+    std::uint64_t HashBytes(std::uint64_t hash, const void* data, std::size_t size) {
+        auto bytes = static_cast<const std::uint8_t*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Creates a shader module from SPIR-V words; returns VK_NULL_HANDLE on failure.
+    // -----------------------------------------------------------------------------
+    VkShaderModule CreateShaderModule(VkDevice device, const std::vector<std::uint32_t>& code) {
+        VkShaderModuleCreateInfo createInfo{VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
+        createInfo.codeSize = code.size() * sizeof(std::uint32_t);
+        createInfo.pCode = code.data();
+
+        VkShaderModule module = VK_NULL_HANDLE;
+        if (code.empty() || vkCreateShaderModule(device, &createInfo, nullptr, &module) != VK_SUCCESS) {
+            return VK_NULL_HANDLE;
+        }
+        return module;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Compares every field that affects the compiled pipeline.
+// -----------------------------------------------------------------------------
+bool PipelineDesc::operator==(const PipelineDesc& other) const {
+    return vertexSpirv == other.vertexSpirv && fragmentSpirv == other.fragmentSpirv &&
+           renderPass == other.renderPass && subpass == other.subpass && colorFormat == other.colorFormat &&
+           topology == other.topology &&
+           alphaBlend == other.alphaBlend && pushConstantSize == other.pushConstantSize;
+}
+
+// -----------------------------------------------------------------------------
+// Allocates the entry table.
+// -----------------------------------------------------------------------------
+void VulkanPipelineManager::Create(VkDevice device, VkPipelineCache cache, JobSystem* jobs) {
+    Destroy();
+
+    this->device = device;
+    this->cache = cache;
+    this->jobs = jobs;
+    entries = std::make_unique<Entry[]>(MaxPipelines);
+}
+
+// -----------------------------------------------------------------------------
+// Lets pending compilations finish, then destroys every pipeline and layout.
+// -----------------------------------------------------------------------------
+void VulkanPipelineManager::Destroy() {
+    if (!entries) {
+        return;
+    }
+
+    if (jobs) {
+        jobs->Wait(compiles);
+    }
+
+    const std::uint32_t count = entryCount.load(std::memory_order_acquire);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        Entry& entry = entries[i];
+        if (entry.pipeline != VK_NULL_HANDLE) {
+            vkDestroyPipeline(device, entry.pipeline, nullptr);
+        }
+        if (entry.layout != VK_NULL_HANDLE) {
+            vkDestroyPipelineLayout(device, entry.layout, nullptr);
+        }
+    }
+
+    entries.reset();
+    entryCount.store(0, std::memory_order_relaxed);
+    lookup.clear();
+}
+
+// -----------------------------------------------------------------------------
+// Returns an existing handle for the same description or queues a new compilation.
+// -----------------------------------------------------------------------------
+PipelineHandle VulkanPipelineManager::Request(const PipelineDesc& desc, ReadyCallback callback, void* userData) {
+    if (!entries) {
+        return 0;
+    }
+
+    const std::uint64_t hash = Hash(desc);
+    std::unique_lock<std::mutex> lock(mutex);
+
+    auto range = lookup.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        Entry& entry = entries[it->second];
+        if (!(entry.desc == desc)) {
+            continue;
+        }
+
+        const PipelineHandle handle = it->second + 1;
+        const PipelineState state = entry.state.load(std::memory_order_acquire);
+        if (state == PipelineState::Pending) {
+            if (callback) {
+                entry.callbacks.emplace_back(callback, userData);
+            }
+            return handle;
+        }
+
+        // Finished pipelines report outside the lock, so the callback may request more.
+        lock.unlock();
+        if (callback) {
+            callback(userData, handle, state == PipelineState::Ready);
+        }
+        return handle;
+    }
+
+    const std::uint32_t index = entryCount.load(std::memory_order_relaxed);
+    if (index == MaxPipelines) {
+        lock.unlock();
+        JELLY_LOG(LogCategory::Vulkan, LogLevel::Warning, "Pipeline limit of {} reached", MaxPipelines);
+        return 0;
+    }
+
+    Entry& entry = entries[index];
+    entry.desc = desc;
+    if (callback) {
+        entry.callbacks.emplace_back(callback, userData);
+    }
+    lookup.emplace(hash, index);
+    entryCount.store(index + 1, std::memory_order_release);
+    lock.unlock();
+
+    if (jobs) {
+        jobs->Schedule(&CompileJob, this, index, index + 1, &compiles);
+    } else {
+        Compile(index);
+    }
+    return index + 1;
+}
+
+// -----------------------------------------------------------------------------
+// Returns the entry of a handle, or null for 0 and handles never issued.
+// -----------------------------------------------------------------------------
+const VulkanPipelineManager::Entry* VulkanPipelineManager::Find(PipelineHandle handle) const {
+    if (handle == 0 || handle > entryCount.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    return &entries[handle - 1];
+}
+
+// -----------------------------------------------------------------------------
+// Reads the compile state without blocking.
+// -----------------------------------------------------------------------------
+PipelineState VulkanPipelineManager::GetState(PipelineHandle handle) const {
+    const Entry* entry = Find(handle);
+    return entry ? entry->state.load(std::memory_order_acquire) : PipelineState::Failed;
+}
+
+// -----------------------------------------------------------------------------
+// Returns the pipeline once it is ready.
+// -----------------------------------------------------------------------------
+VkPipeline VulkanPipelineManager::Get(PipelineHandle handle) const {
+    const Entry* entry = Find(handle);
+    return entry && entry->state.load(std::memory_order_acquire) == PipelineState::Ready ? entry->pipeline
+                                                                                           : VK_NULL_HANDLE;
+}
+
+// -----------------------------------------------------------------------------
+// Returns the layout once the pipeline is ready.
+// -----------------------------------------------------------------------------
+VkPipelineLayout VulkanPipelineManager::GetLayout(PipelineHandle handle) const {
+    const Entry* entry = Find(handle);
+    return entry && entry->state.load(std::memory_order_acquire) == PipelineState::Ready ? entry->layout
+                                                                                           : VK_NULL_HANDLE;
+}
+
+// -----------------------------------------------------------------------------
+// Picks the requested pipeline, its fallback, or nothing.
+// -----------------------------------------------------------------------------
+VkPipeline VulkanPipelineManager::Resolve(PipelineHandle handle, PipelineHandle fallback) const {
+    const VkPipeline pipeline = Get(handle);
+    return pipeline != VK_NULL_HANDLE ? pipeline : Get(fallback);
+}
+
+// -----------------------------------------------------------------------------
+// Job entry point; compiles the slots in [begin, end).
+// -----------------------------------------------------------------------------
+void VulkanPipelineManager::CompileJob(void* context, std::uint32_t begin, std::uint32_t end) {
+    auto* manager = static_cast<VulkanPipelineManager*>(context);
+    for (std::uint32_t index = begin; index < end; ++index) {
+        manager->Compile(index);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Builds the layout and pipeline of one slot, publishes the result and runs the callbacks.
+// -----------------------------------------------------------------------------
+void VulkanPipelineManager::Compile(std::uint32_t index) {
+    JELLY_PROFILE_ZONE("VulkanPipelineManager::Compile");
+
+    Entry& entry = entries[index];
+    const PipelineDesc& desc = entry.desc;
+
+    VkShaderModule vertexModule = CreateShaderModule(device, desc.vertexSpirv);
+    VkShaderModule fragmentModule = CreateShaderModule(device, desc.fragmentSpirv);
+
+    VkPushConstantRange pushConstants{};
+    pushConstants.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    pushConstants.size = desc.pushConstantSize;
+
+    VkPipelineLayoutCreateInfo layoutInfo{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
+    layoutInfo.pushConstantRangeCount = desc.pushConstantSize > 0 ? 1 : 0;
+    layoutInfo.pPushConstantRanges = &pushConstants;
+
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    if (vertexModule != VK_NULL_HANDLE && fragmentModule != VK_NULL_HANDLE &&
+        vkCreatePipelineLayout(device, &layoutInfo, nullptr, &layout) == VK_SUCCESS) {
+        VkPipelineShaderStageCreateInfo stages[2] = {};
+        stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+        stages[0].module = vertexModule;
+        stages[0].pName = "main";
+        stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+        stages[1].module = fragmentModule;
+        stages[1].pName = "main";
+
+        VkPipelineVertexInputStateCreateInfo vertexInput{VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO};
+
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly{VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO};
+        inputAssembly.topology = desc.topology;
+
+        VkPipelineViewportStateCreateInfo viewportState{VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO};
+        viewportState.viewportCount = 1;
+        viewportState.scissorCount = 1;
+
+        VkPipelineRasterizationStateCreateInfo rasterizer{VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO};
+        rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+        rasterizer.cullMode = VK_CULL_MODE_NONE;
+        rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        rasterizer.lineWidth = 1.0f;
+
+        VkPipelineMultisampleStateCreateInfo multisampling{VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO};
+        multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+        VkPipelineColorBlendAttachmentState blendAttachment{};
+        blendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                                         VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+        if (desc.alphaBlend) {
+            blendAttachment.blendEnable = VK_TRUE;
+            blendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+            blendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+            blendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+            blendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+            blendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+            blendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+        }
+
+        VkPipelineColorBlendStateCreateInfo colorBlend{VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO};
+        colorBlend.attachmentCount = 1;
+        colorBlend.pAttachments = &blendAttachment;
+
+        const VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+        VkPipelineDynamicStateCreateInfo dynamicState{VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO};
+        dynamicState.dynamicStateCount = 2;
+        dynamicState.pDynamicStates = dynamicStates;
+
+        VkGraphicsPipelineCreateInfo pipelineInfo{VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO};
+        pipelineInfo.stageCount = 2;
+        pipelineInfo.pStages = stages;
+        pipelineInfo.pVertexInputState = &vertexInput;
+        pipelineInfo.pInputAssemblyState = &inputAssembly;
+        pipelineInfo.pViewportState = &viewportState;
+        pipelineInfo.pRasterizationState = &rasterizer;
+        pipelineInfo.pMultisampleState = &multisampling;
+        pipelineInfo.pColorBlendState = &colorBlend;
+        pipelineInfo.pDynamicState = &dynamicState;
+        pipelineInfo.layout = layout;
+        pipelineInfo.renderPass = desc.renderPass;
+        pipelineInfo.subpass = desc.subpass;
+
+        // Without a render pass the pipeline is only tied to the attachment format.
+        VkPipelineRenderingCreateInfoKHR renderingInfo{};
+        renderingInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+        renderingInfo.colorAttachmentCount = 1;
+        renderingInfo.pColorAttachmentFormats = &desc.colorFormat;
+        if (desc.renderPass == VK_NULL_HANDLE) {
+            pipelineInfo.pNext = &renderingInfo;
+        }
+
+        // The cache is internally synchronized, so every worker compiles against it at once.
+        if (vkCreateGraphicsPipelines(device, cache, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+            pipeline = VK_NULL_HANDLE;
+        }
+    }
+
+    if (vertexModule != VK_NULL_HANDLE) {
+        vkDestroyShaderModule(device, vertexModule, nullptr);
+    }
+    if (fragmentModule != VK_NULL_HANDLE) {
+        vkDestroyShaderModule(device, fragmentModule, nullptr);
+    }
+
+    const bool succeeded = pipeline != VK_NULL_HANDLE;
+    if (!succeeded) {
+        JELLY_LOG(LogCategory::Vulkan, LogLevel::Error, "Failed to compile pipeline {}", index + 1);
+    }
+
+    std::vector<std::pair<ReadyCallback, void*>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entry.pipeline = pipeline;
+        entry.layout = layout;
+        entry.state.store(succeeded ? PipelineState::Ready : PipelineState::Failed, std::memory_order_release);
+        callbacks.swap(entry.callbacks);
+    }
+
+    for (const auto& callback : callbacks) {
+        callback.first(callback.second, index + 1, succeeded);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Hashes a description for the duplicate lookup.
+// -----------------------------------------------------------------------------
+std::uint64_t VulkanPipelineManager::Hash(const PipelineDesc& desc) {
+    std::uint64_t hash = 14695981039346656037ull;
+    hash = HashBytes(hash, desc.vertexSpirv.data(), desc.vertexSpirv.size() * sizeof(std::uint32_t));
+    hash = HashBytes(hash, desc.fragmentSpirv.data(), desc.fragmentSpirv.size() * sizeof(std::uint32_t));
+    hash = HashBytes(hash, &desc.renderPass, sizeof(desc.renderPass));
+    hash = HashBytes(hash, &desc.subpass, sizeof(desc.subpass));
+    hash = HashBytes(hash, &desc.colorFormat, sizeof(desc.colorFormat));
+    hash = HashBytes(hash, &desc.topology, sizeof(desc.topology));
+    hash = HashBytes(hash, &desc.alphaBlend, sizeof(desc.alphaBlend));
+    hash = HashBytes(hash, &desc.pushConstantSize, sizeof(desc.pushConstantSize));
+    return hash;
+}
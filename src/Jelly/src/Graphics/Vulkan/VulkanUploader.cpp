@@ -0,0 +1,582 @@
+#include "Graphics/Vulkan/VulkanUploader.h"
+
+#include "Logger.h"
+#include "Graphics/GraphicsApiException.h"
+#include "Graphics/Vulkan/VulkanGraphicsAPI.h"
+#include "Profiling/Profiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+namespace {
+    // -----------------------------------------------------------------------------
+    // Rounds @p value up to a multiple of @p alignment.
+    // -----------------------------------------------------------------------------
+    VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Returns true if an image upload can be copied in row chunks: single 2D layer and a
+    // queue that allows partial copies (a zero granularity only copies whole mip levels).
+    // -----------------------------------------------------------------------------
+    bool SplitsRows(const VulkanImageUpload& target, const VkExtent3D& granularity) {
+        return target.extent.depth == 1 && target.subresource.layerCount == 1 && granularity.height > 0;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Builds a layout transition covering the subresource a copy writes.
+    // -----------------------------------------------------------------------------
+    VkImageMemoryBarrier LayoutBarrier(VkImage image, const VkImageSubresourceLayers& layers, VkImageLayout from,
+                                       VkImageLayout to, VkAccessFlags srcAccess, VkAccessFlags dstAccess) {
+        VkImageMemoryBarrier barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+        barrier.srcAccessMask = srcAccess;
+        barrier.dstAccessMask = dstAccess;
+        barrier.oldLayout = from;
+        barrier.newLayout = to;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = image;
+        barrier.subresourceRange = {layers.aspectMask, layers.mipLevel, 1, layers.baseArrayLayer, layers.layerCount};
+        return barrier;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Creates the mapped staging buffer, the transfer command pool and the timeline.
+// -----------------------------------------------------------------------------
+void VulkanUploader::Create(VulkanGraphicsAPI& graphics, VkDeviceSize capacity) {
+    Destroy();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    this->graphics = &graphics;
+    device = graphics.GetDevice();
+
+    const VulkanDeviceCapabilities& capabilities = graphics.GetCapabilities();
+    const VkPhysicalDeviceLimits& limits = capabilities.properties.limits;
+    atomSize = std::max<VkDeviceSize>(limits.nonCoherentAtomSize, 1);
+    alignment = std::max<VkDeviceSize>(limits.optimalBufferCopyOffsetAlignment, 16);
+    this->capacity = AlignUp(capacity, std::lcm(atomSize, alignment));
+
+    const uint32_t family = graphics.GetQueueFamily(VulkanQueueType::Transfer);
+    granularity = capabilities.queueFamilyProperties[family].minImageTransferGranularity;
+
+    VkBufferCreateInfo bufferInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    bufferInfo.size = this->capacity;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &staging) != VK_SUCCESS) {
+        throw GraphicsApiException("Failed to create upload staging buffer!");
+    }
+
+    // Atom-aligned, so flushes of non-coherent memory never touch a neighbouring allocation.
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device, staging, &requirements);
+    requirements.alignment = std::max(requirements.alignment, atomSize);
+    requirements.size = AlignUp(requirements.size, atomSize);
+
+    // Cached system memory keeps the ring out of the small device-local host-visible heap.
+    // Coherence is not required: FlushMappedRange writes back staged bytes otherwise.
+    stagingMemory = graphics.GetMemoryAllocator().Allocate(
+        requirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+        VulkanResourceTiling::Linear);
+    if (!stagingMemory || !stagingMemory->mapped ||
+        vkBindBufferMemory(device, staging, stagingMemory->memory, stagingMemory->offset) != VK_SUCCESS) {
+        throw GraphicsApiException("Failed to allocate upload staging memory!");
+    }
+    mapped = static_cast<std::uint8_t*>(stagingMemory->mapped);
+    coherent = (capabilities.memoryProperties.memoryTypes[stagingMemory->memoryType].propertyFlags &
+                VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+    VkCommandPoolCreateInfo poolInfo{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = family;
+    if (vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {
+        throw GraphicsApiException("Failed to create upload command pool!");
+    }
+
+    if (graphics.HasTimelineSemaphores()) {
+        VkSemaphoreTypeCreateInfoKHR typeInfo{};
+        typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+        typeInfo.initialValue = 0;
+
+        VkSemaphoreCreateInfo semaphoreInfo{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+        semaphoreInfo.pNext = &typeInfo;
+        if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &timeline) != VK_SUCCESS) {
+            throw GraphicsApiException("Failed to create upload timeline semaphore!");
+        }
+    }
+
+    JELLY_LOG(LogCategory::Vulkan, LogLevel::Info, "Upload ring: {} MiB on the {} queue, {} completion",
+              this->capacity >> 20, graphics.HasDedicatedQueue(VulkanQueueType::Transfer) ? "transfer" : "graphics",
+              timeline != VK_NULL_HANDLE ? "timeline" : "fence");
+}
+
+// -----------------------------------------------------------------------------
+// Releases the ring, the batches and their synchronization objects.
+// -----------------------------------------------------------------------------
+void VulkanUploader::Destroy() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (device == VK_NULL_HANDLE) {
+        return;
+    }
+
+    for (const Batch& batch : inFlight) {
+        vkDestroyFence(device, batch.fence, nullptr);
+    }
+    for (const Batch& batch : freeBatches) {
+        vkDestroyFence(device, batch.fence, nullptr);
+    }
+    inFlight.clear();
+    freeBatches.clear();
+
+    vkDestroyCommandPool(device, commandPool, nullptr);
+    vkDestroySemaphore(device, timeline, nullptr);
+    vkDestroyBuffer(device, staging, nullptr);
+    graphics->GetMemoryAllocator().Free(stagingMemory);
+
+    commandPool = VK_NULL_HANDLE;
+    timeline = VK_NULL_HANDLE;
+    staging = VK_NULL_HANDLE;
+    stagingMemory = nullptr;
+    mapped = nullptr;
+    head = tail = flushed = 0;
+    submittedValue = 0;
+
+    bufferRegions.clear();
+    imageRegions.clear();
+    backlog.clear();
+    backlogBytes = 0;
+    frameBytes = 0;
+    nextTicket = 1;
+    stagedTicket = 0;
+    completedTicket.store(0, std::memory_order_release);
+
+    graphics = nullptr;
+    device = VK_NULL_HANDLE;
+}
+
+// -----------------------------------------------------------------------------
+// Queues a buffer upload.
+// -----------------------------------------------------------------------------
+UploadTicket VulkanUploader::UploadBuffer(VkBuffer buffer, VkDeviceSize offset, const void* data, VkDeviceSize size) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (device == VK_NULL_HANDLE || buffer == VK_NULL_HANDLE || size == 0) {
+        return 0;
+    }
+
+    PendingUpload upload;
+    upload.buffer = buffer;
+    upload.bufferOffset = offset;
+    upload.size = size;
+    return Queue(upload, static_cast<const std::uint8_t*>(data));
+}
+
+// -----------------------------------------------------------------------------
+// Queues an image upload, rejecting regions whose smallest chunk cannot fit the ring.
+// -----------------------------------------------------------------------------
+UploadTicket VulkanUploader::UploadImage(const VulkanImageUpload& target, const void* data) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const VkExtent3D& extent = target.extent;
+    if (device == VK_NULL_HANDLE || target.image == VK_NULL_HANDLE || target.texelSize == 0 || extent.width == 0 ||
+        extent.height == 0 || extent.depth == 0 || target.subresource.layerCount == 0) {
+        return 0;
+    }
+
+    const VkDeviceSize rowBytes = VkDeviceSize(target.texelSize) * extent.width;
+    const VkDeviceSize size = rowBytes * extent.height * extent.depth * target.subresource.layerCount;
+    const VkDeviceSize unit = SplitsRows(target, granularity)
+                                  ? rowBytes * std::min(granularity.height, extent.height)
+                                  : size;
+    if (unit + std::lcm(alignment, VkDeviceSize(target.texelSize)) > capacity) {
+        JELLY_LOG(LogCategory::Vulkan, LogLevel::Error, "Image upload chunk of {} bytes does not fit the {} byte staging ring",
+                  unit, capacity);
+        return 0;
+    }
+
+    PendingUpload upload;
+    upload.image = target;
+    upload.size = size;
+    return Queue(upload, static_cast<const std::uint8_t*>(data));
+}
+
+// -----------------------------------------------------------------------------
+// Stages what fits right away when nothing is queued ahead; the rest is copied into
+// the backlog.
+// -----------------------------------------------------------------------------
+UploadTicket VulkanUploader::Queue(PendingUpload& upload, const std::uint8_t* data) {
+    upload.ticket = nextTicket++;
+    if (backlog.empty() && Stage(upload, data)) {
+        stagedTicket = upload.ticket;
+        return upload.ticket;
+    }
+
+    upload.dataStart = upload.consumed;
+    upload.data.assign(data + upload.consumed, data + upload.size);
+    backlogBytes += upload.size - upload.consumed;
+    backlog.push_back(std::move(upload));
+    return backlog.back().ticket;
+}
+
+// -----------------------------------------------------------------------------
+// Retires finished batches and resets the frame budget.
+// -----------------------------------------------------------------------------
+void VulkanUploader::BeginFrame() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (device == VK_NULL_HANDLE) {
+        return;
+    }
+
+    Retire();
+    frameBytes = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Streams the backlog, then records and submits every pending copy as one batch.
+// -----------------------------------------------------------------------------
+void VulkanUploader::Flush(VkSemaphore& waitSemaphore, std::uint64_t& waitValue) {
+    JELLY_PROFILE_ZONE("VulkanUploader::Flush");
+
+    waitSemaphore = VK_NULL_HANDLE;
+    waitValue = 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (device == VK_NULL_HANDLE) {
+        return;
+    }
+
+    Retire();
+
+    while (!backlog.empty()) {
+        PendingUpload& upload = backlog.front();
+        const VkDeviceSize before = upload.consumed;
+        const bool staged = Stage(upload, upload.data.data() + (upload.consumed - upload.dataStart));
+        backlogBytes -= upload.consumed - before;
+        if (!staged) {
+            break;
+        }
+        stagedTicket = upload.ticket;
+        backlog.pop_front();
+    }
+
+    if (bufferRegions.empty() && imageRegions.empty()) {
+        return;
+    }
+
+    // Every batch is still in flight; the staged regions go out with the next frame.
+    Batch batch;
+    if (!freeBatches.empty()) {
+        batch = freeBatches.back();
+        freeBatches.pop_back();
+    } else if (inFlight.size() < MaxBatches) {
+        VkCommandBufferAllocateInfo allocateInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+        allocateInfo.commandPool = commandPool;
+        allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocateInfo.commandBufferCount = 1;
+        if (vkAllocateCommandBuffers(device, &allocateInfo, &batch.commandBuffer) != VK_SUCCESS) {
+            throw GraphicsApiException("Failed to allocate upload command buffer!");
+        }
+        if (timeline == VK_NULL_HANDLE) {
+            VkFenceCreateInfo fenceInfo{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+            if (vkCreateFence(device, &fenceInfo, nullptr, &batch.fence) != VK_SUCCESS) {
+                throw GraphicsApiException("Failed to create upload fence!");
+            }
+        }
+    } else {
+        return;
+    }
+
+    FlushMappedRange();
+
+    VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(batch.commandBuffer, &beginInfo);
+    RecordBatch(batch.commandBuffer);
+    if (vkEndCommandBuffer(batch.commandBuffer) != VK_SUCCESS) {
+        throw GraphicsApiException("Failed to record upload command buffer!");
+    }
+
+    batch.value = ++submittedValue;
+    batch.ringEnd = head;
+    batch.lastTicket = stagedTicket;
+
+    VulkanQueueSubmission submission;
+    submission.commandBuffers = &batch.commandBuffer;
+    submission.commandBufferCount = 1;
+    if (timeline != VK_NULL_HANDLE) {
+        submission.signalSemaphores = &timeline;
+        submission.signalValues = &batch.value;
+        submission.signalSemaphoreCount = 1;
+    }
+    submission.fence = batch.fence;
+
+    if (graphics->Submit(VulkanQueueType::Transfer, submission) != VK_SUCCESS) {
+        throw GraphicsApiException("Failed to submit upload batch!");
+    }
+
+    inFlight.push_back(batch);
+    bufferRegions.clear();
+    imageRegions.clear();
+
+    // Without a timeline the frame does not wait; IsComplete turns true once the fence has.
+    if (timeline != VK_NULL_HANDLE) {
+        waitSemaphore = timeline;
+        waitValue = batch.value;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Sets the per-frame staging budget.
+// -----------------------------------------------------------------------------
+void VulkanUploader::SetFrameBudget(VkDeviceSize bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    frameBudget = bytes;
+}
+
+// -----------------------------------------------------------------------------
+// Returns the bytes still waiting in the backlog.
+// -----------------------------------------------------------------------------
+VkDeviceSize VulkanUploader::GetBacklogBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return backlogBytes;
+}
+
+// -----------------------------------------------------------------------------
+// Reserves a ring range of at least @p unit and at most @p maxSize bytes, a multiple of
+// @p unit, starting at a buffer offset aligned to @p align. Wraps to the start of the
+// buffer when the end is too short. Returns false if the ring is full.
+// -----------------------------------------------------------------------------
+bool VulkanUploader::Reserve(VkDeviceSize unit, VkDeviceSize maxSize, VkDeviceSize align, VkDeviceSize& size,
+                             VkDeviceSize& offset) {
+    auto place = [&](std::uint64_t position) {
+        const VkDeviceSize start = position % capacity;
+        const VkDeviceSize aligned = AlignUp(start, align);
+        position += aligned - start;
+        if (aligned >= capacity || position >= tail + capacity) {
+            return false;
+        }
+
+        const VkDeviceSize available = std::min(capacity - aligned, tail + capacity - position);
+        if (available < unit) {
+            return false;
+        }
+
+        size = std::min(available, maxSize);
+        size -= size % unit;
+        offset = aligned;
+        head = position + size;
+        return true;
+    };
+
+    return place(head) || place((head / capacity + 1) * capacity);
+}
+
+// -----------------------------------------------------------------------------
+// Copies as much of @p upload as the budget and ring allow. @p data points at the
+// first byte not staged yet. Returns true once all of it is staged.
+// -----------------------------------------------------------------------------
+bool VulkanUploader::Stage(PendingUpload& upload, const std::uint8_t* data) {
+    return upload.buffer != VK_NULL_HANDLE ? StageBuffer(upload, data) : StageImage(upload, data);
+}
+
+// -----------------------------------------------------------------------------
+// Stages a buffer upload in chunks of whatever contiguous space the ring has.
+// -----------------------------------------------------------------------------
+bool VulkanUploader::StageBuffer(PendingUpload& upload, const std::uint8_t* data) {
+    while (upload.consumed < upload.size) {
+        const VkDeviceSize allowed = std::min(upload.size - upload.consumed, Budget(1));
+        VkDeviceSize size = 0, offset = 0;
+        if (allowed == 0 || !Reserve(1, allowed, alignment, size, offset)) {
+            return false;
+        }
+
+        std::memcpy(mapped + offset, data, static_cast<std::size_t>(size));
+        bufferRegions.push_back({upload.buffer, {offset, upload.bufferOffset + upload.consumed, size}});
+
+        data += size;
+        upload.consumed += size;
+        frameBytes += size;
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Stages an image upload, in chunks of whole rows (a multiple of the queue's transfer
+// granularity) when the region allows it, otherwise in one piece.
+// -----------------------------------------------------------------------------
+bool VulkanUploader::StageImage(PendingUpload& upload, const std::uint8_t* data) {
+    const VulkanImageUpload& target = upload.image;
+    const bool splitRows = SplitsRows(target, granularity);
+    const VkDeviceSize rowBytes = VkDeviceSize(target.texelSize) * target.extent.width;
+    const VkDeviceSize chunkBytes = splitRows ? rowBytes * granularity.height : upload.size;
+    const VkDeviceSize align = std::lcm(alignment, VkDeviceSize(target.texelSize));
+
+    while (upload.consumed < upload.size) {
+        const VkDeviceSize remaining = upload.size - upload.consumed;
+        const VkDeviceSize unit = std::min(remaining, chunkBytes);
+        VkDeviceSize allowed = std::min(remaining, Budget(unit));
+        allowed -= allowed % unit;
+
+        VkDeviceSize size = 0, offset = 0;
+        if (allowed == 0 || !Reserve(unit, allowed, align, size, offset)) {
+            return false;
+        }
+
+        std::memcpy(mapped + offset, data, static_cast<std::size_t>(size));
+
+        ImageRegion region{};
+        region.image = target.image;
+        region.finalLayout = target.finalLayout;
+        region.first = upload.consumed == 0;
+        region.last = upload.consumed + size == upload.size;
+        region.copy.bufferOffset = offset;
+        region.copy.imageSubresource = target.subresource;
+        region.copy.imageOffset = target.offset;
+        region.copy.imageExtent = target.extent;
+        if (splitRows) {
+            region.copy.imageOffset.y += static_cast<int32_t>(upload.consumed / rowBytes);
+            region.copy.imageExtent.height = static_cast<uint32_t>(size / rowBytes);
+        }
+        imageRegions.push_back(region);
+
+        data += size;
+        upload.consumed += size;
+        frameBytes += size;
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Returns the bytes the frame may still stage. A frame that has staged nothing may
+// always take one @p unit, so chunks larger than the budget still make progress.
+// -----------------------------------------------------------------------------
+VkDeviceSize VulkanUploader::Budget(VkDeviceSize unit) const {
+    if (frameBudget == 0) {
+        return std::numeric_limits<VkDeviceSize>::max();
+    }
+
+    const VkDeviceSize left = frameBudget > frameBytes ? frameBudget - frameBytes : 0;
+    return left < unit && frameBytes == 0 ? unit : left;
+}
+
+// -----------------------------------------------------------------------------
+// Frees the ring space and batches of submissions the GPU has finished.
+// -----------------------------------------------------------------------------
+void VulkanUploader::Retire() {
+    const std::uint64_t reached = timeline != VK_NULL_HANDLE ? graphics->GetSemaphoreCounterValue(timeline) : 0;
+
+    while (!inFlight.empty()) {
+        Batch& batch = inFlight.front();
+        const bool finished = timeline != VK_NULL_HANDLE ? batch.value <= reached
+                                                         : vkGetFenceStatus(device, batch.fence) == VK_SUCCESS;
+        if (!finished) {
+            break;
+        }
+
+        if (batch.fence != VK_NULL_HANDLE) {
+            vkResetFences(device, 1, &batch.fence);
+        }
+        tail = batch.ringEnd;
+        completedTicket.store(batch.lastTicket, std::memory_order_release);
+        freeBatches.push_back(batch);
+        inFlight.pop_front();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Records the pending regions: transitions for images seen for the first time, one
+// copy command per destination, then transitions to each image's final layout.
+// -----------------------------------------------------------------------------
+void VulkanUploader::RecordBatch(VkCommandBuffer commandBuffer) {
+    std::vector<VkImageMemoryBarrier> barriers;
+    for (const ImageRegion& region : imageRegions) {
+        if (region.first) {
+            barriers.push_back(LayoutBarrier(region.image, region.copy.imageSubresource, VK_IMAGE_LAYOUT_UNDEFINED,
+                                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, VK_ACCESS_TRANSFER_WRITE_BIT));
+        }
+    }
+    if (!barriers.empty()) {
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0,
+                             nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
+    }
+
+    std::stable_sort(bufferRegions.begin(), bufferRegions.end(),
+                     [](const BufferRegion& a, const BufferRegion& b) { return a.buffer < b.buffer; });
+    std::vector<VkBufferCopy> bufferCopies;
+    for (std::size_t i = 0; i < bufferRegions.size();) {
+        bufferCopies.clear();
+        const VkBuffer buffer = bufferRegions[i].buffer;
+        for (; i < bufferRegions.size() && bufferRegions[i].buffer == buffer; ++i) {
+            bufferCopies.push_back(bufferRegions[i].copy);
+        }
+        vkCmdCopyBuffer(commandBuffer, staging, buffer, static_cast<uint32_t>(bufferCopies.size()), bufferCopies.data());
+    }
+
+    std::stable_sort(imageRegions.begin(), imageRegions.end(),
+                     [](const ImageRegion& a, const ImageRegion& b) { return a.image < b.image; });
+    std::vector<VkBufferImageCopy> imageCopies;
+    for (std::size_t i = 0; i < imageRegions.size();) {
+        imageCopies.clear();
+        const VkImage image = imageRegions[i].image;
+        for (; i < imageRegions.size() && imageRegions[i].image == image; ++i) {
+            imageCopies.push_back(imageRegions[i].copy);
+        }
+        vkCmdCopyBufferToImage(commandBuffer, staging, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               static_cast<uint32_t>(imageCopies.size()), imageCopies.data());
+    }
+
+    // The graphics queue waits on the batch, so nothing downstream needs to be named here.
+    barriers.clear();
+    for (const ImageRegion& region : imageRegions) {
+        if (region.last) {
+            barriers.push_back(LayoutBarrier(region.image, region.copy.imageSubresource,
+                                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, region.finalLayout,
+                                             VK_ACCESS_TRANSFER_WRITE_BIT, 0));
+        }
+    }
+    if (!barriers.empty()) {
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0,
+                             nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Makes the bytes staged since the last flush visible to the device when the ring's
+// memory is not host coherent.
+// -----------------------------------------------------------------------------
+void VulkanUploader::FlushMappedRange() {
+    if (coherent || flushed == head) {
+        flushed = head;
+        return;
+    }
+
+    VkMappedMemoryRange ranges[2];
+    uint32_t rangeCount = 0;
+    auto addRange = [&](VkDeviceSize begin, VkDeviceSize end) {
+        const VkDeviceSize first = (stagingMemory->offset + begin) / atomSize * atomSize;
+        VkMappedMemoryRange& range = ranges[rangeCount++];
+        range = {VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE};
+        range.memory = stagingMemory->memory;
+        range.offset = first;
+        range.size = AlignUp(stagingMemory->offset + end, atomSize) - first;
+    };
+
+    const VkDeviceSize begin = flushed % capacity;
+    const VkDeviceSize end = head % capacity;
+    if (head - flushed >= capacity) {
+        addRange(0, capacity);
+    } else if (begin < end) {
+        addRange(begin, end);
+    } else {
+        addRange(begin, capacity);
+        if (end > 0) {
+            addRange(0, end);
+        }
+    }
+
+    vkFlushMappedMemoryRanges(device, rangeCount, ranges);
+    flushed = head;
+}
@@ -1,71 +1,372 @@
 #include "JellyEngine.h"
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "Logger.h"
+#include "Profiling/Profiler.h"
 #include "Graphics/GraphicsAPIType.h"
 #include "Graphics/GraphicsAPIFactory.h"
 #include "Window/GLFWindowSystem.h"
+#include "Window/NullWindowSystem.h"
+
+namespace {
+    /// Sleep per Tick while the window is minimized and no frame is drawn.
+    constexpr auto MinimizedIdleInterval = std::chrono::milliseconds(10);
+}
+
+// -----------------------------------------------------------------------------
+// Joins the render thread, so an engine torn down without Shutdown (e.g. by the
+// engine pool at process exit) does not destroy a joinable std::thread. Also
+// releases async logging for engines whose Initialize failed.
+// -----------------------------------------------------------------------------
+JellyEngine::~JellyEngine() {
+    StopRenderThread();
+    StopAsyncLogging();
+}
 
 // -----------------------------------------------------------------------------
 // Initializes the engine with the selected graphics API and window settings.
 // -----------------------------------------------------------------------------
 bool JellyEngine::Initialize(GraphicsAPIType apiType, const WindowSettings& settings) {
+    JELLY_PROFILE_THREAD("Main");
+
+    // Keep console writes off the calling (render) thread from here on. The logger is
+    // shared by every engine in the process and stops with the last one.
+    Logger::StartAsync();
+    asyncLogging = true;
+
+    // One worker per spare hardware thread; the calling thread runs jobs while it waits.
+    const std::uint32_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    jobs = std::make_unique<JobSystem>(hardware - 1);
+    JELLY_LOG(LogCategory::Engine, LogLevel::Info, "Job system started with {} thread(s)", jobs->GetThreadCount());
+
     try {
-        window = std::make_unique<GLFWindowSystem>();
+        if (settings.headless) {
+            window = std::make_unique<NullWindowSystem>();
+        } else {
+            window = std::make_unique<GLFWindowSystem>();
+        }
         window->CreateWindow(settings);
 
         graphics = GraphicsAPIFactory::Create(apiType);
 
         if (!graphics) {
-            std::cerr << "Unsupported graphics API\n";
+            Logger::Log(LogCategory::Engine, LogLevel::Error, "Unsupported graphics API");
+            StopAsyncLogging();
             return false;
         }
 
+        graphics->SetJobSystem(jobs.get());
+        graphics->SetFramesInFlight(settings.framesInFlight);
+        graphics->SetPresentMode(settings.vsync ? PresentMode::Fifo : PresentMode::Mailbox, false);
         graphics->Initialize(window.get());
 
-        graphics->BeginFrame();
-        graphics->EndFrame();
+        if (graphics->BeginFrame()) {
+            graphics->EndFrame();
+        }
 
         window->ShowWindow();
 
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "Failed to initialize JellyEngine: " << e.what() << "\n";
+        JELLY_LOG(LogCategory::Engine, LogLevel::Error, "Failed to initialize JellyEngine: {}", e.what());
+        StopAsyncLogging();
         return false;
     }
 }
 
 // -----------------------------------------------------------------------------
-// Returns true if the window is still open.
+// Returns true if the window is still open and rendering has not failed.
 // -----------------------------------------------------------------------------
 bool JellyEngine::IsRunning() {
-    return window && window->IsWindowOpen();
+    return window && window->IsWindowOpen() && !renderFailed.load(std::memory_order_acquire);
 }
 
 // -----------------------------------------------------------------------------
-// Polls input and window system events.
+// Polls input and window system events and forwards resizes to the graphics API.
 // -----------------------------------------------------------------------------
 void JellyEngine::PollEvents() {
-    if (window) {
-        window->PollEvents();
+    if (!window) {
+        return;
+    }
+
+    // In low-latency mode input is sampled only once the previous frame is on screen. The
+    // render thread presents on its own schedule, so the wait only applies without it.
+    if (graphics && !renderThread.joinable()) {
+        graphics->WaitForPresent();
+    }
+
+    window->PollEvents();
+
+    const InputEventBuffer& events = window->GetInputEvents();
+    for (uint32_t i = 0; i < events.Size(); ++i) {
+        if (events.Data()[i].type == InputEventType::Resize) {
+            graphics->NotifyResized();
+            break;
+        }
     }
 }
 
+// -----------------------------------------------------------------------------
+// Resizes the null window of a headless engine and flags the targets for rebuild.
+// -----------------------------------------------------------------------------
+bool JellyEngine::ResizeTarget(uint32_t width, uint32_t height) {
+    auto* target = dynamic_cast<NullWindowSystem*>(window.get());
+    if (!target || !graphics) {
+        return false;
+    }
+
+    target->Resize(width, height);
+    graphics->NotifyResized();
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Returns the input events of the last poll (empty before the window exists).
+// -----------------------------------------------------------------------------
+const InputEventBuffer& JellyEngine::GetInputEvents() const {
+    static const InputEventBuffer empty(0);
+    return window ? window->GetInputEvents() : empty;
+}
+
 // -----------------------------------------------------------------------------
 /// Renders a single frame by beginning and ending the graphics API frame.
-/// Typically called once per loop iteration.
+/// Typically called once per loop iteration. Returns false if no frame was drawn.
+// -----------------------------------------------------------------------------
+bool JellyEngine::Render() {
+    JELLY_PROFILE_ZONE("Engine::Render");
+
+    if (renderThread.joinable()) {
+        // Drain the ring here so it keeps a single consumer; the render thread only sees packets.
+        RenderPacket* packet = renderPackets->BeginWrite();
+        if (!packet) {
+            return false;
+        }
+
+        packet->frameIndex = framesQueued++;
+        packet->commands.clear();
+        renderCommands.ConsumeAll([&](const RenderCommand& command) {
+            packet->commands.push_back(command);
+        });
+        renderPackets->EndWrite();
+
+        // The packet is drawn later, so report what the render thread saw last.
+        return !targetMinimized.load(std::memory_order_relaxed);
+    }
+
+    ExecuteRenderCommands();
+
+    const bool rendered = graphics->BeginFrame();
+    if (rendered) {
+        graphics->EndFrame();
+    }
+    targetMinimized.store(!rendered, std::memory_order_relaxed);
+    return rendered;
+}
+
+// -----------------------------------------------------------------------------
+// Starts or stops the render thread.
+// -----------------------------------------------------------------------------
+void JellyEngine::SetRenderThreadEnabled(bool enabled, std::uint32_t queueDepth) {
+    if (!enabled) {
+        StopRenderThread();
+        return;
+    }
+    if (renderThread.joinable() || !graphics) {
+        return;
+    }
+
+    renderPackets = std::make_unique<RenderPacketQueue>(queueDepth);
+    renderThread = std::thread(&JellyEngine::RenderThreadMain, this);
+    JELLY_LOG(LogCategory::Engine, LogLevel::Info, "Render thread started (queue depth {})", renderPackets->GetDepth());
+}
+
+// -----------------------------------------------------------------------------
+// Draws queued packets. Errors stop the thread and make IsRunning report false
+// instead of terminating the process.
+// -----------------------------------------------------------------------------
+void JellyEngine::RenderThreadMain() {
+    JELLY_PROFILE_THREAD("Render");
+
+    try {
+        while (RenderPacket* packet = renderPackets->BeginRead()) {
+            {
+                JELLY_PROFILE_ZONE("Engine::RenderPacket");
+
+                float transform[6] = {1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f};
+                for (const RenderCommand& command : packet->commands) {
+                    ExecuteRenderCommand(command, transform);
+                }
+
+                const bool rendered = graphics->BeginFrame();
+                if (rendered) {
+                    graphics->EndFrame();
+                }
+                targetMinimized.store(!rendered, std::memory_order_relaxed);
+            }
+            renderPackets->EndRead();
+        }
+    } catch (const std::exception& e) {
+        JELLY_LOG(LogCategory::Engine, LogLevel::Error, "Render thread stopped: {}", e.what());
+        renderFailed.store(true, std::memory_order_release);
+        renderPackets->Close();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Stops the render thread after the packet it is drawing; queued packets are dropped.
+// -----------------------------------------------------------------------------
+void JellyEngine::StopRenderThread() {
+    if (!renderThread.joinable()) {
+        return;
+    }
+
+    renderPackets->Close();
+    renderThread.join();
+    renderPackets.reset();
+}
+
+// -----------------------------------------------------------------------------
+// Runs one loop iteration: polls events, then advances the clock, renders and
+// paces the frame unless the window closed.
+// -----------------------------------------------------------------------------
+bool JellyEngine::Tick(bool* rendered) {
+    JELLY_PROFILE_FRAME();
+    JELLY_PROFILE_ZONE("Engine::Tick");
+
+    if (rendered) {
+        *rendered = false;
+    }
+
+    PollEvents();
+    if (!IsRunning()) {
+        return false;
+    }
+
+    frameLoop.BeginFrame();
+    const bool drawn = Render();
+    if (rendered) {
+        *rendered = drawn;
+    }
+
+    JELLY_PROFILE_ZONE("Engine::FramePacing");
+    framePacer.WaitForNextFrame();
+
+    // Nothing is drawn while minimized; idle instead of spinning until the window returns.
+    if (targetMinimized.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_for(MinimizedIdleInterval);
+    }
+    return true;
+}
+
 // -----------------------------------------------------------------------------
-void JellyEngine::Render() {
-    graphics->BeginFrame();
-    graphics->EndFrame();
+// Configures the simulation step and the frame limiter.
+// -----------------------------------------------------------------------------
+void JellyEngine::SetFrameTiming(double fixedStepSeconds, double targetFps) {
+    frameLoop.SetFixedStep(fixedStepSeconds);
+    framePacer.SetTargetFps(targetFps);
+}
+
+// -----------------------------------------------------------------------------
+// Forwards the present mode to the graphics API.
+// -----------------------------------------------------------------------------
+void JellyEngine::SetPresentMode(PresentMode mode, bool lowLatency) {
+    if (graphics) {
+        graphics->SetPresentMode(mode, lowLatency);
+    }
 }
 
 // -----------------------------------------------------------------------------
-// Shuts down the engine and releases window resources.
+// Returns the graphics API's present statistics, or zeros before Initialize.
+// -----------------------------------------------------------------------------
+PresentStats JellyEngine::GetPresentStats() const {
+    return graphics ? graphics->GetPresentStats() : PresentStats{};
+}
+
+// -----------------------------------------------------------------------------
+// Drains the render command ring. The transform starts as identity every frame and
+// sprites are drawn as the screen-space bounds of their transformed corners.
+// -----------------------------------------------------------------------------
+void JellyEngine::ExecuteRenderCommands() {
+    JELLY_PROFILE_ZONE("Engine::ExecuteRenderCommands");
+
+    float transform[6] = {1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f};
+
+    renderCommands.ConsumeAll([&](const RenderCommand& command) {
+        ExecuteRenderCommand(command, transform);
+    });
+}
+
+// -----------------------------------------------------------------------------
+// Translates a single render command into graphics API calls.
+// -----------------------------------------------------------------------------
+void JellyEngine::ExecuteRenderCommand(const RenderCommand& command, float transform[6]) {
+    switch (command.type) {
+        case RenderCommandType::ClearColor:
+            graphics->SetClearColor(command.clearColor.color);
+            break;
+
+        case RenderCommandType::SetTransform:
+            std::copy(command.setTransform.m, command.setTransform.m + 6, transform);
+            break;
+
+        case RenderCommandType::DrawSprite: {
+            const DrawSpriteCommand& sprite = command.drawSprite;
+            const float xs[2] = {sprite.x, sprite.x + sprite.width};
+            const float ys[2] = {sprite.y, sprite.y + sprite.height};
+
+            float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+            for (int corner = 0; corner < 4; ++corner) {
+                const float x = xs[corner & 1];
+                const float y = ys[corner >> 1];
+                const float tx = transform[0] * x + transform[2] * y + transform[4];
+                const float ty = transform[1] * x + transform[3] * y + transform[5];
+                minX = corner == 0 ? tx : std::min(minX, tx);
+                minY = corner == 0 ? ty : std::min(minY, ty);
+                maxX = corner == 0 ? tx : std::max(maxX, tx);
+                maxY = corner == 0 ? ty : std::max(maxY, ty);
+            }
+
+            graphics->DrawRect(minX, minY, maxX - minX, maxY - minY, sprite.color);
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Shuts down the engine: joins the render thread, releases window resources and
+// joins the job workers.
+// Pending log messages are flushed before returning.
 // -----------------------------------------------------------------------------
 void JellyEngine::Shutdown() {
+    StopRenderThread();
+
     if (graphics) {
         graphics->Shutdown();
     }
     if (window) {
         window->DestroyWindow();
     }
+    if (jobs) {
+        jobs->Shutdown();
+        jobs.reset();
+    }
+
+    StopAsyncLogging();
+}
+
+// -----------------------------------------------------------------------------
+// Releases this engine's async logging reference; the last one flushes and stops
+// the writer thread.
+// -----------------------------------------------------------------------------
+void JellyEngine::StopAsyncLogging() {
+    if (asyncLogging) {
+        asyncLogging = false;
+        Logger::StopAsync();
+    }
 }
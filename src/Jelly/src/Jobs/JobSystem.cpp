@@ -0,0 +1,354 @@
+#include "Jobs/JobSystem.h"
+
+#include "Profiling/Profiler.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+    /// Failed search rounds a worker spins through before it goes to sleep.
+    constexpr int IdleSpins = 64;
+
+    /// Source of JobSystem ids, so a new job system at a recycled address is not mistaken for an old one.
+    std::atomic<std::uint64_t> nextSystemId{1};
+
+    /// Queue of the calling thread, cached for the job system it was registered with.
+    struct ThreadQueueCache {
+        std::uint64_t systemId = 0;
+        void*         queue    = nullptr;
+        std::uint32_t victim   = 0;   ///< Rotating start point for steal attempts.
+    };
+
+    thread_local ThreadQueueCache threadQueue;
+
+    /// Queue the calling thread owns in one job system.
+    struct QueueRegistration {
+        std::uint64_t                    systemId;
+        void*                            queue;
+        std::weak_ptr<std::atomic<bool>> owned;  ///< The queue's ownership flag; expires with the job system.
+    };
+
+    /// Every queue the calling thread owns. Hands them back when the thread exits, so
+    /// short-lived threads do not use up the job system's queue slots.
+    struct ThreadQueueRegistry {
+        std::vector<QueueRegistration> entries;
+
+        ~ThreadQueueRegistry() {
+            for (const QueueRegistration& entry : entries) {
+                if (std::shared_ptr<std::atomic<bool>> owned = entry.owned.lock()) {
+                    owned->store(false, std::memory_order_release);
+                }
+            }
+        }
+    };
+
+    thread_local ThreadQueueRegistry threadQueues;
+}
+
+// -----------------------------------------------------------------------------
+// Registers the owner's queue and starts the workers.
+// -----------------------------------------------------------------------------
+JobSystem::JobSystem(std::uint32_t workerCount)
+    : id(nextSystemId.fetch_add(1, std::memory_order_relaxed)) {
+    workerCount = std::min<std::uint32_t>(workerCount, MaxQueues / 2);
+
+    LocalQueue();
+
+    workers.reserve(workerCount);
+    for (std::uint32_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&JobSystem::WorkerMain, this);
+    }
+}
+
+JobSystem::~JobSystem() {
+    Shutdown();
+}
+
+// -----------------------------------------------------------------------------
+// Lets the workers drain their queues, then joins them.
+// -----------------------------------------------------------------------------
+void JobSystem::Shutdown() {
+    if (stopping.exchange(true)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        workEpoch.fetch_add(1, std::memory_order_seq_cst);
+    }
+    sleepCondition.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    // Anything left (e.g. scheduled by the owner after the last wait) runs here.
+    Queue* local = LocalQueue();
+    while (local && (RunOne(local) || local->parkedCount > 0)) {
+    }
+
+    if (threadQueue.systemId == id) {
+        threadQueue = {};
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Queues a job on the calling thread's deque, or runs it inline if the deque is full.
+// -----------------------------------------------------------------------------
+void JobSystem::Schedule(JobFunction function, void* context, std::uint32_t begin, std::uint32_t end,
+                         JobCounter* counter, const JobCounter* dependency) {
+    if (counter) {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Queue* local = LocalQueue();
+    if (!local) {
+        Job job{function, context, begin, end, counter, dependency};
+        if (dependency) {
+            Wait(*dependency);
+        }
+        Execute(&job);
+        return;
+    }
+
+    Job* job = &local->jobs[local->nextJob++ & (JobsPerQueue - 1)];
+    *job = {function, context, begin, end, counter, dependency};
+
+    if (!local->deque.Push(job)) {
+        // Waiting runs other jobs that may reuse this ring slot, so keep a copy.
+        Job overflow = *job;
+        if (dependency) {
+            Wait(*dependency);
+        }
+        Execute(&overflow);
+        return;
+    }
+
+    WakeWorkers();
+}
+
+// -----------------------------------------------------------------------------
+// Helps with queued work until the counter reaches zero.
+// -----------------------------------------------------------------------------
+void JobSystem::Wait(const JobCounter& counter) {
+    Queue* local = LocalQueue();
+    while (!counter.IsComplete()) {
+        if (!RunOne(local)) {
+            std::this_thread::yield();
+        }
+    }
+
+    // The caller stops looking for work here, so jobs it parked must be stealable again.
+    Unpark(local);
+}
+
+// -----------------------------------------------------------------------------
+// Returns the calling thread's queue, registering one on first use. A thread keeps
+// its queue until it exits, even while it uses other job systems in between.
+// Returns nullptr once every queue slot is owned by a live thread.
+// -----------------------------------------------------------------------------
+JobSystem::Queue* JobSystem::LocalQueue() {
+    if (threadQueue.systemId == id) {
+        return static_cast<Queue*>(threadQueue.queue);
+    }
+
+    std::vector<QueueRegistration>& owned = threadQueues.entries;
+    for (const QueueRegistration& entry : owned) {
+        if (entry.systemId == id) {
+            threadQueue = {id, entry.queue, 0};
+            return static_cast<Queue*>(entry.queue);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(registerMutex);
+
+    // Take over the queue of a thread that exited before adding a new one. Jobs it left
+    // behind simply become the new owner's.
+    const std::uint32_t count = queueCount.load(std::memory_order_relaxed);
+    std::uint32_t index = 0;
+    while (index < count && queues[index]->owned.exchange(true, std::memory_order_acquire)) {
+        ++index;
+    }
+
+    if (index == count) {
+        if (count >= MaxQueues) {
+            return nullptr;
+        }
+        queues[index] = std::make_shared<Queue>(JobsPerQueue);
+        queueCount.store(count + 1, std::memory_order_release);
+    }
+
+    // Drop registrations of job systems that no longer exist.
+    owned.erase(std::remove_if(owned.begin(), owned.end(),
+                               [](const QueueRegistration& entry) { return entry.owned.expired(); }),
+                owned.end());
+
+    Queue* queue = queues[index].get();
+    owned.push_back({id, queue, std::shared_ptr<std::atomic<bool>>(queues[index], &queue->owned)});
+    threadQueue = {id, queue, index};
+    return queue;
+}
+
+// -----------------------------------------------------------------------------
+// Moves parked jobs back into the deque, keeping the ones that do not fit.
+// -----------------------------------------------------------------------------
+void JobSystem::Unpark(Queue* local) {
+    if (!local) {
+        return;
+    }
+
+    std::uint32_t kept = 0;
+    for (std::uint32_t i = 0; i < local->parkedCount; ++i) {
+        Job* job = &local->jobs[local->nextJob++ & (JobsPerQueue - 1)];
+        *job = local->parked[i];
+        if (!local->deque.Push(job)) {
+            local->parked[kept++] = *job;
+        }
+    }
+
+    if (local->parkedCount > kept) {
+        local->parkedCount = kept;
+        WakeWorkers();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Pops local work first, then tries to steal from the other queues.
+// -----------------------------------------------------------------------------
+JobSystem::Job* JobSystem::FindJob(Queue* local) {
+    if (local) {
+        if (Job* job = local->deque.Pop()) {
+            return job;
+        }
+    }
+
+    const std::uint32_t count = queueCount.load(std::memory_order_acquire);
+    const std::uint32_t start = threadQueue.victim++;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        Queue* victim = queues[(start + i) % count].get();
+        if (victim == local) {
+            continue;
+        }
+        if (Job* job = victim->deque.Steal()) {
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+// Runs one job if any is available and returns true if it made progress.
+// A job whose dependency is not complete is parked on the calling thread, so the
+// search moves on to the jobs it depends on instead of popping it again.
+// -----------------------------------------------------------------------------
+bool JobSystem::RunOne(Queue* local) {
+    if (local) {
+        for (std::uint32_t i = 0; i < local->parkedCount; ++i) {
+            if (local->parked[i].dependency->IsComplete()) {
+                Job ready = local->parked[i];
+                local->parked[i] = local->parked[--local->parkedCount];
+                Execute(&ready);
+                return true;
+            }
+        }
+    }
+
+    Job* job = FindJob(local);
+    if (!job) {
+        return false;
+    }
+
+    if (job->dependency && !job->dependency->IsComplete()) {
+        if (local && local->parkedCount < MaxParked) {
+            local->parked[local->parkedCount++] = *job;
+            return true;
+        }
+
+        // The slot can be reused by jobs run while waiting, so run a copy.
+        Job blocked = *job;
+        Wait(*blocked.dependency);
+        Execute(&blocked);
+        return true;
+    }
+
+    Execute(job);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Calls the job and signals its counter. A stolen job is copied out first: its slot
+// belongs to another thread's ring and may be reused as soon as it starts.
+// -----------------------------------------------------------------------------
+void JobSystem::Execute(Job* job) {
+    const Job run = *job;
+    {
+        JELLY_PROFILE_ZONE("Job");
+        run.function(run.context, run.begin, run.end);
+    }
+
+    // Finishing a group can unblock jobs that sleeping workers deferred on it.
+    if (run.counter && run.counter->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        WakeWorkers();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Worker loop: run jobs while there are any, spin briefly, then sleep until woken.
+// -----------------------------------------------------------------------------
+void JobSystem::WorkerMain() {
+    JELLY_PROFILE_THREAD("Job Worker");
+
+    Queue* local = LocalQueue();
+    int idle = 0;
+
+    for (;;) {
+        if (RunOne(local)) {
+            idle = 0;
+            continue;
+        }
+
+        if (stopping.load(std::memory_order_acquire)) {
+            // Help drain whatever is still queued before exiting.
+            while (local && (RunOne(local) || local->parkedCount > 0)) {
+            }
+            return;
+        }
+
+        // Parked jobs are invisible to other threads, so keep polling until they can run.
+        if (++idle < IdleSpins || (local && local->parkedCount > 0)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Capture the epoch before the last look for work: anything scheduled after this
+        // point changes the epoch, so the wait below cannot miss it.
+        const std::uint64_t epoch = workEpoch.load(std::memory_order_seq_cst);
+        if (RunOne(local)) {
+            idle = 0;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+        sleepCondition.wait(lock, [&] {
+            return workEpoch.load(std::memory_order_seq_cst) != epoch || stopping.load(std::memory_order_acquire);
+        });
+        sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+        idle = 0;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Wakes a sleeping worker, if any, after new work was queued.
+// -----------------------------------------------------------------------------
+void JobSystem::WakeWorkers() {
+    workEpoch.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepingWorkers.load(std::memory_order_seq_cst) == 0) {
+        return;
+    }
+
+    // Taking the mutex orders the notify after a worker that is about to wait.
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    sleepCondition.notify_one();
+}
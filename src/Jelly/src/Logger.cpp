@@ -1,83 +1,514 @@
 #include "Logger.h"
 
-#include <iostream>
-#include <iomanip>
+#include "Core/MpmcRingBuffer.h"
+#include "Logging/BinaryLogWriter.h"
+#include "Logging/LogFormatter.h"
+#include "Profiling/Profiler.h"
+
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 
 #if defined(_WIN32) || defined(_WIN64)
 #include <windows.h>
 #endif
 
-// -----------------------------------------------------------------------------
-// Returns the current system time in HH:MM:SS format.
-// -----------------------------------------------------------------------------
-static std::string CurrentTimeHHMMSS() {
-    using namespace std::chrono;
-    auto t  = system_clock::to_time_t(system_clock::now());
-    std::tm tm;
-#if defined(_WIN32)
-    localtime_s(&tm, &t);
+namespace {
+    /// Number of records the writer thread formats before issuing a single write.
+    constexpr std::size_t WriteBatchSize = 256;
+
+    /// How long the writer thread sleeps when nobody wakes it up.
+    constexpr auto WriterIdleTimeout = std::chrono::milliseconds(2);
+
+    /// Unformatted record: the format string's address plus the encoded arguments.
+    struct LogRecord {
+        std::int64_t  timestamp = 0;        ///< Unix time in nanoseconds.
+        const char*   format    = nullptr;
+        LogCategory   category  = LogCategory::Engine;
+        LogLevel      level     = LogLevel::Info;
+        std::uint16_t size      = 0;
+        bool          truncated = false;
+        std::uint8_t  payload[MaxLogPayload];
+    };
+
+    // -----------------------------------------------------------------------------
+    // Returns the current Unix time in nanoseconds.
+    // -----------------------------------------------------------------------------
+    std::int64_t NowUnixNanoseconds() {
+        using namespace std::chrono;
+        return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+    }
+
+    // -----------------------------------------------------------------------------
+    // Fills a record from an encoded payload.
+    // -----------------------------------------------------------------------------
+    void FillRecord(LogRecord& record, std::int64_t timestamp, LogCategory category, LogLevel level,
+                    const char* format, const LogPayload& payload) {
+        record.timestamp = timestamp;
+        record.format    = format;
+        record.category  = category;
+        record.level     = level;
+        record.size      = payload.size;
+        record.truncated = payload.truncated;
+        std::memcpy(record.payload, payload.data, payload.size);
+    }
+
+    /// Console and binary file outputs. Shared by the synchronous path and the writer thread,
+    /// so every access goes through the mutex.
+    struct LogSinks {
+        std::mutex        mutex;
+        LogTimestampCache timestamps;
+        BinaryLogWriter   binary;
+        std::string       message;  ///< Scratch buffer reused for every formatted message.
+
+        void Write(std::string& batch, const LogRecord& record);
+        void Flush(std::string& batch);
+    };
+
+    // -----------------------------------------------------------------------------
+    // Formats one record as a colored, timestamped line and mirrors it to the binary log.
+    // On POSIX the line is appended to the batch and only reaches the console in Flush;
+    // on Windows the console color has to be switched per line, so the line is written
+    // immediately without flushing.
+    // -----------------------------------------------------------------------------
+    void LogSinks::Write(std::string& batch, const LogRecord& record) {
+        binary.Write(record.timestamp, record.category, record.level, record.format,
+                     record.payload, record.size, record.truncated);
+
+        const char* timeStr = timestamps.Format(record.timestamp);
+        message.clear();
+        FormatLogMessage(message, record.format, record.payload, record.size, record.truncated);
+
+#if defined(_WIN32) || defined(_WIN64)
+        (void)batch;
+
+        HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+        WORD color;
+
+        switch (record.level) {
+            case LogLevel::Info:        color = FOREGROUND_GREEN | FOREGROUND_INTENSITY; break;
+            case LogLevel::Highlight:   color = FOREGROUND_BLUE | FOREGROUND_RED | FOREGROUND_INTENSITY; break;
+            case LogLevel::Warning:     color = FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY; break;
+            case LogLevel::Error:       color = FOREGROUND_RED | FOREGROUND_INTENSITY; break;
+            default:                    color = FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE; break;
+        }
+
+        SetConsoleTextAttribute(hConsole, color);
+
+        std::cout << "[" << timeStr << "] " << LogLevelTag(record.level) << LogCategoryTag(record.category)
+                  << message << '\n';
+
+        // Reset color
+        SetConsoleTextAttribute(hConsole, FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
 #else
-    localtime_r(&t, &tm);
+        const char* colorCode;
+        switch (record.level) {
+            case LogLevel::Info:        colorCode = "\033[32m"; break; // Green
+            case LogLevel::Highlight:   colorCode = "\033[38;2;122;44;189m"; break;
+            case LogLevel::Warning:     colorCode = "\033[33m"; break; // Yellow
+            case LogLevel::Error:       colorCode = "\033[31m"; break; // Red
+            default:                    colorCode = "\033[0m"; break;
+        }
+
+        batch.append(colorCode);
+        batch.append("[").append(timeStr).append("] ");
+        batch.append(LogLevelTag(record.level));
+        batch.append(LogCategoryTag(record.category));
+        batch.append(message);
+        batch.append("\033[0m\n");
 #endif
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%H:%M:%S");
-    return oss.str();
+    }
+
+    // -----------------------------------------------------------------------------
+    // Pushes everything written by Write to the console with a single flush.
+    // -----------------------------------------------------------------------------
+    void LogSinks::Flush(std::string& batch) {
+        if (!batch.empty()) {
+            std::cout.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            batch.clear();
+        }
+        std::cout.flush();
+        binary.Flush();
+    }
+
+    // -----------------------------------------------------------------------------
+    // Process-wide sinks.
+    // -----------------------------------------------------------------------------
+    LogSinks& Sinks() {
+        static LogSinks sinks;
+        return sinks;
+    }
+
+    /// Ring buffer and background thread backing the asynchronous logging mode.
+    class AsyncLogBackend {
+    public:
+        // The sinks must outlive the backend, whose destructor drains into them.
+        AsyncLogBackend() { Sinks(); }
+        ~AsyncLogBackend();
+
+        [[nodiscard]] bool IsActive() const { return active.load(std::memory_order_acquire); }
+
+        void Start(std::size_t capacity, LogOverflowPolicy overflowPolicy);
+        bool TryPush(std::int64_t timestamp, LogCategory category, LogLevel level, const char* format, const LogPayload& payload);
+        void Flush();
+        void Stop();
+
+    private:
+        void StopWriter();
+        void Run();
+        void Drain(std::string& batch);
+        void RequestWake();
+
+        std::unique_ptr<MpmcRingBuffer<LogRecord>> queue;
+        LogOverflowPolicy policy = LogOverflowPolicy::Drop;
+
+        std::atomic<bool>          active{false};
+        std::atomic<bool>          stopRequested{false};
+        std::atomic<std::uint32_t> producers{0};  ///< TryPush calls that may still touch the ring.
+        std::atomic<std::uint64_t> pushed{0};   ///< Records successfully queued.
+        std::atomic<std::uint64_t> written{0};  ///< Records written by the background thread.
+        std::atomic<std::uint64_t> dropped{0};  ///< Records discarded since the last report.
+
+        std::uint32_t           starts = 0;     ///< Start calls not yet matched by Stop.
+        std::mutex              lifecycleMutex; ///< Serializes Start/Stop and guards starts.
+        std::mutex              mutex;          ///< Guards wakeRequested and the condition variables.
+        std::condition_variable wake;
+        std::condition_variable drained;
+        bool                    wakeRequested = false;
+        std::thread             worker;
+    };
+
+    // -----------------------------------------------------------------------------
+    // Stops the writer thread at exit, whatever Start calls are still outstanding.
+    // -----------------------------------------------------------------------------
+    AsyncLogBackend::~AsyncLogBackend() {
+        std::lock_guard<std::mutex> lifecycle(lifecycleMutex);
+        starts = 0;
+        StopWriter();
+    }
+
+    // -----------------------------------------------------------------------------
+    // Allocates the ring buffer and starts the writer thread on the first call;
+    // later calls only count, so the first caller's capacity and policy stay in use.
+    // The ring is only replaced while the backend is stopped: pushes touch it only
+    // after seeing the backend active, and Stop waits for the ones that did.
+    // -----------------------------------------------------------------------------
+    void AsyncLogBackend::Start(std::size_t capacity, LogOverflowPolicy overflowPolicy) {
+        std::lock_guard<std::mutex> lifecycle(lifecycleMutex);
+        if (starts++ > 0) {
+            return;
+        }
+
+        if (!queue || queue->Capacity() < capacity) {
+            // A push that raced the previous Stop is still between its count and its
+            // active check; let it see the backend as stopped before freeing the old ring.
+            while (producers.load(std::memory_order_acquire) != 0) {
+                std::this_thread::yield();
+            }
+            queue = std::make_unique<MpmcRingBuffer<LogRecord>>(capacity);
+        }
+
+        policy = overflowPolicy;
+        stopRequested.store(false, std::memory_order_relaxed);
+        worker = std::thread(&AsyncLogBackend::Run, this);
+        active.store(true, std::memory_order_release);
+    }
+
+    // -----------------------------------------------------------------------------
+    // Copies the record into the ring buffer. This is the only work done on the
+    // calling thread; formatting and console output happen on the writer thread.
+    // Returns false if the backend is stopped (or stops while a blocking push waits
+    // for room), in which case the caller writes the record synchronously.
+    // -----------------------------------------------------------------------------
+    bool AsyncLogBackend::TryPush(std::int64_t timestamp, LogCategory category, LogLevel level,
+                                  const char* format, const LogPayload& payload) {
+        // Stop waits for this count to reach zero before its final drain, so a record
+        // queued after the active check is never left behind in the ring.
+        producers.fetch_add(1);
+        if (!active.load()) {
+            producers.fetch_sub(1, std::memory_order_release);
+            return false;
+        }
+
+        auto fill = [&](LogRecord& record) {
+            FillRecord(record, timestamp, category, level, format, payload);
+        };
+
+        if (!queue->TryPush(fill)) {
+            if (policy == LogOverflowPolicy::Drop) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                producers.fetch_sub(1, std::memory_order_release);
+                return true;
+            }
+
+            do {
+                if (!active.load(std::memory_order_acquire)) {
+                    producers.fetch_sub(1, std::memory_order_release);
+                    return false;
+                }
+                RequestWake();
+                std::this_thread::yield();
+            } while (!queue->TryPush(fill));
+        }
+
+        pushed.fetch_add(1, std::memory_order_release);
+        producers.fetch_sub(1, std::memory_order_release);
+
+        // Errors are usually followed by a crash or an exit, so get them out promptly.
+        if (level == LogLevel::Error) {
+            RequestWake();
+        }
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Wakes the writer and waits until every record queued so far has been written.
+    // -----------------------------------------------------------------------------
+    void AsyncLogBackend::Flush() {
+        if (!IsActive()) {
+            return;
+        }
+
+        const std::uint64_t target = pushed.load(std::memory_order_acquire);
+        RequestWake();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        drained.wait(lock, [&] {
+            return written.load(std::memory_order_acquire) >= target || !IsActive();
+        });
+    }
+
+    // -----------------------------------------------------------------------------
+    // Matches one Start call; the writer stops when the last one is matched.
+    // -----------------------------------------------------------------------------
+    void AsyncLogBackend::Stop() {
+        std::lock_guard<std::mutex> lifecycle(lifecycleMutex);
+        if (starts == 0 || --starts > 0) {
+            return;
+        }
+
+        StopWriter();
+    }
+
+    // -----------------------------------------------------------------------------
+    // Stops the writer thread after it has drained the ring buffer.
+    // The caller holds lifecycleMutex.
+    // -----------------------------------------------------------------------------
+    void AsyncLogBackend::StopWriter() {
+        if (!IsActive()) {
+            return;
+        }
+
+        active.store(false);
+        stopRequested.store(true, std::memory_order_release);
+        RequestWake();
+        worker.join();
+
+        // Pushes that saw the logger as active right before it stopped either finish or,
+        // when blocked on a full ring, give up and write synchronously.
+        while (producers.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+
+        // Catch the records those pushes queued after the writer's last drain.
+        std::string batch;
+        Drain(batch);
+
+        drained.notify_all();
+    }
+
+    // -----------------------------------------------------------------------------
+    // Writer thread: drains the ring in batches, then sleeps until woken or timed out.
+    // -----------------------------------------------------------------------------
+    void AsyncLogBackend::Run() {
+        JELLY_PROFILE_THREAD("Log Writer");
+
+        std::string batch;
+        batch.reserve(WriteBatchSize * 128);
+
+        for (;;) {
+            const bool stopping = stopRequested.load(std::memory_order_acquire);
+            Drain(batch);
+            if (stopping) {
+                break;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait_for(lock, WriterIdleTimeout, [&] {
+                return wakeRequested || stopRequested.load(std::memory_order_relaxed);
+            });
+            wakeRequested = false;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // Pops and writes everything currently in the ring, one flush per batch.
+    // -----------------------------------------------------------------------------
+    void AsyncLogBackend::Drain(std::string& batch) {
+        LogSinks& sinks = Sinks();
+        std::lock_guard<std::mutex> sinkLock(sinks.mutex);
+
+        std::size_t inBatch = 0;
+        std::uint64_t total = 0;
+
+        auto consume = [&](const LogRecord& record) {
+            sinks.Write(batch, record);
+        };
+
+        while (queue->TryPop(consume)) {
+            ++total;
+            if (++inBatch == WriteBatchSize) {
+                sinks.Flush(batch);
+                inBatch = 0;
+            }
+        }
+
+        if (const std::uint64_t lost = dropped.exchange(0, std::memory_order_relaxed)) {
+            LogPayload payload;
+            EncodeLogArg(payload, lost);
+
+            LogRecord notice;
+            FillRecord(notice, NowUnixNanoseconds(), LogCategory::Engine, LogLevel::Warning,
+                       "{} log message(s) dropped: ring buffer full", payload);
+            sinks.Write(batch, notice);
+            ++inBatch;
+        }
+
+        if (inBatch > 0) {
+            sinks.Flush(batch);
+        }
+
+        if (total > 0) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                written.fetch_add(total, std::memory_order_release);
+            }
+            drained.notify_all();
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // Asks the writer thread to drain the ring without waiting for its timeout.
+    // -----------------------------------------------------------------------------
+    void AsyncLogBackend::RequestWake() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            wakeRequested = true;
+        }
+        wake.notify_one();
+    }
+
+    // -----------------------------------------------------------------------------
+    // Process-wide backend; its destructor stops the writer thread at exit.
+    // -----------------------------------------------------------------------------
+    AsyncLogBackend& Backend() {
+        static AsyncLogBackend backend;
+        return backend;
+    }
 }
 
+// Every level at or above the compile-time minimum starts enabled in every category.
+std::atomic<std::uint32_t> Logger::levelMasks[static_cast<std::size_t>(LogCategory::Count)] = {
+    {~0u << JELLY_LOG_MIN_LEVEL}, {~0u << JELLY_LOG_MIN_LEVEL},
+    {~0u << JELLY_LOG_MIN_LEVEL}, {~0u << JELLY_LOG_MIN_LEVEL},
+};
+
 // -----------------------------------------------------------------------------
-// Logs a message with platform-specific colored output and timestamp.
+// Replaces the level mask of a category.
 // -----------------------------------------------------------------------------
-void Logger::Log(LogLevel level, const std::string& message) {
-    const std::string timeStr = CurrentTimeHHMMSS();
+void Logger::SetLevelMask(LogCategory category, std::uint32_t mask) {
+    if (category < LogCategory::Count) {
+        levelMasks[static_cast<std::size_t>(category)].store(mask, std::memory_order_relaxed);
+    }
+}
 
-#if defined(_WIN32) || defined(_WIN64)
-    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-    WORD color;
+// -----------------------------------------------------------------------------
+// Returns the level mask of a category.
+// -----------------------------------------------------------------------------
+std::uint32_t Logger::GetLevelMask(LogCategory category) {
+    if (category < LogCategory::Count) {
+        return levelMasks[static_cast<std::size_t>(category)].load(std::memory_order_relaxed);
+    }
+    return 0;
+}
 
-    switch (level) {
-        case LogLevel::Info:        color = FOREGROUND_GREEN | FOREGROUND_INTENSITY; break;
-        case LogLevel::Highlight:   color = FOREGROUND_BLUE | FOREGROUND_RED | FOREGROUND_INTENSITY; break;
-        case LogLevel::Warning:     color = FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY; break;
-        case LogLevel::Error:       color = FOREGROUND_RED | FOREGROUND_INTENSITY; break;
-        default:                    color = FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE; break;
+// -----------------------------------------------------------------------------
+// Logs a plain message. The text is stored as the single argument of a "{}" format.
+// -----------------------------------------------------------------------------
+void Logger::Log(LogCategory category, LogLevel level, std::string_view message) {
+    if (!IsEnabled(category, level)) {
+        return;
     }
 
-    SetConsoleTextAttribute(hConsole, color);
+    LogPayload payload;
+    payload.WriteString(message);
+    LogEncoded(category, level, "{}", payload);
+}
 
-    std::cout << "[" << timeStr << "] ";
+// -----------------------------------------------------------------------------
+// Queues an encoded record, or formats and writes it right away in synchronous mode.
+// -----------------------------------------------------------------------------
+void Logger::LogEncoded(LogCategory category, LogLevel level, const char* format, const LogPayload& payload) {
+    const std::int64_t now = NowUnixNanoseconds();
 
-    switch (level) {
-        case LogLevel::Info:        std::cout << "[INFO] "; break;
-        case LogLevel::Highlight:   std::cout << "[INFO] "; break;
-        case LogLevel::Warning:     std::cout << "[WARN] "; break;
-        case LogLevel::Error:       std::cout << "[ERROR] "; break;
-        default:                    std::cout << "[LOG] "; break;
+    if (Backend().TryPush(now, category, level, format, payload)) {
+        return;
     }
 
-    std::cout << message << std::endl;
+    LogRecord record;
+    FillRecord(record, now, category, level, format, payload);
 
-    // Reset color
-    SetConsoleTextAttribute(hConsole, FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
-#else
-    const char* colorCode;
-    switch (level) {
-        case LogLevel::Info:        colorCode = "\033[32m"; break; // Green
-        case LogLevel::Highlight:   colorCode = "\033[38;2;122;44;189m"; break;
-        case LogLevel::Warning:     colorCode = "\033[33m"; break; // Yellow
-        case LogLevel::Error:       colorCode = "\033[31m"; break; // Red
-        default:                    colorCode = "\033[0m"; break;
-    }
+    LogSinks& sinks = Sinks();
+    std::lock_guard<std::mutex> lock(sinks.mutex);
+    std::string line;
+    sinks.Write(line, record);
+    sinks.Flush(line);
+}
 
-    const char* levelStr;
-    switch (level) {
-        case LogLevel::Info:        levelStr = "[INFO] "; break;
-        case LogLevel::Highlight:   levelStr = "[INFO] "; break;
-        case LogLevel::Warning:     levelStr = "[WARN] "; break;
-        case LogLevel::Error:       levelStr = "[ERROR] "; break;
-        default:                    levelStr = "[LOG] "; break;
-    }
+// -----------------------------------------------------------------------------
+// Opens the binary log file sink.
+// -----------------------------------------------------------------------------
+bool Logger::OpenBinaryLog(const std::string& path) {
+    LogSinks& sinks = Sinks();
+    std::lock_guard<std::mutex> lock(sinks.mutex);
+    return sinks.binary.Open(path);
+}
 
-    std::cout << colorCode << "[" << timeStr << "] " << levelStr << message << "\033[0m" << std::endl;
-#endif
+// -----------------------------------------------------------------------------
+// Closes the binary log file sink.
+// -----------------------------------------------------------------------------
+void Logger::CloseBinaryLog() {
+    Flush();
+
+    LogSinks& sinks = Sinks();
+    std::lock_guard<std::mutex> lock(sinks.mutex);
+    sinks.binary.Close();
+}
+
+// -----------------------------------------------------------------------------
+// Switches to asynchronous logging.
+// -----------------------------------------------------------------------------
+void Logger::StartAsync(std::size_t capacity, LogOverflowPolicy policy) {
+    Backend().Start(capacity, policy);
+}
+
+// -----------------------------------------------------------------------------
+// Blocks until all queued messages have been written.
+// -----------------------------------------------------------------------------
+void Logger::Flush() {
+    Backend().Flush();
+}
+
+// -----------------------------------------------------------------------------
+// Flushes and stops asynchronous logging.
+// -----------------------------------------------------------------------------
+void Logger::StopAsync() {
+    Backend().Stop();
 }
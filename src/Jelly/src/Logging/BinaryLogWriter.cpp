@@ -0,0 +1,90 @@
+#include "Logging/BinaryLogWriter.h"
+
+#include <cstring>
+
+BinaryLogWriter::~BinaryLogWriter() {
+    Close();
+}
+
+// -----------------------------------------------------------------------------
+// Opens the file and writes the magic and version header.
+// -----------------------------------------------------------------------------
+bool BinaryLogWriter::Open(const std::string& path) {
+    Close();
+
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    std::fwrite(BinaryLogMagic, 1, sizeof(BinaryLogMagic), file);
+    std::fwrite(&BinaryLogVersion, sizeof(BinaryLogVersion), 1, file);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Closes the file and forgets the format ids written to it.
+// -----------------------------------------------------------------------------
+void BinaryLogWriter::Close() {
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    formatIds.clear();
+}
+
+// -----------------------------------------------------------------------------
+// Appends a record entry, preceded by a format entry the first time a format is seen.
+// -----------------------------------------------------------------------------
+void BinaryLogWriter::Write(std::int64_t timestamp, LogCategory category, LogLevel level, const char* format,
+                            const std::uint8_t* payload, std::uint16_t size, bool truncated) {
+    if (!file) {
+        return;
+    }
+
+    const std::uint32_t formatId = FormatId(format);
+    const auto tag = static_cast<std::uint8_t>(BinaryLogEntry::Record);
+    const auto categoryByte = static_cast<std::uint8_t>(category);
+    const auto levelByte = static_cast<std::uint8_t>(level);
+    const std::uint8_t flags = truncated ? BinaryLogTruncated : 0;
+
+    std::fwrite(&tag, sizeof(tag), 1, file);
+    std::fwrite(&timestamp, sizeof(timestamp), 1, file);
+    std::fwrite(&formatId, sizeof(formatId), 1, file);
+    std::fwrite(&categoryByte, sizeof(categoryByte), 1, file);
+    std::fwrite(&levelByte, sizeof(levelByte), 1, file);
+    std::fwrite(&flags, sizeof(flags), 1, file);
+    std::fwrite(&size, sizeof(size), 1, file);
+    std::fwrite(payload, 1, size, file);
+}
+
+// -----------------------------------------------------------------------------
+// Flushes the C runtime buffer.
+// -----------------------------------------------------------------------------
+void BinaryLogWriter::Flush() {
+    if (file) {
+        std::fflush(file);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Returns the id of a format string, writing a format entry for new ones.
+// -----------------------------------------------------------------------------
+std::uint32_t BinaryLogWriter::FormatId(const char* format) {
+    auto it = formatIds.find(format);
+    if (it != formatIds.end()) {
+        return it->second;
+    }
+
+    const auto id = static_cast<std::uint32_t>(formatIds.size());
+    formatIds.emplace(format, id);
+
+    const auto tag = static_cast<std::uint8_t>(BinaryLogEntry::Format);
+    const auto length = static_cast<std::uint16_t>(std::strlen(format));
+
+    std::fwrite(&tag, sizeof(tag), 1, file);
+    std::fwrite(&id, sizeof(id), 1, file);
+    std::fwrite(&length, sizeof(length), 1, file);
+    std::fwrite(format, 1, length, file);
+    return id;
+}
@@ -0,0 +1,176 @@
+#include "Logging/LogFormatter.h"
+
+#include "Logging/LogArgs.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string_view>
+
+namespace {
+    /// Cursor over an encoded payload.
+    struct PayloadReader {
+        const std::uint8_t* data;
+        std::size_t         size;
+        std::size_t         offset = 0;
+
+        template <typename T>
+        bool Read(T& value) {
+            if (offset + sizeof(T) > size) {
+                return false;
+            }
+            std::memcpy(&value, data + offset, sizeof(T));
+            offset += sizeof(T);
+            return true;
+        }
+    };
+
+    // -----------------------------------------------------------------------------
+    // Decodes the next argument and appends its text. Returns false when the payload is exhausted.
+    // -----------------------------------------------------------------------------
+    bool AppendNextArg(std::string& out, PayloadReader& reader, bool hex) {
+        std::uint8_t tag = 0;
+        if (!reader.Read(tag)) {
+            return false;
+        }
+
+        char buffer[32];
+        switch (static_cast<LogArgType>(tag)) {
+            case LogArgType::Bool: {
+                std::uint8_t v = 0;
+                if (!reader.Read(v)) return false;
+                out.append(v ? "true" : "false");
+                return true;
+            }
+            case LogArgType::Char: {
+                char v = 0;
+                if (!reader.Read(v)) return false;
+                out.push_back(v);
+                return true;
+            }
+            case LogArgType::Int: {
+                std::int64_t v = 0;
+                if (!reader.Read(v)) return false;
+                std::snprintf(buffer, sizeof(buffer), hex ? "%" PRIx64 : "%" PRId64, v);
+                out.append(buffer);
+                return true;
+            }
+            case LogArgType::UInt: {
+                std::uint64_t v = 0;
+                if (!reader.Read(v)) return false;
+                std::snprintf(buffer, sizeof(buffer), hex ? "%" PRIx64 : "%" PRIu64, v);
+                out.append(buffer);
+                return true;
+            }
+            case LogArgType::Double: {
+                double v = 0.0;
+                if (!reader.Read(v)) return false;
+                std::snprintf(buffer, sizeof(buffer), "%g", v);
+                out.append(buffer);
+                return true;
+            }
+            case LogArgType::String: {
+                std::uint16_t length = 0;
+                if (!reader.Read(length) || reader.offset + length > reader.size) return false;
+                out.append(reinterpret_cast<const char*>(reader.data + reader.offset), length);
+                reader.offset += length;
+                return true;
+            }
+            case LogArgType::Pointer: {
+                std::uintptr_t v = 0;
+                if (!reader.Read(v)) return false;
+                std::snprintf(buffer, sizeof(buffer), "0x%" PRIxPTR, v);
+                out.append(buffer);
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Expands a format string with its encoded arguments.
+// -----------------------------------------------------------------------------
+void FormatLogMessage(std::string& out, const char* format, const std::uint8_t* payload, std::size_t size, bool truncated) {
+    PayloadReader reader{payload, size};
+
+    for (const char* p = format; *p != '\0'; ++p) {
+        if (p[0] == '{' && p[1] == '{') {
+            out.push_back('{');
+            ++p;
+            continue;
+        }
+        if (p[0] == '}' && p[1] == '}') {
+            out.push_back('}');
+            ++p;
+            continue;
+        }
+        if (p[0] != '{') {
+            out.push_back(*p);
+            continue;
+        }
+
+        const char* close = std::strchr(p, '}');
+        if (!close) {
+            out.append(p);
+            break;
+        }
+
+        const bool hex = std::string_view(p, static_cast<std::size_t>(close - p + 1)) == "{:x}";
+        if (!AppendNextArg(out, reader, hex)) {
+            out.append("{?}");
+        }
+        p = close;
+    }
+
+    if (truncated) {
+        out.append(" [...]");
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Returns the textual tag printed in front of each message.
+// -----------------------------------------------------------------------------
+const char* LogLevelTag(LogLevel level) {
+    switch (level) {
+        case LogLevel::Info:        return "[INFO] ";
+        case LogLevel::Highlight:   return "[INFO] ";
+        case LogLevel::Warning:     return "[WARN] ";
+        case LogLevel::Error:       return "[ERROR] ";
+        default:                    return "[LOG] ";
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Returns the textual tag naming the category of each message.
+// -----------------------------------------------------------------------------
+const char* LogCategoryTag(LogCategory category) {
+    switch (category) {
+        case LogCategory::Engine:   return "[Engine] ";
+        case LogCategory::Window:   return "[Window] ";
+        case LogCategory::Vulkan:   return "[Vulkan] ";
+        case LogCategory::Managed:  return "[Managed] ";
+        default:                    return "";
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Returns the HH:MM:SS text for the timestamp, reformatting only on a new second.
+// -----------------------------------------------------------------------------
+const char* LogTimestampCache::Format(std::int64_t unixNanoseconds) {
+    const std::int64_t second = unixNanoseconds / 1000000000;
+    if (second != cachedSecond) {
+        cachedSecond = second;
+
+        const auto t = static_cast<std::time_t>(second);
+        std::tm tm;
+#if defined(_WIN32)
+        localtime_s(&tm, &t);
+#else
+        localtime_r(&t, &tm);
+#endif
+        std::strftime(text, sizeof(text), "%H:%M:%S", &tm);
+    }
+    return text;
+}
@@ -0,0 +1,260 @@
+#include "Profiling/Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    /// Zones kept per thread; older zones are overwritten.
+    constexpr std::uint64_t ZonesPerThread = 1 << 15;
+
+    /// Frame start times kept for WriteChromeTrace.
+    constexpr std::uint64_t FrameHistory = 1024;
+
+    /// One completed zone. Fields are atomics so the exporter may read while the owner writes.
+    struct ZoneRecord {
+        std::atomic<const char*>  name{nullptr};
+        std::atomic<std::int64_t> begin{0};
+        std::atomic<std::int64_t> end{0};
+    };
+
+    /// Zone ring of one thread. Only the owning thread writes it. Rings of exited threads stay
+    /// registered, so their zones can still be exported, until a new thread takes them over.
+    struct ThreadZones {
+        bool                       inUse    = true;   ///< Owned by a live thread; guarded by registryMutex.
+        std::uint32_t              threadId = 0;
+        std::atomic<const char*>   name{nullptr};
+        std::atomic<std::uint64_t> count{0};   ///< Zones ever written; the next slot is count % capacity.
+        std::unique_ptr<ZoneRecord[]> zones = std::make_unique<ZoneRecord[]>(ZonesPerThread);
+    };
+
+    /// Process-wide profiler state.
+    struct ProfilerState {
+        std::atomic<bool> enabled{true};
+
+        std::mutex                                 registryMutex;
+        std::vector<std::unique_ptr<ThreadZones>>  threads;
+        std::uint32_t                              nextThreadId = 1;
+
+        std::atomic<std::uint64_t> frameCount{0};
+        std::atomic<std::int64_t>  frameStarts[FrameHistory] = {};
+    };
+
+    ProfilerState& State() {
+        static ProfilerState state;
+        return state;
+    }
+
+    /// Binds a zone ring to the calling thread and releases it when the thread exits, so
+    /// engines that restart their workers do not allocate a ring per thread ever started.
+    struct ThreadRegistration {
+        ThreadZones* zones = nullptr;
+
+        ThreadRegistration() {
+            ProfilerState& state = State();
+            std::lock_guard<std::mutex> lock(state.registryMutex);
+            for (const auto& thread : state.threads) {
+                if (!thread->inUse) {
+                    zones = thread.get();
+                    break;
+                }
+            }
+            if (!zones) {
+                state.threads.push_back(std::make_unique<ThreadZones>());
+                zones = state.threads.back().get();
+            }
+
+            // The previous owner's zones are dropped; exports hold the lock, so none is reading.
+            zones->inUse = true;
+            zones->threadId = state.nextThreadId++;
+            zones->name.store(nullptr, std::memory_order_relaxed);
+            zones->count.store(0, std::memory_order_relaxed);
+        }
+
+        ~ThreadRegistration() {
+            ProfilerState& state = State();
+            std::lock_guard<std::mutex> lock(state.registryMutex);
+            zones->inUse = false;
+        }
+    };
+
+    // -----------------------------------------------------------------------------
+    // Returns the zone ring of the calling thread, registering it on first use.
+    // -----------------------------------------------------------------------------
+    ThreadZones& LocalZones() {
+        thread_local ThreadRegistration registration;
+        return *registration.zones;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Appends a JSON string literal, escaping quotes, backslashes and control characters.
+    // -----------------------------------------------------------------------------
+    void AppendJsonString(std::string& out, const char* text) {
+        out.push_back('"');
+        for (const char* p = text; *p != '\0'; ++p) {
+            const char c = *p;
+            if (c == '"' || c == '\\') {
+                out.push_back('\\');
+                out.push_back(c);
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out.append(escaped);
+            } else {
+                out.push_back(c);
+            }
+        }
+        out.push_back('"');
+    }
+
+    // -----------------------------------------------------------------------------
+    // Appends a nanosecond time as microseconds with sub-microsecond precision.
+    // -----------------------------------------------------------------------------
+    void AppendMicroseconds(std::string& out, std::int64_t nanoseconds) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.3f", static_cast<double>(nanoseconds) / 1000.0);
+        out.append(text);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Returns the monotonic clock in nanoseconds.
+// -----------------------------------------------------------------------------
+std::int64_t Profiler::Now() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// -----------------------------------------------------------------------------
+// Returns true while zones are being recorded.
+// -----------------------------------------------------------------------------
+bool Profiler::IsEnabled() {
+    return State().enabled.load(std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+// Starts or stops recording.
+// -----------------------------------------------------------------------------
+void Profiler::SetEnabled(bool enabled) {
+    State().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+// Stores a completed zone in the calling thread's ring.
+// -----------------------------------------------------------------------------
+void Profiler::Record(const char* name, std::int64_t begin, std::int64_t end) {
+    if (!IsEnabled()) {
+        return;
+    }
+
+    ThreadZones& local = LocalZones();
+    const std::uint64_t index = local.count.load(std::memory_order_relaxed);
+    ZoneRecord& zone = local.zones[index % ZonesPerThread];
+    zone.name.store(name, std::memory_order_relaxed);
+    zone.begin.store(begin, std::memory_order_relaxed);
+    zone.end.store(end, std::memory_order_relaxed);
+    local.count.store(index + 1, std::memory_order_release);
+}
+
+// -----------------------------------------------------------------------------
+// Names the calling thread in exported traces.
+// -----------------------------------------------------------------------------
+void Profiler::SetThreadName(const char* name) {
+    LocalZones().name.store(name, std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+// Records the start time of a new frame.
+// -----------------------------------------------------------------------------
+void Profiler::MarkFrame() {
+    ProfilerState& state = State();
+    const std::uint64_t frame = state.frameCount.load(std::memory_order_relaxed);
+    state.frameStarts[frame % FrameHistory].store(Now(), std::memory_order_relaxed);
+    state.frameCount.store(frame + 1, std::memory_order_release);
+}
+
+// -----------------------------------------------------------------------------
+// Exports every buffered zone that began inside the last N frames.
+// Zones overwritten while they are being copied are skipped.
+// -----------------------------------------------------------------------------
+bool Profiler::WriteChromeTrace(const std::string& path, std::uint32_t frames) {
+    ProfilerState& state = State();
+
+    const std::uint64_t frameCount = state.frameCount.load(std::memory_order_acquire);
+    const std::uint64_t available  = std::min<std::uint64_t>(frameCount, FrameHistory - 1);
+    const std::uint64_t wanted     = std::min<std::uint64_t>(frames, available);
+    const std::int64_t  windowStart = wanted > 0
+        ? state.frameStarts[(frameCount - wanted) % FrameHistory].load(std::memory_order_relaxed)
+        : 0;
+
+    std::string json;
+    json.reserve(1 << 20);
+    json.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    auto separator = [&] {
+        if (!first) {
+            json.append(",\n");
+        }
+        first = false;
+    };
+
+    for (std::uint64_t f = frameCount - wanted; f < frameCount; ++f) {
+        separator();
+        json.append("{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":");
+        AppendMicroseconds(json, state.frameStarts[f % FrameHistory].load(std::memory_order_relaxed));
+        json.append("}");
+    }
+
+    std::lock_guard<std::mutex> lock(state.registryMutex);
+    for (const auto& thread : state.threads) {
+        const char* threadName = thread->name.load(std::memory_order_relaxed);
+        if (threadName) {
+            separator();
+            json.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+            json.append(std::to_string(thread->threadId));
+            json.append(",\"args\":{\"name\":");
+            AppendJsonString(json, threadName);
+            json.append("}}");
+        }
+
+        const std::uint64_t end   = thread->count.load(std::memory_order_acquire);
+        const std::uint64_t start = end > ZonesPerThread ? end - ZonesPerThread : 0;
+        for (std::uint64_t i = start; i < end; ++i) {
+            const ZoneRecord& zone = thread->zones[i % ZonesPerThread];
+            const char*  name  = zone.name.load(std::memory_order_relaxed);
+            const std::int64_t begin = zone.begin.load(std::memory_order_relaxed);
+            const std::int64_t zoneEnd = zone.end.load(std::memory_order_relaxed);
+
+            // The owner may have lapped this slot while we were reading it.
+            if (thread->count.load(std::memory_order_acquire) - i > ZonesPerThread) {
+                continue;
+            }
+            if (!name || begin < windowStart) {
+                continue;
+            }
+
+            separator();
+            json.append("{\"name\":");
+            AppendJsonString(json, name);
+            json.append(",\"ph\":\"X\",\"pid\":1,\"tid\":");
+            json.append(std::to_string(thread->threadId));
+            json.append(",\"ts\":");
+            AppendMicroseconds(json, begin);
+            json.append(",\"dur\":");
+            AppendMicroseconds(json, zoneEnd - begin);
+            json.append("}");
+        }
+    }
+    json.append("\n]}\n");
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    const bool written = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+    return std::fclose(file) == 0 && written;
+}
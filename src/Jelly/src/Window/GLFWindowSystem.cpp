@@ -1,11 +1,13 @@
 #include "Window/GLFWindowSystem.h"
 
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
 #include <stdexcept>
 
 #include "Logger.h"
+#include "Profiling/Profiler.h"
 
 // -----------------------------------------------------------------------------
 // GLFW error callback.
@@ -15,6 +17,50 @@ static void ErrorCallback(int error, const char *description)
     std::fprintf(stderr, "GLFW error %d: %s\n", error, description);
 }
 
+namespace {
+    // -----------------------------------------------------------------------------
+    // Appends an event to the buffer of the window system owning @p window.
+    // -----------------------------------------------------------------------------
+    void PushInputEvent(GLFWwindow* window, const InputEvent& event)
+    {
+        auto events = static_cast<InputEventBuffer*>(glfwGetWindowUserPointer(window));
+        if (events)
+        {
+            events->Push(event);
+        }
+    }
+
+    void KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
+    {
+        PushInputEvent(window, {InputEventType::Key, key, action, mods, static_cast<float>(scancode), 0.0f});
+    }
+
+    void CharCallback(GLFWwindow* window, unsigned int codepoint)
+    {
+        PushInputEvent(window, {InputEventType::Char, static_cast<int32_t>(codepoint), 0, 0, 0.0f, 0.0f});
+    }
+
+    void MouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+    {
+        PushInputEvent(window, {InputEventType::MouseButton, button, action, mods, 0.0f, 0.0f});
+    }
+
+    void CursorPosCallback(GLFWwindow* window, double x, double y)
+    {
+        PushInputEvent(window, {InputEventType::MouseMove, 0, 0, 0, static_cast<float>(x), static_cast<float>(y)});
+    }
+
+    void ScrollCallback(GLFWwindow* window, double x, double y)
+    {
+        PushInputEvent(window, {InputEventType::Scroll, 0, 0, 0, static_cast<float>(x), static_cast<float>(y)});
+    }
+
+    void FramebufferSizeCallback(GLFWwindow* window, int width, int height)
+    {
+        PushInputEvent(window, {InputEventType::Resize, 0, 0, 0, static_cast<float>(width), static_cast<float>(height)});
+    }
+}
+
 // -----------------------------------------------------------------------------
 // Creates the window and initialises GLFW.
 // -----------------------------------------------------------------------------
@@ -24,7 +70,7 @@ void GLFWindowSystem::CreateWindow(const WindowSettings &settings)
 
     if (!glfwInit())
     {
-        Logger::Log(LogLevel::Error, "GLFW initialisation failed");
+        Logger::Log(LogCategory::Window, LogLevel::Error, "GLFW initialisation failed");
         std::exit(EXIT_FAILURE);
     }
 
@@ -41,14 +87,30 @@ void GLFWindowSystem::CreateWindow(const WindowSettings &settings)
     if (!window)
     {
         glfwTerminate();
-        Logger::Log(LogLevel::Error, "Window creation failed");
+        Logger::Log(LogCategory::Window, LogLevel::Error, "Window creation failed");
         std::exit(EXIT_FAILURE);
     }
 
-    Logger::Log(
-        LogLevel::Highlight,
-        "Window created: " + std::string(settings.title) +
-            " (" + std::to_string(settings.width) + "x" + std::to_string(settings.height) + ")");
+    mainThread = std::this_thread::get_id();
+    InstallInputCallbacks();
+    UpdateFramebufferSize();
+
+    JELLY_LOG(LogCategory::Window, LogLevel::Highlight, "Window created: {} ({}x{})",
+              settings.title, settings.width, settings.height);
+}
+
+// -----------------------------------------------------------------------------
+// Routes GLFW input callbacks into the input event buffer.
+// -----------------------------------------------------------------------------
+void GLFWindowSystem::InstallInputCallbacks()
+{
+    glfwSetWindowUserPointer(window, &inputEvents);
+    glfwSetKeyCallback(window, KeyCallback);
+    glfwSetCharCallback(window, CharCallback);
+    glfwSetMouseButtonCallback(window, MouseButtonCallback);
+    glfwSetCursorPosCallback(window, CursorPosCallback);
+    glfwSetScrollCallback(window, ScrollCallback);
+    glfwSetFramebufferSizeCallback(window, FramebufferSizeCallback);
 }
 
 // -----------------------------------------------------------------------------
@@ -71,7 +133,16 @@ bool GLFWindowSystem::IsWindowOpen()
 // -----------------------------------------------------------------------------
 void GLFWindowSystem::PollEvents()
 {
+    JELLY_PROFILE_ZONE("Window::PollEvents");
+
+    inputEvents.Clear();
     glfwPollEvents();
+    UpdateFramebufferSize();
+
+    if (inputEvents.Dropped() > 0)
+    {
+        JELLY_LOG(LogCategory::Window, LogLevel::Warning, "Input buffer full, {} event(s) dropped", inputEvents.Dropped());
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -88,16 +159,38 @@ void *GLFWindowSystem::GetNativeWindowHandle()
     return window;
 }
 
+// -----------------------------------------------------------------------------
+// Returns the framebuffer size cached by the last poll. Safe from any thread.
+// -----------------------------------------------------------------------------
 void GLFWindowSystem::GetFramebufferSize(uint32_t &w, uint32_t &h)
 {
-    int iw, ih;
-    glfwGetFramebufferSize(window, &iw, &ih);
-    w = static_cast<uint32_t>(iw);
-    h = static_cast<uint32_t>(ih);
+    w = framebufferWidth.load(std::memory_order_relaxed);
+    h = framebufferHeight.load(std::memory_order_relaxed);
 }
 
+// -----------------------------------------------------------------------------
+// Blocks until events arrive. Off the main thread, where GLFW cannot wait, it sleeps
+// briefly instead and relies on the main thread to keep polling.
+// -----------------------------------------------------------------------------
 void GLFWindowSystem::WaitEvents() {
+    if (std::this_thread::get_id() != mainThread) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return;
+    }
+
     glfwWaitEvents();
+    UpdateFramebufferSize();
+}
+
+// -----------------------------------------------------------------------------
+// Caches the framebuffer size for threads that may not call into GLFW.
+// -----------------------------------------------------------------------------
+void GLFWindowSystem::UpdateFramebufferSize()
+{
+    int iw = 0, ih = 0;
+    glfwGetFramebufferSize(window, &iw, &ih);
+    framebufferWidth.store(static_cast<uint32_t>(iw), std::memory_order_relaxed);
+    framebufferHeight.store(static_cast<uint32_t>(ih), std::memory_order_relaxed);
 }
 
 VkSurfaceKHR GLFWindowSystem::CreateVulkanSurface(VkInstance instance)
@@ -0,0 +1,35 @@
+#include "Window/NullWindowSystem.h"
+
+#include <algorithm>
+
+#include "Logger.h"
+
+// -----------------------------------------------------------------------------
+// Records the requested size; nothing is shown.
+// -----------------------------------------------------------------------------
+void NullWindowSystem::CreateWindow(const WindowSettings& settings)
+{
+    Resize(static_cast<uint32_t>(std::max(settings.width, 1)), static_cast<uint32_t>(std::max(settings.height, 1)));
+    open = true;
+
+    JELLY_LOG(LogCategory::Window, LogLevel::Highlight, "Headless target created: {} ({}x{})",
+              settings.title ? settings.title : "", width.load(), height.load());
+}
+
+// -----------------------------------------------------------------------------
+// Returns the size the target was created with.
+// -----------------------------------------------------------------------------
+void NullWindowSystem::GetFramebufferSize(uint32_t& w, uint32_t& h)
+{
+    w = width.load(std::memory_order_relaxed);
+    h = height.load(std::memory_order_relaxed);
+}
+
+// -----------------------------------------------------------------------------
+// Sets the size returned by GetFramebufferSize.
+// -----------------------------------------------------------------------------
+void NullWindowSystem::Resize(uint32_t w, uint32_t h)
+{
+    width.store(std::max(w, 1u), std::memory_order_relaxed);
+    height.store(std::max(h, 1u), std::memory_order_relaxed);
+}